@@ -38,9 +38,12 @@
 #include "networkinterfacewatcher.h"
 #include "seshat/seshat.h"
 #include "gitinforecorder.h"
+#include "threadmonitor.h"
+#include "core/configuration.h"
 #include <QMetaType>
 #include <QThread>
 #include <QList>
+#include <QPair>
 
 using namespace camun::simulator;
 
@@ -94,6 +97,7 @@ Amun::Amun(bool simulatorOnly, QObject *parent) :
     qRegisterMetaType<amun::Visualization>("amun::Visualization");
     qRegisterMetaType<SSLSimRobotControl>("SSLSimRobotControl");
     qRegisterMetaType<SSLSimError>("SSLSimError");
+    qRegisterMetaType<SimulatorTruth>("SimulatorTruth");
     qRegisterMetaType<QList<SSLSimError>>("QList<SSLSimError>");
     qRegisterMetaType<camun::simulator::ErrorSource>("ErrorSource");
     qRegisterMetaType<camun::simulator::ErrorSource>("camun::simulator::ErrorSource");
@@ -312,6 +316,30 @@ void Amun::start()
     // connect transceiver
     setSimulatorEnabled(m_simulatorOnly, false);
 
+    // monitor the timing of all threads and apply the thread placement policies
+    amun::ThreadPlacement placement;
+    const QString placementConfig = "threadplacement";
+    if (QFile::exists(QString(ERFORCE_CONFDIR) + placementConfig + ".txt")) {
+        loadConfiguration(placementConfig, &placement, false);
+    }
+    const QList<QPair<QString, QThread*>> threads = {
+        {"processor", m_processorThread},
+        {"radio", m_radioThread},
+        {"network", m_networkThread},
+        {"simulator", m_simulatorThread},
+        {"strategy-blue", m_strategyThread[0]},
+        {"strategy-yellow", m_strategyThread[1]},
+        {"autoref", m_strategyThread[2]},
+        {"replay-blue", m_strategyThread[3]},
+        {"replay-yellow", m_strategyThread[4]},
+        {"debughelper", m_debugHelperThread},
+        {"gitrecorder", m_gitRecorderThread}
+    };
+    for (const auto &thread : threads) {
+        ThreadMonitor *monitor = new ThreadMonitor(thread.first, thread.second, placement);
+        connect(monitor, &ThreadMonitor::sendStatus, this, &Amun::handleStatus);
+    }
+
     // start threads
     m_processorThread->start();
     m_radioThread->start();
@@ -0,0 +1,87 @@
+/***************************************************************************
+ *   Copyright 2015 Michael Eischer                                        *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef THREADMONITOR_H
+#define THREADMONITOR_H
+
+#include "protobuf/command.pb.h"
+#include "protobuf/status.h"
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+class QThread;
+class QTimer;
+
+// Mean and maximum delay of a periodic timer compared to its schedule
+class TimerJitter
+{
+public:
+    explicit TimerJitter(qint64 interval);
+
+    void start(qint64 time);
+    void tick(qint64 time);
+    int ticks() const { return m_tickCount; }
+    // writes the statistics since the last report and starts a new report interval
+    void report(amun::ThreadJitter &jitter);
+
+private:
+    const qint64 m_interval;
+    qint64 m_lastTick;
+    qint64 m_delaySum;
+    qint64 m_maxDelay;
+    int m_tickCount;
+};
+
+// Applies the scheduling policy of a thread from within that thread and
+// measures how late a periodic timer fires in it.
+class ThreadMonitor : public QObject
+{
+    Q_OBJECT
+public:
+    // moves the monitor to thread, the policy is applied once the thread is started
+    ThreadMonitor(const QString &name, QThread *thread, const amun::ThreadPlacement &placement);
+
+    // the last policy of the placement that lists the thread, returns false if there is none
+    static bool findPolicy(const QString &name, const amun::ThreadPlacement &placement, amun::ThreadPolicy &policy);
+    // returns a description of the invalid parts of the policy, empty if it is valid
+    static QString validatePolicy(const amun::ThreadPolicy &policy);
+
+signals:
+    void sendStatus(const Status &status);
+
+private slots:
+    void start();
+    void tick();
+
+private:
+    // returns the errors of the failed parts of the policy
+    QString applyPolicy();
+
+    const QString m_name;
+    amun::ThreadPolicy m_policy;
+    bool m_hasPolicy;
+    QTimer *m_timer;
+    TimerJitter m_jitter;
+    // reported with every jitter status, the placement is only applied once
+    QString m_placementError;
+};
+
+#endif // THREADMONITOR_H
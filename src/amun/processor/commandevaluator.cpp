@@ -23,15 +23,22 @@
 #include "debughelper.h"
 #include "processor.h"
 #include "protobuf/debug.pb.h"
+#include "protobuf/debugsubscription.h"
 #include "protobuf/world.pb.h"
+#include <algorithm>
 #include <cmath>
 #include <QString>
 
+// the tracking error statistics are reported once per second
+static const qint64 TRACKING_ERROR_INTERVAL = 1000 * 1000 * 1000;
+
 CommandEvaluator::CommandEvaluator(const robot::Specs &specs) :
     m_specs(specs),
     m_startTime(0),
     m_baseSpeed(0, 0, 0),
-    m_baseSpeedTime(0)
+    m_baseSpeedTime(0),
+    m_accelerationLimited(false),
+    m_trackingErrorStart(0)
 {
 }
 
@@ -51,7 +58,12 @@ bool CommandEvaluator::hasInput()
     return (m_startTime != 0);
 }
 
-void CommandEvaluator::calculateCommand(const world::Robot *robot, qint64 worldTime, robot::Command &command, amun::DebugValues *debug)
+const char * const CommandEvaluator::VISUALIZATIONS[] = {
+    "Controller/Spline", "Controller/Spline/Velocity", "Controller/Spline/SwitchingPoints", "Controller/Accelerator", nullptr
+};
+
+void CommandEvaluator::calculateCommand(const world::Robot *robot, qint64 worldTime, robot::Command &command, amun::DebugValues *debug,
+                                        const DebugSubscription &subscription)
 {
     if (m_baseSpeedTime == 0) {
         m_baseSpeedTime = worldTime;
@@ -84,9 +96,12 @@ void CommandEvaluator::calculateCommand(const world::Robot *robot, qint64 worldT
 
     if (hasRobot && !hasManualCommand) {
         // splines only work if we know where the robot is and we arent controlling it by hand
-        drawSpline(debug);
+        drawSpline(debug, subscription);
+        updateTrackingError(robot, worldTimeOne, m_accelerationLimited);
+    }
+    if (subscription.isVisualizationEnabled("Controller/Accelerator")) {
+        drawSpeed(robot, limitedOutputOne, debug);
     }
-    drawSpeed(robot, limitedOutputOne, debug);
 
     m_baseSpeed = limitedOutputOne;
     m_baseSpeedTime = worldTimeOne;
@@ -194,16 +209,25 @@ void CommandEvaluator::logInvalidCommand(amun::DebugValues *debug, qint64 worldT
     log->set_text(QString("Invalid command for robot %1-%2").arg(m_specs.generation()).arg(m_specs.id()).toStdString());
 }
 
-void CommandEvaluator::drawSpline(amun::DebugValues *debug)
+void CommandEvaluator::drawSpline(amun::DebugValues *debug, const DebugSubscription &subscription)
 {
     const google::protobuf::RepeatedPtrField<robot::Spline> &input = m_input.spline();
 
-    amun::Visualization *vis = debug->add_visualization();
-    vis->set_name("Controller/Spline");
-    vis->set_width(0.01f);
-    vis->mutable_pen()->mutable_color()->set_red(255);
+    const bool drawPath = subscription.isVisualizationEnabled("Controller/Spline");
+    const bool drawVelocity = subscription.isVisualizationEnabled("Controller/Spline/Velocity");
+    const bool drawSwitchingPoints = subscription.isVisualizationEnabled("Controller/Spline/SwitchingPoints");
+    if (!drawPath && !drawVelocity && !drawSwitchingPoints) {
+        return;
+    }
 
-    amun::Path *path = vis->mutable_path();
+    amun::Path *path = nullptr;
+    if (drawPath) {
+        amun::Visualization *vis = debug->add_visualization();
+        vis->set_name("Controller/Spline");
+        vis->set_width(0.01f);
+        vis->mutable_pen()->mutable_color()->set_red(255);
+        path = vis->mutable_path();
+    }
 
     // iterate over the spline
     for(google::protobuf::RepeatedPtrField<robot::Spline>::const_iterator it = input.begin(); it != input.end(); ++it) {
@@ -226,15 +250,17 @@ void CommandEvaluator::drawSpline(amun::DebugValues *debug)
             const float p_x = spline.x().a0() + (spline.x().a1() + (spline.x().a2() + spline.x().a3() * t) * t) * t;
             const float p_y = spline.y().a0() + (spline.y().a1() + (spline.y().a2() + spline.y().a3() * t) * t) * t;
 
-            amun::Point *p = path->add_point();
-            p->set_x(p_x);
-            p->set_y(p_y);
+            if (path) {
+                amun::Point *p = path->add_point();
+                p->set_x(p_x);
+                p->set_y(p_y);
+            }
 
             last_p_x = p_x;
             last_p_y = p_y;
         }
 
-        {
+        if (drawVelocity) {
             const float t = spline.t_start() + d;
             // Visualize desired velocities on spline part end
             const float v_x = spline.x().a1() + (2 * spline.x().a2() + 3 * spline.x().a3() * t) * t;
@@ -256,7 +282,7 @@ void CommandEvaluator::drawSpline(amun::DebugValues *debug)
             p->set_y(last_p_y + v_y);
         }
 
-        {
+        if (drawSwitchingPoints) {
             // Visualize switching points
             amun::Visualization *vis = debug->add_visualization();
             vis->set_name("Controller/Spline/SwitchingPoints");
@@ -271,11 +297,66 @@ void CommandEvaluator::drawSpline(amun::DebugValues *debug)
     }
 }
 
+void CommandEvaluator::updateTrackingError(const world::Robot *robot, qint64 worldTime, bool accelerationLimited)
+{
+    const float t = (worldTime - m_startTime) * 1E-9f;
+    const int activeSplineIndex = findActiveSpline(t);
+    if (activeSplineIndex < 0) {
+        return;
+    }
+    const robot::Spline &spline = m_input.spline(activeSplineIndex);
+
+    const float p_x = spline.x().a0() + (spline.x().a1() + (spline.x().a2() + spline.x().a3() * t) * t) * t;
+    const float p_y = spline.y().a0() + (spline.y().a1() + (spline.y().a2() + spline.y().a3() * t) * t) * t;
+    const float phi = spline.phi().a0() + (spline.phi().a1() + (spline.phi().a2() + spline.phi().a3() * t) * t) * t;
+    const GlobalSpeed speed = evaluateSplinePartAtTime(spline, t);
+
+    const float positionError = std::hypot(robot->p_x() - p_x, robot->p_y() - p_y);
+    const float velocityError = std::hypot(robot->v_x() - speed.v_x, robot->v_y() - speed.v_y);
+    const float phiError = std::remainder(robot->phi() - phi, float(2 * M_PI));
+
+    m_trackingError.samples++;
+    if (accelerationLimited) {
+        m_trackingError.limitedSamples++;
+    }
+    m_trackingError.positionSquared += positionError * positionError;
+    m_trackingError.positionMax = std::max(m_trackingError.positionMax, positionError);
+    m_trackingError.velocitySquared += velocityError * velocityError;
+    m_trackingError.phiSquared += phiError * phiError;
+}
+
+bool CommandEvaluator::takeTrackingError(qint64 worldTime, robot::TrackingError &error)
+{
+    if (m_trackingErrorStart == 0) {
+        m_trackingErrorStart = worldTime;
+    }
+    if (worldTime - m_trackingErrorStart < TRACKING_ERROR_INTERVAL) {
+        return false;
+    }
+    m_trackingErrorStart = worldTime;
+
+    const TrackingErrorSums sums = m_trackingError;
+    m_trackingError = TrackingErrorSums();
+    // nothing to report without spline
+    if (sums.samples == 0) {
+        return false;
+    }
+
+    error.set_samples(sums.samples);
+    error.set_position_rms(std::sqrt(sums.positionSquared / sums.samples));
+    error.set_position_max(sums.positionMax);
+    error.set_velocity_rms(std::sqrt(sums.velocitySquared / sums.samples));
+    error.set_phi_rms(std::sqrt(sums.phiSquared / sums.samples));
+    error.set_acceleration_limited(float(sums.limitedSamples) / sums.samples);
+    return true;
+}
+
 // Limit acceleration and velocities in global coordinates
 // as the robots momentum is relative to the global frame
 GlobalSpeed CommandEvaluator::limitAcceleration(float robotPhi, const GlobalSpeed &command, float timeStep, bool hasManualCommand)
 {
     if (timeStep == 0) {
+        m_accelerationLimited = false;
         return m_baseSpeed;
     }
 
@@ -291,9 +372,12 @@ GlobalSpeed CommandEvaluator::limitAcceleration(float robotPhi, const GlobalSpee
     const robot::LimitParameters& a_limits = hasManualCommand ? m_specs.strategy() : m_specs.acceleration();
 
     // Robot has different speed up / slow down accelerations
+    const LocalAcceleration unboundedAccel = localAccel;
     localAccel.a_s = boundAcceleration(localAccel.a_s, localCommand.v_s, a_limits.a_speedup_s_max(), a_limits.a_brake_s_max());
     localAccel.a_f = boundAcceleration(localAccel.a_f, localCommand.v_f, a_limits.a_speedup_f_max(), a_limits.a_brake_f_max());
     localAccel.a_phi = boundAcceleration(localAccel.a_phi, localCommand.omega, a_limits.a_speedup_phi_max(), a_limits.a_brake_phi_max());
+    m_accelerationLimited = localAccel.a_s != unboundedAccel.a_s || localAccel.a_f != unboundedAccel.a_f
+            || localAccel.a_phi != unboundedAccel.a_phi;
 
     GlobalAcceleration boundedAccel = localAccel.toGlobal(robotPhi);
 
@@ -27,6 +27,7 @@
 #include <QtGlobal>
 
 namespace amun { class DebugValues; }
+class DebugSubscription;
 namespace world { class Robot; }
 
 class LocalSpeed;
@@ -43,11 +44,16 @@ public:
     explicit CommandEvaluator(const robot::Specs &specs);
 
 public:
-    void calculateCommand(const world::Robot *robot, qint64 worldTime, robot::Command &command, amun::DebugValues *debug);
+    void calculateCommand(const world::Robot *robot, qint64 worldTime, robot::Command &command, amun::DebugValues *debug,
+                          const DebugSubscription &subscription);
+    // names of all visualizations drawn by the controller
+    static const char * const VISUALIZATIONS[];
     void setInput(const robot::ControllerInput &input, qint64 currentTime);
     void clearInput();
     bool hasInput();
     qint64 startTime() const{ return m_startTime; }
+    // returns true and resets the statistics once per reporting interval
+    bool takeTrackingError(qint64 worldTime, robot::TrackingError &error);
 
 private:
     static float robotToPhi(const world::Robot *robot);
@@ -59,8 +65,9 @@ private:
     GlobalSpeed evaluateSplinePartAtTime(const robot::Spline &spline, const float t);
 
     void logInvalidCommand(amun::DebugValues *debug, qint64 worldTime);
-    void drawSpline(amun::DebugValues *debug);
+    void drawSpline(amun::DebugValues *debug, const DebugSubscription &subscription);
 
+    void updateTrackingError(const world::Robot *robot, qint64 worldTime, bool accelerationLimited);
     GlobalSpeed limitAcceleration(float robotPhi, const GlobalSpeed &command, float timeStep, bool hasManualCommand);
     float boundAcceleration(float acceleration, float oldSpeed, float speedupLimit, float brakeLimit) const;
     void drawSpeed(const world::Robot *robot, const GlobalSpeed &output, amun::DebugValues *debug);
@@ -74,6 +81,20 @@ private:
 
     GlobalSpeed m_baseSpeed;
     qint64 m_baseSpeedTime;
+    // set by limitAcceleration
+    bool m_accelerationLimited;
+
+    struct TrackingErrorSums
+    {
+        unsigned samples = 0;
+        unsigned limitedSamples = 0;
+        double positionSquared = 0;
+        float positionMax = 0;
+        double velocitySquared = 0;
+        double phiSquared = 0;
+    };
+    TrackingErrorSums m_trackingError;
+    qint64 m_trackingErrorStart;
 };
 
 #endif // COMMAND_EVALUATOR_H
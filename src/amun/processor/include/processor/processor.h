@@ -22,7 +22,11 @@
 #define PROCESSOR_H
 
 #include "protobuf/command.h"
+#include "protobuf/debugstringtable.h"
+#include "protobuf/imagevisualization.h"
+#include "protobuf/debugsubscription.h"
 #include "protobuf/robotcommand.h"
+#include "protobuf/simulatortruth.h"
 #include "protobuf/ssl_mixed_team.pb.h"
 #include "protobuf/status.h"
 #include <QMap>
@@ -64,7 +68,7 @@ public slots:
     void setScaling(double scaling);
     void handleRefereePacket(const QByteArray &data, qint64 time, QString sender);
     void handleVisionPacket(const QByteArray &data, qint64 time, QString sender);
-    void handleSimulatorExtraVision(const QByteArray &data);
+    void handleSimulatorExtraVision(const SimulatorTruth &truth);
     void handleMixedTeamInfo(const QByteArray &data, qint64 time);
     void handleRadioResponses(const QList<robot::RadioResponse> &responses);
     void handleCommand(const Command &command);
@@ -93,7 +97,9 @@ private:
     const world::Robot *getWorldRobot(const RobotList &robots, uint id);
     void injectExtraData(Status &status);
     void injectUserControl(Status &status, bool isBlue);
+    void injectSimulatorTruth(Status &status);
     Status assembleStatus(qint64 time, bool resetRaw);
+    void compactDebugOutput(Status &status);
     world::WorldSource currentWorldSource() const;
     static QString ballModelConfigFile(bool isSimulator);
 
@@ -107,7 +113,7 @@ private:
     std::unique_ptr<Tracker> m_speedTracker;
     std::unique_ptr<Tracker> m_simpleTracker;
     QList<robot::RadioResponse> m_responses;
-    QList<QByteArray> m_extraVision;
+    QList<SimulatorTruth> m_simulatorTruth;
     ssl::TeamPlan m_mixedTeamInfo;
     bool m_mixedTeamInfoSet;
     bool m_refereeInternalActive;
@@ -127,6 +133,10 @@ private:
     world::BallModel m_ballModel;
     bool m_ballModelUpdated = false;
     const bool m_saveBallModel;
+
+    QMap<int, DebugStringInterner> m_debugStrings;
+    QMap<int, ImageVisualizationEncoder> m_imageEncoders;
+    DebugSubscription m_debugSubscription;
 };
 
 #endif // PROCESSOR_H
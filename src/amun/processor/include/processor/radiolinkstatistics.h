@@ -0,0 +1,79 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef RADIOLINKSTATISTICS_H
+#define RADIOLINKSTATISTICS_H
+
+#include "protobuf/robot.pb.h"
+#include "radio_address.h"
+#include <QList>
+#include <array>
+
+// Per robot statistics of the commands sent to the robots and the responses
+// received for them, evaluated over a sliding window of the latest commands.
+// A response is matched to the command with the same packet counter.
+class RadioLinkStatistics
+{
+public:
+    static constexpr int WINDOW_SIZE = 128;
+    static constexpr int ROBOTS_PER_GENERATION = 16;
+    // commands younger than this may still receive a response and are not evaluated,
+    // responses arriving later are counted as lost
+    static constexpr qint64 RESPONSE_TIMEOUT = 100 * 1000 * 1000;
+    // older commands are dropped from the window, e.g. after a robot was removed
+    static constexpr qint64 MAX_AGE = 2000 * 1000 * 1000LL;
+
+public:
+    RadioLinkStatistics();
+
+    // a command was created for the robot but replaced before it could be sent
+    void commandDropped(Radio::Generation generation, uint id, qint64 time);
+    void commandSent(Radio::Generation generation, uint id, quint8 counter, qint64 time);
+    void responseReceived(Radio::Generation generation, uint id, quint8 counter, qint64 time);
+
+    // appends the statistics of every robot with evaluated commands in the window
+    void evaluate(qint64 time, QList<robot::RadioLinkQuality> &links) const;
+    void clear();
+
+private:
+    struct Entry {
+        qint64 time = 0;
+        float latency = -1;
+        quint8 counter = 0;
+        bool sent = false;
+    };
+
+    struct Window {
+        std::array<Entry, WINDOW_SIZE> entries;
+        // index of the next entry to write
+        int head = 0;
+        int size = 0;
+        // entry index per packet counter, -1 if the counter was not sent to the robot
+        std::array<qint16, 256> counterIndex;
+    };
+
+    static constexpr int SLOT_COUNT = 2 * ROBOTS_PER_GENERATION;
+    static int slot(Radio::Generation generation, uint id);
+    Entry *append(Radio::Generation generation, uint id, qint64 time);
+
+    std::array<Window, SLOT_COUNT> m_windows;
+};
+
+#endif // RADIOLINKSTATISTICS_H
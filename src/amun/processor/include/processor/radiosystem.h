@@ -24,6 +24,8 @@
 #include "protobuf/command.h"
 #include "protobuf/status.h"
 #include "radio_address.h"
+#include "radiolinkstatistics.h"
+#include "radiotelemetry.h"
 
 #include <QMap>
 #include <QPair>
@@ -50,6 +52,7 @@ private:
 
 public:
     explicit RadioSystem(const Timer *timer);
+    const RadioLinkStatistics &linkStatistics() const { return m_linkStatistics; }
 
 signals:
     void sendStatus(const Status &status);
@@ -72,7 +75,9 @@ private:
     bool ensureOpen();
 
     float calculateDroppedFramesRatio(Radio::Generation generation, uint id, uint8_t counter, int skipedFrames);
-    void handleResponsePacket(QList<robot::RadioResponse> &response, const char *data, uint size, qint64 time);
+    void handleResponsePacket(const char *data, uint size, qint64 time);
+    template <typename RadioResponse>
+    void decodeResponse(Radio::Generation generation, const RadioResponse *packet, qint64 time);
     void handleTeam(const robot::Team &team);
 
     void addRobot2014Command(int id, const robot::Command &command, bool charge, quint8 packetCounter);
@@ -85,10 +90,15 @@ private:
     void sendCommand(const QList<robot::RadioCommand> &commands, bool charge, qint64 processingStart);
 
 private:
+    static constexpr qint64 LINK_REPORT_INTERVAL = 250 * 1000 * 1000;
+
     bool m_charge;
     QMap<QPair<Radio::Generation, uint>, DroppedFrameCounter> m_droppedFrames;
     QMap<QPair<Radio::Generation, uint>, uint> m_ir_param;
     QMap<quint8, qint64> m_frameTimes;
+    RadioTelemetry m_telemetry;
+    RadioLinkStatistics m_linkStatistics;
+    qint64 m_lastLinkReport;
 
     quint8 m_packetCounter;
     QTimer *m_timeoutTimer;
@@ -0,0 +1,132 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef RADIOTELEMETRY_H
+#define RADIOTELEMETRY_H
+
+#include "protobuf/robot.pb.h"
+#include "radio_address.h"
+#include <QList>
+#include <array>
+
+// Per robot history of the decoded radio responses, stored as one fixed size
+// ring buffer per value. Responses are only converted to protobuf when
+// they're forwarded, which happens on changes or once per response interval.
+// The columns belong to the radio thread, other threads only see the forwarded responses.
+class RadioTelemetry
+{
+public:
+    static constexpr int HISTORY_SIZE = 64;
+    static constexpr int ROBOTS_PER_GENERATION = 16;
+
+    enum Flag : quint8 {
+        PowerEnabled = 1 << 0,
+        ErrorPresent = 1 << 1,
+        BallDetected = 1 << 2,
+        CapCharged = 1 << 3,
+        HasBasicStatus = 1 << 4,
+        HasExtendedError = 1 << 5,
+        HasRtt = 1 << 6
+    };
+
+    // bits of the extended error, in the order of robot::ExtendedError
+    enum Error : quint16 {
+        Motor1Error = 1 << 0,
+        Motor2Error = 1 << 1,
+        Motor3Error = 1 << 2,
+        Motor4Error = 1 << 3,
+        DribblerError = 1 << 4,
+        KickerError = 1 << 5,
+        KickerBreakBeamError = 1 << 6,
+        MotorEncoderError = 1 << 7,
+        MainSensorError = 1 << 8
+    };
+
+    struct Sample {
+        qint64 time = 0;
+        float battery = 0;
+        float packetLossRx = 0;
+        float packetLossTx = 0;
+        float vF = 0;
+        float vS = 0;
+        float omega = 0;
+        float rtt = 0;
+        qint8 temperature = 0;
+        quint16 errors = 0;
+        quint8 flags = 0;
+    };
+
+    struct Columns {
+        std::array<qint64, HISTORY_SIZE> time;
+        std::array<float, HISTORY_SIZE> battery;
+        std::array<float, HISTORY_SIZE> packetLossRx;
+        std::array<float, HISTORY_SIZE> packetLossTx;
+        std::array<float, HISTORY_SIZE> vF;
+        std::array<float, HISTORY_SIZE> vS;
+        std::array<float, HISTORY_SIZE> omega;
+        std::array<float, HISTORY_SIZE> rtt;
+        std::array<qint8, HISTORY_SIZE> temperature;
+        std::array<quint16, HISTORY_SIZE> errors;
+        std::array<quint8, HISTORY_SIZE> flags;
+        // index of the next sample to write
+        int head = 0;
+        int size = 0;
+
+        // age 0 is the latest sample
+        int index(int age) const { return (head - 1 - age + HISTORY_SIZE) % HISTORY_SIZE; }
+        Sample sample(int age) const;
+    };
+
+public:
+    RadioTelemetry();
+
+    // a response interval of zero forwards every single response
+    void setResponseInterval(qint64 interval) { m_responseInterval = interval; }
+    qint64 responseInterval() const { return m_responseInterval; }
+
+    bool append(Radio::Generation generation, uint id, const Sample &sample);
+    // converts the pending samples of all robots which are due for forwarding
+    void takeResponses(qint64 time, QList<robot::RadioResponse> &responses);
+    void clear();
+
+    // returns nullptr if no response of that robot was received yet
+    const Columns *columns(Radio::Generation generation, uint id) const;
+
+private:
+    struct ForwardState {
+        int pending = 0;
+        qint64 lastForwarded = 0;
+        quint8 flags = 0;
+        quint16 errors = 0;
+        bool forwarded = false;
+    };
+
+    static constexpr int SLOT_COUNT = 2 * ROBOTS_PER_GENERATION;
+    static int slot(Radio::Generation generation, uint id);
+    static Radio::Generation slotGeneration(int slot);
+    static void fillResponse(robot::RadioResponse &r, const Sample &sample);
+    static void fillMerged(robot::RadioResponse &r, const Columns &c, int pending);
+
+    std::array<Columns, SLOT_COUNT> m_columns;
+    std::array<ForwardState, SLOT_COUNT> m_forward;
+    qint64 m_responseInterval;
+};
+
+#endif // RADIOTELEMETRY_H
@@ -22,6 +22,7 @@
 #include "commandevaluator.h"
 #include "coordinatehelper.h"
 #include "processor.h"
+#include "protobuf/statusarenapool.h"
 #include "protobuf/world.pb.h"
 #include "referee.h"
 #include "core/timer.h"
@@ -196,17 +197,22 @@ Status Processor::assembleStatus(qint64 time, bool resetRaw)
     if (simplePredictionStatus->world_state().has_ball()) {
         status->mutable_world_state()->mutable_simple_tracking_ball()->CopyFrom(simplePredictionStatus->world_state().ball());
     }
-    if (!m_extraVision.empty()) {
-        for(const QByteArray& data : m_extraVision) {
-            status->mutable_world_state()->add_reality()->ParseFromArray(data.data(), data.size());
-        }
-        if (resetRaw) {
-            m_extraVision.clear();
+    return status;
+}
+
+void Processor::injectSimulatorTruth(Status &status)
+{
+    // the ground truth is only required for the ui and the logs,
+    // the strategies never get a copy of it
+    if (m_debugSubscription.isAll()) {
+        for (const SimulatorTruth &truth : m_simulatorTruth) {
+            status->mutable_world_state()->add_reality()->CopyFrom(*truth);
         }
+    } else if (m_debugSubscription.isTruthEnabled() && !m_simulatorTruth.isEmpty()) {
+        // the ui only displays the latest snapshot
+        status->mutable_world_state()->add_reality()->CopyFrom(*m_simulatorTruth.last());
     }
-
-
-    return status;
+    m_simulatorTruth.clear();
 }
 
 world::WorldSource Processor::currentWorldSource() const
@@ -232,6 +238,8 @@ QString Processor::ballModelConfigFile(bool isSimulator)
 void Processor::process(qint64 overwriteTime)
 {
     const qint64 tracker_start = Timer::systemTime();
+    // only count the allocations of this frame
+    StatusArenaPool::takeBlockAllocations();
 
     const qint64 current_time = overwriteTime == -1 ? m_timer->currentTime() : overwriteTime;
     // the controller runs with 100 Hz -> 10ms ticks
@@ -242,6 +250,7 @@ void Processor::process(qint64 overwriteTime)
     m_speedTracker->process(current_time);
     m_simpleTracker->process(current_time);
     Status status = assembleStatus(current_time, false);
+    injectSimulatorTruth(status);
     Status radioStatus = m_speedTracker->worldState(current_time, false);
 
     // add information, about whether the world state is from the simulator or not
@@ -311,9 +320,19 @@ void Processor::process(qint64 overwriteTime)
     const qint64 controller_start = Timer::systemTime();
     // just ignore the referee for timing
     status->mutable_timing()->set_tracking((controller_start - tracker_start) * 1E-9f);
+    qint64 estimatedDelay;
+    float delayConfidence;
+    if (m_tracker->systemDelayEstimate(estimatedDelay, delayConfidence)) {
+        status->mutable_timing()->set_system_delay_estimate(estimatedDelay * 1E-9f);
+        status->mutable_timing()->set_system_delay_confidence(qRound(delayConfidence * 100));
+    }
 
     amun::DebugValues *debug = status->add_debug();
     debug->set_source(amun::Controller);
+    // keep the names of unsubscribed controller visualizations known to the consumers
+    for (const char * const *name = CommandEvaluator::VISUALIZATIONS; *name; name++) {
+        m_debugSubscription.requestVisualization(debug, *name);
+    }
     QList<robot::RadioCommand> radio_commands_prio;
 
     {
@@ -352,6 +371,8 @@ void Processor::process(qint64 overwriteTime)
 
     // publish world state and timing information
     status->mutable_timing()->set_controller((Timer::systemTime() - controller_start) * 1E-9f);
+    compactDebugOutput(status);
+    status->mutable_timing()->set_processor_allocations(StatusArenaPool::takeBlockAllocations());
     emit sendStatus(status);
 
     if (m_transceiverEnabled) {
@@ -424,7 +445,7 @@ void Processor::processTeam(Team &team, bool isBlue, const RobotList &robots, QL
 
         // Get current robot
         const world::Robot* currentRobot = getWorldRobot(robots, robot->id);
-        robot->controller.calculateCommand(currentRobot, time, command, debug);
+        robot->controller.calculateCommand(currentRobot, time, command, debug, m_debugSubscription);
 
         injectRawSpeedIfAvailable(radio_command, radioRobots, currentRobot);
 
@@ -435,6 +456,13 @@ void Processor::processTeam(Team &team, bool isBlue, const RobotList &robots, QL
         } else {
             radio_commands.append(*radio_command);
         }
+
+        // the lists above hold copies of the radio command, attaching the statistics
+        // only after appending keeps them in the status and out of the radio packets
+        robot::TrackingError trackingError;
+        if (robot->controller.takeTrackingError(time, trackingError)) {
+            radio_command->mutable_tracking_error()->Swap(&trackingError);
+        }
     }
 }
 
@@ -452,6 +480,18 @@ void Processor::injectRawSpeedIfAvailable(robot::RadioCommand *radioCommand, con
     }
 }
 
+void Processor::compactDebugOutput(Status &status)
+{
+    // the controller and the trackers use separate id spaces
+    for (amun::DebugValues &debug : *status->mutable_debug()) {
+        m_imageEncoders[debug.source()].encode(&debug);
+        m_debugStrings[debug.source()].compact(&debug);
+    }
+    for (auto it = m_debugStrings.begin(); it != m_debugStrings.end(); ++it) {
+        it->flush(static_cast<amun::DebugSource>(it.key()), &*status);
+    }
+}
+
 void Processor::handleRefereePacket(const QByteArray &data, qint64 /*time*/, QString sender)
 {
     m_referee->handlePacket(data, sender);
@@ -470,9 +510,9 @@ void Processor::handleVisionPacket(const QByteArray &data, qint64 time, QString
     m_simpleTracker->queuePacket(data, time, sender);
 }
 
-void Processor::handleSimulatorExtraVision(const QByteArray &data)
+void Processor::handleSimulatorExtraVision(const SimulatorTruth &truth)
 {
-    m_extraVision.append(data);
+    m_simulatorTruth.append(truth);
 }
 
 void Processor::handleMixedTeamInfo(const QByteArray &data, qint64)
@@ -536,6 +576,10 @@ void Processor::handleCommand(const Command &command)
         }
     }
 
+    if (command->has_debug_subscription()) {
+        m_debugSubscription.update(command->debug_subscription());
+    }
+
     if (command->has_control()) {
         handleControl(m_blueTeam, command->control());
         handleControl(m_yellowTeam, command->control());
@@ -0,0 +1,163 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "radiolinkstatistics.h"
+#include <algorithm>
+#include <vector>
+
+RadioLinkStatistics::RadioLinkStatistics()
+{
+    clear();
+}
+
+int RadioLinkStatistics::slot(Radio::Generation generation, uint id)
+{
+    if (id >= (uint)ROBOTS_PER_GENERATION) {
+        return -1;
+    }
+    switch (generation) {
+    case Radio::Generation::Gen2014:
+        return id;
+    case Radio::Generation::Gen2018:
+        return ROBOTS_PER_GENERATION + id;
+    }
+    return -1;
+}
+
+RadioLinkStatistics::Entry *RadioLinkStatistics::append(Radio::Generation generation, uint id, qint64 time)
+{
+    const int s = slot(generation, id);
+    if (s < 0) {
+        return nullptr;
+    }
+    Window &w = m_windows[s];
+    Entry &e = w.entries[w.head];
+    if (e.sent && w.counterIndex[e.counter] == w.head) {
+        w.counterIndex[e.counter] = -1;
+    }
+    e = Entry();
+    e.time = time;
+    w.head = (w.head + 1) % WINDOW_SIZE;
+    w.size = std::min(w.size + 1, WINDOW_SIZE);
+    return &e;
+}
+
+void RadioLinkStatistics::commandDropped(Radio::Generation generation, uint id, qint64 time)
+{
+    append(generation, id, time);
+}
+
+void RadioLinkStatistics::commandSent(Radio::Generation generation, uint id, quint8 counter, qint64 time)
+{
+    Entry *e = append(generation, id, time);
+    if (!e) {
+        return;
+    }
+    e->sent = true;
+    e->counter = counter;
+    Window &w = m_windows[slot(generation, id)];
+    w.counterIndex[counter] = e - w.entries.data();
+}
+
+void RadioLinkStatistics::responseReceived(Radio::Generation generation, uint id, quint8 counter, qint64 time)
+{
+    const int s = slot(generation, id);
+    if (s < 0) {
+        return;
+    }
+    Window &w = m_windows[s];
+    const int index = w.counterIndex[counter];
+    if (index < 0) {
+        return;
+    }
+    Entry &e = w.entries[index];
+    // late responses are lost, otherwise the result would depend on the time of the evaluation
+    if (time - e.time > RESPONSE_TIMEOUT) {
+        return;
+    }
+    // only the first response for a command counts
+    if (e.latency < 0) {
+        e.latency = (time - e.time) * 1E-9f;
+    }
+}
+
+void RadioLinkStatistics::evaluate(qint64 time, QList<robot::RadioLinkQuality> &links) const
+{
+    std::vector<float> latencies;
+    latencies.reserve(WINDOW_SIZE);
+    for (int s = 0; s < SLOT_COUNT; s++) {
+        const Window &w = m_windows[s];
+        uint commands = 0;
+        uint sent = 0;
+        latencies.clear();
+        for (int age = 0; age < w.size; age++) {
+            const Entry &e = w.entries[(w.head - 1 - age + WINDOW_SIZE) % WINDOW_SIZE];
+            if (time - e.time > MAX_AGE) {
+                break;
+            }
+            // a late response would be counted as lost
+            if (time - e.time < RESPONSE_TIMEOUT && e.latency < 0) {
+                continue;
+            }
+            commands++;
+            if (e.sent) {
+                sent++;
+                if (e.latency >= 0) {
+                    latencies.push_back(e.latency);
+                }
+            }
+        }
+        if (commands == 0) {
+            continue;
+        }
+
+        robot::RadioLinkQuality link;
+        link.set_generation((uint)(s < ROBOTS_PER_GENERATION ? Radio::Generation::Gen2014 : Radio::Generation::Gen2018));
+        link.set_id(s % ROBOTS_PER_GENERATION);
+        link.set_commands(commands);
+        link.set_sent(sent);
+        link.set_responses(latencies.size());
+        link.set_delivery_rate(sent / float(commands));
+        if (sent > 0) {
+            link.set_response_rate(latencies.size() / float(sent));
+        }
+        if (!latencies.empty()) {
+            std::sort(latencies.begin(), latencies.end());
+            float sum = 0;
+            for (float latency : latencies) {
+                sum += latency;
+            }
+            link.set_latency_mean(sum / latencies.size());
+            link.set_latency_median(latencies[latencies.size() / 2]);
+            link.set_latency_p95(latencies[(latencies.size() * 95) / 100]);
+            link.set_latency_max(latencies.back());
+        }
+        links.append(link);
+    }
+}
+
+void RadioLinkStatistics::clear()
+{
+    for (Window &w : m_windows) {
+        w.head = 0;
+        w.size = 0;
+        w.counterIndex.fill(-1);
+    }
+}
@@ -57,7 +57,8 @@ RadioSystem::RadioSystem(const Timer *timer) :
     m_simulatorEnabled(false),
     m_onlyRestartAfterTimestamp(0),
     m_timer(timer),
-    m_droppedCommands(0)
+    m_droppedCommands(0),
+    m_lastLinkReport(0)
 {
     m_timeoutTimer = new QTimer(this);
     m_timeoutTimer->setSingleShot(true);
@@ -70,12 +71,16 @@ RadioSystem::RadioSystem(const Timer *timer) :
 
 void RadioSystem::handleRadioCommands(const QList<robot::RadioCommand> &commands, qint64 processingStart)
 {
-    m_commands = commands;
-    m_processingStart = processingStart;
     if (m_processTimer->isActive()) {
         // the timer is stil active, that is the last commands were not yet processed!
         m_droppedCommands++;
+        const qint64 time = Timer::systemTime();
+        for (const robot::RadioCommand &command : m_commands) {
+            m_linkStatistics.commandDropped(uintToGeneration(command.generation()), command.id(), time);
+        }
     }
+    m_commands = commands;
+    m_processingStart = processingStart;
     m_processTimer->start(0);
 }
 
@@ -87,7 +92,16 @@ void RadioSystem::process()
     // charging the condensator can be enabled / disable separately
     sendCommand(m_commands, m_charge, m_processingStart);
 
-    status->mutable_timing()->set_transceiver((Timer::systemTime() - transceiver_start) * 1E-9f);
+    const qint64 transceiverEnd = Timer::systemTime();
+    status->mutable_timing()->set_transceiver((transceiverEnd - transceiver_start) * 1E-9f);
+    if (transceiverEnd - m_lastLinkReport >= LINK_REPORT_INTERVAL) {
+        QList<robot::RadioLinkQuality> links;
+        m_linkStatistics.evaluate(transceiverEnd, links);
+        for (const robot::RadioLinkQuality &link : links) {
+            *status->mutable_timing()->add_radio_link() = link;
+        }
+        m_lastLinkReport = transceiverEnd;
+    }
     emit sendStatus(status);
 }
 
@@ -115,6 +129,10 @@ void RadioSystem::handleCommand(const Command &command)
         if (t.has_charge()) {
             m_charge = t.charge();
         }
+
+        if (t.has_response_interval_ms()) {
+            m_telemetry.setResponseInterval(t.response_interval_ms() * qint64(1000 * 1000));
+        }
     }
 
     if (command->has_set_team_blue()) {
@@ -191,6 +209,7 @@ void RadioSystem::closeTransceiver()
 {
     delete m_transceiverLayer;
     m_transceiverLayer = nullptr;
+    m_telemetry.clear();
 
     m_timeoutTimer->stop();
 }
@@ -236,13 +255,17 @@ void RadioSystem::timeout()
 
 void RadioSystem::onRawRadioResponse(qint64 receiveTime, const QList<QByteArray> &rawResponses)
 {
-    QList<robot::RadioResponse> responses;
-
+    // decode the whole batch into the telemetry columns first,
+    // then forward the robots whose state changed or is due
     for (const QByteArray &packet : rawResponses) {
-        handleResponsePacket(responses, packet.data(), packet.size(), receiveTime);
+        handleResponsePacket(packet.data(), packet.size(), receiveTime);
     }
 
-    emit sendRadioResponses(responses);
+    QList<robot::RadioResponse> responses;
+    m_telemetry.takeResponses(receiveTime, responses);
+    if (!responses.isEmpty()) {
+        emit sendRadioResponses(responses);
+    }
 }
 
 float RadioSystem::calculateDroppedFramesRatio(Radio::Generation generation, uint id, uint8_t counter, int skipedFrames)
@@ -278,110 +301,71 @@ float RadioSystem::calculateDroppedFramesRatio(Radio::Generation generation, uin
     return c.droppedFramesRatio;
 }
 
-void RadioSystem::handleResponsePacket(QList<robot::RadioResponse> &responses, const char *data, uint size, qint64 time)
+template <typename RadioResponse>
+void RadioSystem::decodeResponse(Radio::Generation generation, const RadioResponse *packet, qint64 time)
 {
-    const RadioResponseHeader *header = (const RadioResponseHeader *)data;
-    size -= sizeof(RadioResponseHeader);
-    data += sizeof(RadioResponseHeader);
-
-    if (header->command == RESPONSE_2014_DEFAULT && size == sizeof(RadioResponse2014)) {
-        const RadioResponse2014 *packet = (const RadioResponse2014 *)data;
-
-        robot::RadioResponse r;
-        r.set_time(time);
-        r.set_generation((uint)Radio::Generation::Gen2014);
-        r.set_id(packet->id);
-
-        int packet_loss = (packet->extension_id == EXTENSION_BASIC_STATUS) ? packet->packet_loss : -1;
-        float df = calculateDroppedFramesRatio(Radio::Generation::Gen2014, packet->id, packet->counter, packet_loss);
-        switch (packet->extension_id) {
-        case EXTENSION_BASIC_STATUS:
-            r.set_battery(packet->battery / 255.0f);
-            r.set_packet_loss_rx(packet->packet_loss / 256.0f);
-            r.set_packet_loss_tx(df);
-            break;
-        case EXTENSION_EXTENDED_ERROR:
-        {
-            robot::ExtendedError *e = r.mutable_extended_error();
-            e->set_motor_1_error(packet->motor_1_error);
-            e->set_motor_2_error(packet->motor_2_error);
-            e->set_motor_3_error(packet->motor_3_error);
-            e->set_motor_4_error(packet->motor_4_error);
-            e->set_dribbler_error(packet->dribler_error);
-            e->set_kicker_error(packet->kicker_error);
-            e->set_kicker_break_beam_error(packet->kicker_break_beam_error);
-            e->set_motor_encoder_error(packet->motor_encoder_error);
-            e->set_main_sensor_error(packet->main_sensor_error);
-            e->set_temperature(packet->temperature);
-            break;
-        }
-        default:
-            break;
-        }
-
-        if (packet->power_enabled) {
-            robot::SpeedStatus *speedStatus = r.mutable_estimated_speed();
-            speedStatus->set_v_f(packet->v_f / 1000.f);
-            speedStatus->set_v_s(packet->v_s / 1000.f);
-            speedStatus->set_omega(packet->omega / 1000.f);
-            r.set_error_present(packet->error_present);
+    RadioTelemetry::Sample s;
+    s.time = time;
+
+    int packet_loss = (packet->extension_id == EXTENSION_BASIC_STATUS) ? packet->packet_loss : -1;
+    float df = calculateDroppedFramesRatio(generation, packet->id, packet->counter, packet_loss);
+    switch (packet->extension_id) {
+    case EXTENSION_BASIC_STATUS:
+        s.flags |= RadioTelemetry::HasBasicStatus;
+        s.battery = packet->battery / 255.0f;
+        s.packetLossRx = packet->packet_loss / 256.0f;
+        s.packetLossTx = df;
+        break;
+    case EXTENSION_EXTENDED_ERROR:
+        s.flags |= RadioTelemetry::HasExtendedError;
+        s.errors = (packet->motor_1_error ? RadioTelemetry::Motor1Error : 0)
+                | (packet->motor_2_error ? RadioTelemetry::Motor2Error : 0)
+                | (packet->motor_3_error ? RadioTelemetry::Motor3Error : 0)
+                | (packet->motor_4_error ? RadioTelemetry::Motor4Error : 0)
+                | (packet->dribler_error ? RadioTelemetry::DribblerError : 0)
+                | (packet->kicker_error ? RadioTelemetry::KickerError : 0)
+                | (packet->kicker_break_beam_error ? RadioTelemetry::KickerBreakBeamError : 0)
+                | (packet->motor_encoder_error ? RadioTelemetry::MotorEncoderError : 0)
+                | (packet->main_sensor_error ? RadioTelemetry::MainSensorError : 0);
+        s.temperature = packet->temperature;
+        break;
+    default:
+        break;
+    }
 
-            r.set_ball_detected(packet->ball_detected);
-            r.set_cap_charged(packet->cap_charged);
+    if (packet->power_enabled) {
+        s.flags |= RadioTelemetry::PowerEnabled;
+        s.vF = packet->v_f / 1000.f;
+        s.vS = packet->v_s / 1000.f;
+        s.omega = packet->omega / 1000.f;
+        if (packet->error_present) {
+            s.flags |= RadioTelemetry::ErrorPresent;
         }
-        if (m_frameTimes.contains(packet->counter)) {
-            r.set_radio_rtt((time - m_frameTimes[packet->counter]) * 1E-9f);
+        if (packet->ball_detected) {
+            s.flags |= RadioTelemetry::BallDetected;
         }
-        responses.append(r);
-    } else if (header->command == RESPONSE_2018_DEFAULT && size == sizeof(RadioResponse2018)) {
-        const RadioResponse2018 *packet = (const RadioResponse2018 *)data;
-
-        robot::RadioResponse r;
-        r.set_time(time);
-        r.set_generation((uint)Radio::Generation::Gen2018);
-        r.set_id(packet->id);
-
-        int packet_loss = (packet->extension_id == EXTENSION_BASIC_STATUS) ? packet->packet_loss : -1;
-        float df = calculateDroppedFramesRatio(Radio::Generation::Gen2018, packet->id, packet->counter, packet_loss);
-        switch (packet->extension_id) {
-        case EXTENSION_BASIC_STATUS:
-            r.set_battery(packet->battery / 255.0f);
-            r.set_packet_loss_rx(packet->packet_loss / 256.0f);
-            r.set_packet_loss_tx(df);
-            break;
-        case EXTENSION_EXTENDED_ERROR:
-        {
-            robot::ExtendedError *e = r.mutable_extended_error();
-            e->set_motor_1_error(packet->motor_1_error);
-            e->set_motor_2_error(packet->motor_2_error);
-            e->set_motor_3_error(packet->motor_3_error);
-            e->set_motor_4_error(packet->motor_4_error);
-            e->set_dribbler_error(packet->dribler_error);
-            e->set_kicker_error(packet->kicker_error);
-            e->set_kicker_break_beam_error(packet->kicker_break_beam_error);
-            e->set_motor_encoder_error(packet->motor_encoder_error);
-            e->set_main_sensor_error(packet->main_sensor_error);
-            e->set_temperature(packet->temperature);
-            break;
-        }
-        default:
-            break;
+        if (packet->cap_charged) {
+            s.flags |= RadioTelemetry::CapCharged;
         }
+    }
+    if (m_frameTimes.contains(packet->counter)) {
+        s.flags |= RadioTelemetry::HasRtt;
+        s.rtt = (time - m_frameTimes[packet->counter]) * 1E-9f;
+    }
+    m_linkStatistics.responseReceived(generation, packet->id, packet->counter, time);
+    m_telemetry.append(generation, packet->id, s);
+}
 
-        if (packet->power_enabled) {
-            robot::SpeedStatus *speedStatus = r.mutable_estimated_speed();
-            speedStatus->set_v_f(packet->v_f / 1000.f);
-            speedStatus->set_v_s(packet->v_s / 1000.f);
-            speedStatus->set_omega(packet->omega / 1000.f);
-            r.set_error_present(packet->error_present);
+void RadioSystem::handleResponsePacket(const char *data, uint size, qint64 time)
+{
+    const RadioResponseHeader *header = (const RadioResponseHeader *)data;
+    size -= sizeof(RadioResponseHeader);
+    data += sizeof(RadioResponseHeader);
 
-            r.set_ball_detected(packet->ball_detected);
-            r.set_cap_charged(packet->cap_charged);
-        }
-        if (m_frameTimes.contains(packet->counter)) {
-            r.set_radio_rtt((time - m_frameTimes[packet->counter]) * 1E-9f);
-        }
-        responses.append(r);
+    if (header->command == RESPONSE_2014_DEFAULT && size == sizeof(RadioResponse2014)) {
+        decodeResponse(Radio::Generation::Gen2014, (const RadioResponse2014 *)data, time);
+    } else if (header->command == RESPONSE_2018_DEFAULT && size == sizeof(RadioResponse2018)) {
+        decodeResponse(Radio::Generation::Gen2018, (const RadioResponse2018 *)data, time);
     }
 }
 
@@ -604,6 +588,7 @@ void RadioSystem::sendCommand(const QList<robot::RadioCommand> &commands, bool c
         it.next();
 
         foreach (const robot::RadioCommand &radio_command, it.value()) {
+            m_linkStatistics.commandSent(it.key(), radio_command.id(), m_packetCounter, time);
             if (it.key() == Radio::Generation::Gen2014) {
                 addRobot2014Command(radio_command.id(), radio_command.command(), charge, m_packetCounter);
             } else if (it.key() == Radio::Generation::Gen2018) {
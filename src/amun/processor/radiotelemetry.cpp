@@ -0,0 +1,235 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "radiotelemetry.h"
+#include <algorithm>
+
+// flags whose change is forwarded immediately
+static const quint8 STATE_FLAGS = RadioTelemetry::PowerEnabled | RadioTelemetry::ErrorPresent
+        | RadioTelemetry::BallDetected | RadioTelemetry::CapCharged;
+
+RadioTelemetry::Sample RadioTelemetry::Columns::sample(int age) const
+{
+    const int i = index(age);
+    Sample s;
+    s.time = time[i];
+    s.battery = battery[i];
+    s.packetLossRx = packetLossRx[i];
+    s.packetLossTx = packetLossTx[i];
+    s.vF = vF[i];
+    s.vS = vS[i];
+    s.omega = omega[i];
+    s.rtt = rtt[i];
+    s.temperature = temperature[i];
+    s.errors = errors[i];
+    s.flags = flags[i];
+    return s;
+}
+
+RadioTelemetry::RadioTelemetry() :
+    m_responseInterval(0)
+{ }
+
+int RadioTelemetry::slot(Radio::Generation generation, uint id)
+{
+    if (id >= (uint)ROBOTS_PER_GENERATION) {
+        return -1;
+    }
+    switch (generation) {
+    case Radio::Generation::Gen2014:
+        return id;
+    case Radio::Generation::Gen2018:
+        return ROBOTS_PER_GENERATION + id;
+    }
+    return -1;
+}
+
+Radio::Generation RadioTelemetry::slotGeneration(int slot)
+{
+    return (slot < ROBOTS_PER_GENERATION) ? Radio::Generation::Gen2014 : Radio::Generation::Gen2018;
+}
+
+bool RadioTelemetry::append(Radio::Generation generation, uint id, const Sample &sample)
+{
+    const int s = slot(generation, id);
+    if (s < 0) {
+        return false;
+    }
+
+    Columns &c = m_columns[s];
+    const int i = c.head;
+    c.time[i] = sample.time;
+    c.battery[i] = sample.battery;
+    c.packetLossRx[i] = sample.packetLossRx;
+    c.packetLossTx[i] = sample.packetLossTx;
+    c.vF[i] = sample.vF;
+    c.vS[i] = sample.vS;
+    c.omega[i] = sample.omega;
+    c.rtt[i] = sample.rtt;
+    c.temperature[i] = sample.temperature;
+    c.errors[i] = sample.errors;
+    c.flags[i] = sample.flags;
+    c.head = (c.head + 1) % HISTORY_SIZE;
+    c.size = std::min(c.size + 1, HISTORY_SIZE);
+
+    ForwardState &f = m_forward[s];
+    // samples which were overwritten before being forwarded are lost
+    f.pending = std::min(f.pending + 1, HISTORY_SIZE);
+    return true;
+}
+
+void RadioTelemetry::fillResponse(robot::RadioResponse &r, const Sample &sample)
+{
+    r.set_time(sample.time);
+    if (sample.flags & HasBasicStatus) {
+        r.set_battery(sample.battery);
+        r.set_packet_loss_rx(sample.packetLossRx);
+        r.set_packet_loss_tx(sample.packetLossTx);
+    }
+    if (sample.flags & HasExtendedError) {
+        robot::ExtendedError *e = r.mutable_extended_error();
+        e->set_motor_1_error(sample.errors & Motor1Error);
+        e->set_motor_2_error(sample.errors & Motor2Error);
+        e->set_motor_3_error(sample.errors & Motor3Error);
+        e->set_motor_4_error(sample.errors & Motor4Error);
+        e->set_dribbler_error(sample.errors & DribblerError);
+        e->set_kicker_error(sample.errors & KickerError);
+        e->set_kicker_break_beam_error(sample.errors & KickerBreakBeamError);
+        e->set_motor_encoder_error(sample.errors & MotorEncoderError);
+        e->set_main_sensor_error(sample.errors & MainSensorError);
+        e->set_temperature(sample.temperature);
+    }
+    if (sample.flags & PowerEnabled) {
+        robot::SpeedStatus *speedStatus = r.mutable_estimated_speed();
+        speedStatus->set_v_f(sample.vF);
+        speedStatus->set_v_s(sample.vS);
+        speedStatus->set_omega(sample.omega);
+        r.set_error_present(sample.flags & ErrorPresent);
+        r.set_ball_detected(sample.flags & BallDetected);
+        r.set_cap_charged(sample.flags & CapCharged);
+    }
+    if (sample.flags & HasRtt) {
+        r.set_radio_rtt(sample.rtt);
+    }
+}
+
+void RadioTelemetry::fillMerged(robot::RadioResponse &r, const Columns &c, int pending)
+{
+    // the state is taken from the latest sample, the extensions from
+    // the latest pending sample that carried them
+    Sample merged = c.sample(0);
+    for (quint8 extension : { HasBasicStatus, HasExtendedError, HasRtt }) {
+        if (merged.flags & extension) {
+            continue;
+        }
+        for (int age = 1; age < pending; age++) {
+            const int i = c.index(age);
+            if (!(c.flags[i] & extension)) {
+                continue;
+            }
+            merged.flags |= extension;
+            if (extension == HasBasicStatus) {
+                merged.battery = c.battery[i];
+                merged.packetLossRx = c.packetLossRx[i];
+                merged.packetLossTx = c.packetLossTx[i];
+            } else if (extension == HasExtendedError) {
+                merged.errors = c.errors[i];
+                merged.temperature = c.temperature[i];
+            } else {
+                merged.rtt = c.rtt[i];
+            }
+            break;
+        }
+    }
+    fillResponse(r, merged);
+}
+
+void RadioTelemetry::takeResponses(qint64 time, QList<robot::RadioResponse> &responses)
+{
+    for (int s = 0; s < SLOT_COUNT; s++) {
+        ForwardState &f = m_forward[s];
+        if (f.pending == 0) {
+            continue;
+        }
+        const Columns &c = m_columns[s];
+        const Radio::Generation generation = slotGeneration(s);
+        const uint id = s % ROBOTS_PER_GENERATION;
+
+        if (m_responseInterval <= 0) {
+            for (int age = f.pending - 1; age >= 0; age--) {
+                robot::RadioResponse r;
+                r.set_generation((uint)generation);
+                r.set_id(id);
+                fillResponse(r, c.sample(age));
+                responses.append(r);
+            }
+            f.pending = 0;
+            continue;
+        }
+
+        const quint8 flags = c.flags[c.index(0)] & STATE_FLAGS;
+        bool changed = !f.forwarded || flags != f.flags;
+        int errorIndex = -1;
+        for (int age = 0; age < f.pending; age++) {
+            if (c.flags[c.index(age)] & HasExtendedError) {
+                errorIndex = c.index(age);
+                break;
+            }
+        }
+        if (errorIndex >= 0 && c.errors[errorIndex] != f.errors) {
+            changed = true;
+        }
+        if (!changed && time - f.lastForwarded < m_responseInterval) {
+            continue;
+        }
+
+        robot::RadioResponse r;
+        r.set_generation((uint)generation);
+        r.set_id(id);
+        fillMerged(r, c, f.pending);
+        responses.append(r);
+
+        f.forwarded = true;
+        f.lastForwarded = time;
+        f.flags = flags;
+        if (errorIndex >= 0) {
+            f.errors = c.errors[errorIndex];
+        }
+        f.pending = 0;
+    }
+}
+
+void RadioTelemetry::clear()
+{
+    for (Columns &c : m_columns) {
+        c.head = 0;
+        c.size = 0;
+    }
+    m_forward.fill(ForwardState());
+}
+
+const RadioTelemetry::Columns *RadioTelemetry::columns(Radio::Generation generation, uint id) const
+{
+    const int s = slot(generation, id);
+    if (s < 0 || m_columns[s].size == 0) {
+        return nullptr;
+    }
+    return &m_columns[s];
+}
@@ -47,6 +47,8 @@ struct VisionFrame
     qint64 captureTime;
     RobotInfo robot;
     qint64 visionProcessingTime;
+    // set for frames that are applied again after an out of sequence frame
+    bool replayed = false;
 };
 
 struct CameraInfo {
@@ -21,10 +21,36 @@
 #include "balltracker.h"
 #include "ballflyfilter.h"
 #include "ballgroundcollisionfilter.h"
+#include <algorithm>
+#include <limits>
+
+// how late a frame may be to still be fused at its capture time
+const qint64 MAX_REORDER_TIME = 100 * 1000 * 1000;
+const std::size_t MAX_HISTORY_SIZE = 16;
+// the shot detection of the fly filter looks at most this many frames back
+const int RECENT_FRAME_COUNT = 8;
+
+BallTracker::HistoryEntry::HistoryEntry(const FlyFilter *fly, const BallGroundCollisionFilter &ground, const QList<VisionFrame> &recent,
+                                        qint32 primaryCamera, qint64 frameTime, const Eigen::Vector2f &ballPos, const VisionFrame &visionFrame) :
+    flyFilter(fly ? new FlyFilter(*fly) : nullptr),
+    groundFilter(new BallGroundCollisionFilter(ground, primaryCamera)),
+    recentFrames(recent),
+    lastFrameTime(frameTime),
+    lastBallPos(ballPos),
+    frame(visionFrame)
+{
+    if (flyFilter) {
+        flyFilter->moveToCamera(primaryCamera);
+    }
+    groundFilter->moveToCamera(primaryCamera);
+}
 
 BallTracker::BallTracker(const VisionFrame &frame, CameraInfo *cameraInfo, const FieldTransform &transform, const world::BallModel &ballModel) :
     Filter(frame.time),
     m_lastUpdateTime(frame.time),
+    m_flyFilter(nullptr),
+    m_transform(transform),
+    m_ballModel(ballModel),
     m_cameraInfo(cameraInfo),
     m_initTime(frame.time),
     m_lastFrameTime(0),
@@ -34,12 +60,15 @@ BallTracker::BallTracker(const VisionFrame &frame, CameraInfo *cameraInfo, const
 {
     m_primaryCamera = frame.cameraId;
     m_groundFilter = new BallGroundCollisionFilter(frame, cameraInfo, transform, ballModel);
-    m_flyFilter = new FlyFilter(frame, cameraInfo, transform, ballModel);
 }
 
 BallTracker::BallTracker(const BallTracker& previousFilter, qint32 primaryCamera) :
     Filter(previousFilter.lastUpdate()),
     m_lastUpdateTime(previousFilter.m_lastUpdateTime),
+    m_flyFilter(nullptr),
+    m_recentFrames(previousFilter.m_recentFrames),
+    m_transform(previousFilter.m_transform),
+    m_ballModel(previousFilter.m_ballModel),
     m_cameraInfo(previousFilter.m_cameraInfo),
     m_initTime(previousFilter.m_initTime),
     m_lastBallPos(previousFilter.m_lastBallPos),
@@ -50,10 +79,17 @@ BallTracker::BallTracker(const BallTracker& previousFilter, qint32 primaryCamera
 {
     m_primaryCamera = primaryCamera;
 
-    m_flyFilter = new FlyFilter(*previousFilter.m_flyFilter);
-    m_flyFilter->moveToCamera(primaryCamera);
+    if (previousFilter.m_flyFilter) {
+        m_flyFilter = new FlyFilter(*previousFilter.m_flyFilter);
+        m_flyFilter->moveToCamera(primaryCamera);
+    }
     m_groundFilter = new BallGroundCollisionFilter(*previousFilter.m_groundFilter, primaryCamera);
     m_groundFilter->moveToCamera(primaryCamera);
+
+    for (const HistoryEntry &entry : previousFilter.m_history) {
+        m_history.emplace_back(entry.flyFilter.get(), *entry.groundFilter, entry.recentFrames, primaryCamera,
+                               entry.lastFrameTime, entry.lastBallPos, entry.frame);
+    }
 }
 
 BallTracker::~BallTracker()
@@ -64,7 +100,7 @@ BallTracker::~BallTracker()
 
 int BallTracker::chooseDetection(const std::vector<VisionFrame> &possibleFrames)
 {
-    const int flyFilterChoice = m_flyFilter->chooseDetection(possibleFrames);
+    const int flyFilterChoice = m_flyFilter ? m_flyFilter->chooseDetection(possibleFrames) : -1;
     const int groundFilterChoice = m_groundFilter->chooseDetection(possibleFrames);
     debug("accept", flyFilterChoice >= 0 || groundFilterChoice >= 0);
     debug("acceptId", possibleFrames.at(0).cameraId);
@@ -77,7 +113,7 @@ void BallTracker::calcDistToCamera(bool flying)
 {
     Eigen::Vector3f cam = m_cameraInfo->cameraPosition.value(m_primaryCamera);
     float dist = (m_lastBallPos - Eigen::Vector2f(cam(0), cam(1))).norm();
-    if (flying && m_flyFilter->isActive()) {
+    if (flying && isFlying()) {
         dist = m_flyFilter->distToStartPos();
     }
 
@@ -92,7 +128,26 @@ float BallTracker::cachedDistToCamera()
 
 bool BallTracker::isFlying() const
 {
-    return m_flyFilter->isActive();
+    return m_flyFilter && m_flyFilter->isActive();
+}
+
+bool BallTracker::isChipPlausible(const VisionFrame &frame)
+{
+    // a shot is only detected for balls starting close to a dribbler (see FlyFilter::checkIsShot)
+    const float MAX_DRIBBLER_DIST = 0.2f;
+    return frame.robot.identifier != std::numeric_limits<int>::max()
+            && (frame.robot.dribblerPos - Eigen::Vector2f(frame.x, frame.y)).norm() < MAX_DRIBBLER_DIST;
+}
+
+void BallTracker::activateFlyFilter(const VisionFrame &frame)
+{
+    const VisionFrame &first = m_recentFrames.isEmpty() ? frame : m_recentFrames.first();
+    m_flyFilter = new FlyFilter(first, m_cameraInfo, m_transform, m_ballModel);
+    m_flyFilter->moveToCamera(m_primaryCamera);
+    for (const VisionFrame &recent : m_recentFrames) {
+        m_flyFilter->processVisionFrame(recent);
+    }
+    m_recentFrames.clear();
 }
 
 void BallTracker::updateConfidence()
@@ -110,9 +165,26 @@ void BallTracker::update(qint64 time)
             break; // try again later
         }
 
-        m_flyFilter->processVisionFrame(frame);
+        m_history.emplace_back(m_flyFilter, *m_groundFilter, m_recentFrames, m_primaryCamera, m_lastFrameTime, m_lastBallPos, frame);
+        while (m_history.size() > MAX_HISTORY_SIZE || m_history.front().frame.time < frame.time - MAX_REORDER_TIME) {
+            m_history.pop_front();
+        }
+
+        if (!m_flyFilter && isChipPlausible(frame)) {
+            activateFlyFilter(frame);
+        }
+        if (m_flyFilter) {
+            m_flyFilter->processVisionFrame(frame);
+        } else {
+            m_recentFrames.append(frame);
+            if (m_recentFrames.size() > RECENT_FRAME_COUNT) {
+                m_recentFrames.removeFirst();
+            }
+        }
         m_groundFilter->processVisionFrame(frame);
-        m_rawMeasurements.append(frame);
+        if (!frame.replayed) {
+            m_rawMeasurements.append(frame);
+        }
 
         m_lastFrameTime = frame.time;
         m_lastTime = time;
@@ -125,8 +197,10 @@ void BallTracker::update(qint64 time)
 #ifdef ENABLE_TRACKING_DEBUG
     m_debug.MergeFrom(m_groundFilter->debugValues());
     m_groundFilter->clearDebugValues();
-    m_debug.MergeFrom(m_flyFilter->debugValues());
-    m_flyFilter->clearDebugValues();
+    if (m_flyFilter) {
+        m_debug.MergeFrom(m_flyFilter->debugValues());
+        m_flyFilter->clearDebugValues();
+    }
 #endif
 }
 
@@ -134,7 +208,7 @@ void BallTracker::get(world::Ball *ball, const FieldTransform &transform, bool r
 {
     ball->set_is_bouncing(false); // fly filter overwrites if appropriate
 
-    if (m_flyFilter->isActive()) {
+    if (isFlying()) {
         debug("active", "fly filter");
         m_flyFilter->writeBallState(ball, m_lastUpdateTime, robots, lastCameraFrameTime);
     } else {
@@ -174,17 +248,54 @@ void BallTracker::get(world::Ball *ball, const FieldTransform &transform, bool r
     }
 }
 
+// restores the state before the first applied frame that is newer than time and queues
+// that frame and all following ones again. Returns false if the history does not reach back far enough
+bool BallTracker::rewindTo(qint64 time)
+{
+    const auto it = std::find_if(m_history.begin(), m_history.end(), [time](const HistoryEntry &entry) {
+        return entry.frame.time > time;
+    });
+    if (it == m_history.end() || it->lastFrameTime > time) {
+        return false;
+    }
+    const std::size_t index = it - m_history.begin();
+    delete m_flyFilter;
+    m_flyFilter = it->flyFilter.release();
+    delete m_groundFilter;
+    m_groundFilter = it->groundFilter.release();
+    m_recentFrames = it->recentFrames;
+    m_lastFrameTime = it->lastFrameTime;
+    m_lastBallPos = it->lastBallPos;
+
+    // the newest entry is queued first, as everything is prepended
+    while (m_history.size() > index) {
+        HistoryEntry &entry = m_history.back();
+        entry.frame.replayed = true;
+        m_visionFrames.prepend(entry.frame);
+        m_history.pop_back();
+    }
+    return true;
+}
+
 void BallTracker::addVisionFrame(const VisionFrame &frame)
 {
-    m_lastTime = frame.time;
-    m_visionFrames.append(frame);
+    // a filter copied from another camera may already be newer than the frame,
+    // without a matching history entry the frame is just applied late
+    if (frame.time < m_lastFrameTime) {
+        rewindTo(frame.time);
+    }
+    m_lastTime = std::max(m_lastTime, frame.time);
+    const auto it = std::upper_bound(m_visionFrames.begin(), m_visionFrames.end(), frame.time, [](qint64 time, const VisionFrame &f) {
+        return time < f.time;
+    });
+    m_visionFrames.insert(it, frame);
     m_frameCounter++;
     m_updateFrameCounter++;
 }
 
 bool BallTracker::isFeasiblyInvisible() const
 {
-    if (m_flyFilter->isActive()) {
+    if (isFlying()) {
         return false;
     } else {
         return m_groundFilter->isFeasiblyInvisible();
@@ -27,6 +27,8 @@
 #include "abstractballfilter.h"
 #include "protobuf/debug.pb.h"
 #include "protobuf/world.pb.h"
+#include <deque>
+#include <memory>
 
 class FlyFilter;
 class BallGroundCollisionFilter;
@@ -51,6 +53,7 @@ public:
     void calcDistToCamera(bool flying);
     float cachedDistToCamera();
     bool isFlying() const;
+    bool hasFlyFilter() const { return m_flyFilter != nullptr; }
     qint64 initTime() const { return m_initTime; }
     double confidence() const { return m_confidence; }
     bool isFeasiblyInvisible() const;
@@ -65,10 +68,21 @@ public:
     }
 #endif
 
+private:
+    bool rewindTo(qint64 time);
+    // the fly filter is only created once a chip is plausible
+    static bool isChipPlausible(const VisionFrame &frame);
+    void activateFlyFilter(const VisionFrame &frame);
+
 private:  
     qint64 m_lastUpdateTime;
     BallGroundCollisionFilter* m_groundFilter;
+    // nullptr as long as no chip is plausible
     FlyFilter *m_flyFilter;
+    // the last frames are replayed to the fly filter on activation
+    QList<VisionFrame> m_recentFrames;
+    const FieldTransform &m_transform;
+    const world::BallModel &m_ballModel;
     QList<VisionFrame> m_visionFrames;
     QList<VisionFrame> m_rawMeasurements;
     CameraInfo* m_cameraInfo;
@@ -79,6 +93,21 @@ private:
     int m_updateFrameCounter;
     float m_cachedDistToCamera;
 
+    // filter state before each applied vision frame, allows fusing frames
+    // of the camera this filter was copied from at their capture time
+    struct HistoryEntry
+    {
+        HistoryEntry(const FlyFilter *fly, const BallGroundCollisionFilter &ground, const QList<VisionFrame> &recent,
+                     qint32 primaryCamera, qint64 frameTime, const Eigen::Vector2f &ballPos, const VisionFrame &visionFrame);
+        std::unique_ptr<FlyFilter> flyFilter;
+        std::unique_ptr<BallGroundCollisionFilter> groundFilter;
+        QList<VisionFrame> recentFrames;
+        qint64 lastFrameTime;
+        Eigen::Vector2f lastBallPos;
+        VisionFrame frame;
+    };
+    std::deque<HistoryEntry> m_history;
+
 #ifdef ENABLE_TRACKING_DEBUG
     amun::DebugValues m_debug;
     void debug(const char* key, float value){
@@ -23,10 +23,12 @@
 
 #include "protobuf/command.pb.h"
 #include "protobuf/status.h"
+#include "protobuf/statusarenapool.h"
 #include "protobuf/world.pb.h"
 #include <QMap>
 #include <QPair>
 #include <QByteArray>
+#include <vector>
 
 class BallTracker;
 class RobotFilter;
@@ -38,7 +40,9 @@ class SSL_FieldCircularArc;
 class SSL_FieldLineSegment;
 class SSL_GeometryCameraCalibration;
 class FieldTransform;
+class SystemDelayEstimator;
 struct CameraInfo;
+struct VisionFrame;
 
 class Tracker
 {
@@ -69,6 +73,8 @@ public:
     void finishProcessing(); // has to be called after all calls to worldState for one frame
     void setGeometryUpdated() { m_geometryUpdated = true; }
     void setBallModel(const world::BallModel &ballModel) { m_ballModel.CopyFrom(ballModel); }
+    // returns false as long as there is no estimate
+    bool systemDelayEstimate(qint64 &delay, float &confidence) const;
 
 private:
     void updateCamera(const SSL_GeometryCameraCalibration &c, QString sender);
@@ -84,12 +90,17 @@ private:
 
     BallTracker* bestBallFilter();
     void prioritizeBallFilters();
+    // removes the weakest young ball filter if the pool is full, returns false if that is not possible
+    bool makeRoomForBallFilter(const std::vector<BallTracker*> &keep);
 
 private:
     typedef QPair<robot::RadioCommand, qint64> RadioCommand;
     CameraInfo * const m_cameraInfo;
 
     qint64 m_systemDelay;
+    qint64 m_configuredSystemDelay;
+    bool m_systemDelayAuto;
+    std::unique_ptr<SystemDelayEstimator> m_delayEstimator;
     qint64 m_timeSinceLastReset;
     // used to delay the reset, to avoid accepting invalid vision frames that were sent before reset was triggered
     qint64 m_timeToReset = std::numeric_limits<qint64>::max();
@@ -111,6 +122,10 @@ private:
 
     QList<BallTracker*> m_ballFilter;
     BallTracker* m_currentBallFilter;
+    // single ball detections which are not yet confirmed by a second one
+    std::vector<VisionFrame> m_ballCandidates;
+    // time spent in the ball tracking since the last world state
+    qint64 m_ballTrackingTime = 0;
 
     RobotMap m_robotFilterYellow;
     RobotMap m_robotFilterBlue;
@@ -122,12 +137,16 @@ private:
     float m_aoi_y2;
 
     QList<QString> m_errorMessages;
-    QList<std::pair<SSL_WrapperPacket, qint64>> m_detectionWrappers;
+    // received vision packets, forwarded unparsed
+    QList<std::pair<QByteArray, qint64>> m_detectionWrappers;
     std::unique_ptr<FieldTransform> m_fieldTransform;
 
     // if possible, select robots from this camera
     int m_desiredRobotCamera = -1;
 
+    // the world states are assembled every frame
+    StatusArenaPool m_statusPool;
+
     // differences between tracker and speedtracker
     const bool m_robotsOnly;
     const qint64 m_resetTimeout;
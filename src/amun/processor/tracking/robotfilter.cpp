@@ -20,8 +20,11 @@
 
 #include "robotfilter.h"
 #include "core/timer.h"
+#include <algorithm>
 
 const qint64 PROCESSOR_TICK_DURATION = 10 * 1000 * 1000;
+// how late a frame of a slower camera may be to still be fused at its capture time
+const qint64 MAX_REORDER_TIME = 100 * 1000 * 1000;
 const float MAX_LINEAR_ACCELERATION = 10.;
 const float MAX_ROTATION_ACCELERATION = 60.;
 const float OMEGA_MAX = 10 * 2 * M_PI;
@@ -67,8 +70,9 @@ void RobotFilter::resetFutureKalman()
 }
 
 // updates the filter to the best possible prediction for the given time
-// vision frames are applies permanently that is their timestamps must
-// increase monotonically. The same is true for the robot speed estimates,
+// vision frames are applies permanently in the order of their timestamps,
+// late frames rewind the filter using the history (see addVisionFrame).
+// The same is true for the robot speed estimates,
 // with the exception that these are only applied temporarily if they are
 // newer than the newest vision frame
 void RobotFilter::update(qint64 time)
@@ -81,6 +85,8 @@ void RobotFilter::update(qint64 time)
             break;
         }
 
+        m_history.push_back({m_kalman, m_lastTime, m_lastRadioCommand, m_primaryCamera, m_lastPrimaryTime, frame, {}});
+
         // only apply radio commands that have reached the robot yet
         foreach (const RadioCommand &command, m_radioCommands) {
             const qint64 commandTime = command.second;
@@ -90,7 +96,7 @@ void RobotFilter::update(qint64 time)
             predict(commandTime, false, true, false, m_lastRadioCommand);
             m_lastRadioCommand = command;
         }
-        invalidateRobotCommand(frame.time);
+        invalidateRobotCommand(frame.time, m_history.back().radioCommands);
 
         predict(frame.time, false, true, frame.switchCamera, m_lastRadioCommand);
         applyVisionFrame(frame);
@@ -98,6 +104,9 @@ void RobotFilter::update(qint64 time)
         isVisionUpdated = true;
         m_visionFrames.removeFirst();
     }
+    while (!m_history.empty() && m_history.front().frame.time < m_lastTime - MAX_REORDER_TIME) {
+        m_history.pop_front();
+    }
     if (isVisionUpdated || time < m_futureTime) {
         // prediction is rebased on latest vision frame
         resetFutureKalman();
@@ -118,11 +127,11 @@ void RobotFilter::update(qint64 time)
         }
     }
 
-    // predict to requested timestep
-    predict(time, true, false, false, m_futureRadioCommand);
+    // predict to requested timestep, the vision state may already be newer after late frames
+    predict(std::max(time, m_futureTime), true, false, false, m_futureRadioCommand);
 }
 
-void RobotFilter::invalidateRobotCommand(qint64 time)
+void RobotFilter::invalidateRobotCommand(qint64 time, QList<RadioCommand> &consumed)
 {
     // cleanup outdated radio commands
     while (!m_radioCommands.isEmpty()) {
@@ -130,10 +139,41 @@ void RobotFilter::invalidateRobotCommand(qint64 time)
         if (command.second > time) {
             break;
         }
+        consumed.append(command);
         m_radioCommands.removeFirst();
     }
 }
 
+// restores the state before the first applied frame that is newer than time and queues
+// that frame and all following ones again. Returns false if the history does not reach back far enough
+bool RobotFilter::rewindTo(qint64 time)
+{
+    const auto it = std::find_if(m_history.begin(), m_history.end(), [time](const HistoryEntry &entry) {
+        return entry.frame.time > time;
+    });
+    if (it == m_history.end() || it->lastTime > time) {
+        return false;
+    }
+    const std::size_t index = it - m_history.begin();
+    m_kalman = it->kalman;
+    m_lastTime = it->lastTime;
+    m_lastRadioCommand = it->lastRadioCommand;
+    m_primaryCamera = it->primaryCamera;
+    m_lastPrimaryTime = it->lastPrimaryTime;
+
+    // the newest entry is queued first, as everything is prepended
+    while (m_history.size() > index) {
+        HistoryEntry &entry = m_history.back();
+        for (int i = entry.radioCommands.size() - 1; i >= 0; i--) {
+            m_radioCommands.prepend(entry.radioCommands[i]);
+        }
+        entry.frame.replayed = true;
+        m_visionFrames.prepend(entry.frame);
+        m_history.pop_back();
+    }
+    return true;
+}
+
 void RobotFilter::predict(qint64 time, bool updateFuture, bool permanentUpdate, bool cameraSwitched, const RadioCommand &cmd)
 {
     // just assume that the prediction step is the same for now and the future
@@ -280,7 +320,7 @@ void RobotFilter::applyVisionFrame(const VisionFrame &frame)
     // prevent discontinuities
     float diff = limitAngle(rot - pRotLimited);
 
-    // keep for debugging
+    // keep for debugging, replayed frames were already reported
     world::RobotPosition p;
     p.set_time(frame.time);
     p.set_p_x(-frame.detection.y() / 1000.0);
@@ -288,7 +328,9 @@ void RobotFilter::applyVisionFrame(const VisionFrame &frame)
     p.set_phi(pRotLimited + diff);
     p.set_camera_id(frame.cameraId);
     p.set_vision_processing_time(frame.visionProcessingTime);
-    m_measurements.append(p);
+    if (!frame.replayed) {
+        m_measurements.append(p);
+    }
 
     m_kalman->z(0) = p.p_x();
     m_kalman->z(1) = p.p_y();
@@ -389,7 +431,15 @@ float RobotFilter::distanceTo(const SSL_DetectionRobot &robot) const
 
 void RobotFilter::addVisionFrame(qint32 cameraId, const SSL_DetectionRobot &robot, qint64 time, qint64 visionProcessingTime, bool switchCamera)
 {
-    m_visionFrames.append(VisionFrame(cameraId, robot, time, visionProcessingTime, switchCamera));
+    // frames of slower cameras may be older than the current state,
+    // these are fused at their capture time if possible and dropped otherwise
+    if (time < m_lastTime && !rewindTo(time)) {
+        return;
+    }
+    const auto it = std::upper_bound(m_visionFrames.begin(), m_visionFrames.end(), time, [](qint64 t, const VisionFrame &frame) {
+        return t < frame.time;
+    });
+    m_visionFrames.insert(it, VisionFrame(cameraId, robot, time, visionProcessingTime, switchCamera));
     // only count frames for the primary camera
     if (m_primaryCamera == -1 || m_primaryCamera == cameraId) {
         m_frameCounter++;
@@ -30,6 +30,7 @@
 #include <QList>
 #include <QMap>
 #include <QPair>
+#include <deque>
 
 class SSL_DetectionRobot;
 
@@ -71,14 +72,17 @@ private:
         qint64 time;
         qint64 visionProcessingTime;
         bool switchCamera;
+        // set for frames that are applied again after an out of sequence frame
+        bool replayed = false;
     };
     typedef QPair<robot::Command, qint64> RadioCommand;
     typedef KalmanFilter<6, 3> Kalman;
 
     void resetFutureKalman();
+    bool rewindTo(qint64 time);
     void predict(qint64 time, bool updateFuture, bool permanentUpdate, bool cameraSwitched, const RadioCommand &cmd);
     void applyVisionFrame(const VisionFrame &frame);
-    void invalidateRobotCommand(qint64 time);
+    void invalidateRobotCommand(qint64 time, QList<RadioCommand> &consumed);
     double limitAngle(double angle) const;
 
     static Kalman::Vector observationFromDetection(const SSL_DetectionRobot &robot);
@@ -114,6 +118,21 @@ private:
     RadioCommand m_futureRadioCommand;
     QList<VisionFrame> m_visionFrames;
     QList<RadioCommand> m_radioCommands;
+
+    // filter state before each applied vision frame, allows fusing
+    // frames of slower cameras at their capture time
+    struct HistoryEntry
+    {
+        KalmanHolder kalman;
+        qint64 lastTime;
+        RadioCommand lastRadioCommand;
+        qint32 primaryCamera;
+        qint64 lastPrimaryTime;
+        VisionFrame frame;
+        // radio commands that were used while predicting to the frame
+        QList<RadioCommand> radioCommands;
+    };
+    std::deque<HistoryEntry> m_history;
 };
 
 #endif // ROBOTFILTER_H
@@ -0,0 +1,235 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "systemdelayestimator.h"
+#include <algorithm>
+#include <cmath>
+
+static const qint64 UPDATE_INTERVAL = 1000 * 1000 * 1000;
+// commands older than this are no longer executed by the robot
+static const qint64 COMMAND_TIMEOUT = 100 * 1000 * 1000;
+static const qint64 MIN_DETECTION_INTERVAL = 5 * 1000 * 1000;
+static const qint64 MAX_DETECTION_INTERVAL = 50 * 1000 * 1000;
+// larger values are caused by mismatched detections
+static const float MAX_SPEED = 10.0f;
+static const float MAX_OMEGA = 30.0f;
+static const double MIN_SAMPLES = 200;
+// weight of the previous samples after each update
+static const double DECAY = 0.8;
+
+void SystemDelayEstimator::Correlation::add(double a, double b)
+{
+    n += 1;
+    x += a;
+    y += b;
+    xx += a * a;
+    yy += b * b;
+    xy += a * b;
+}
+
+void SystemDelayEstimator::Correlation::scale(double factor)
+{
+    n *= factor;
+    x *= factor;
+    y *= factor;
+    xx *= factor;
+    yy *= factor;
+    xy *= factor;
+}
+
+bool SystemDelayEstimator::Correlation::coefficient(double &r) const
+{
+    if (n < MIN_SAMPLES) {
+        return false;
+    }
+    const double varX = n * xx - x * x;
+    const double varY = n * yy - y * y;
+    if (varX <= 1E-9 * n * n || varY <= 1E-9 * n * n) {
+        return false;
+    }
+    r = (n * xy - x * y) / std::sqrt(varX * varY);
+    return true;
+}
+
+SystemDelayEstimator::SystemDelayEstimator()
+{
+    reset();
+}
+
+void SystemDelayEstimator::reset()
+{
+    m_commands.clear();
+    m_detections.clear();
+    m_speed.fill(Correlation());
+    m_omega.fill(Correlation());
+    m_lastUpdate = 0;
+    m_hasEstimate = false;
+    m_delay = 0;
+    m_confidence = 0;
+}
+
+void SystemDelayEstimator::addCommand(bool isBlue, uint id, const robot::Command &command, qint64 time)
+{
+    QList<CommandSample> &commands = m_commands[(isBlue ? 0x100 : 0) | id];
+    if (!commands.isEmpty() && commands.last().time > time) {
+        return;
+    }
+
+    CommandSample sample;
+    sample.time = time;
+    if (command.has_output1()) {
+        sample.speed = std::hypot(command.output1().v_f(), command.output1().v_s());
+        sample.omega = std::abs(command.output1().omega());
+    } else {
+        sample.speed = std::hypot(command.v_f(), command.v_s());
+        sample.omega = std::abs(command.omega());
+    }
+    commands.append(sample);
+
+    // keep enough history to look up the largest lag
+    const qint64 keepAfter = time - LAG_COUNT * LAG_STEP - MAX_DETECTION_INTERVAL - COMMAND_TIMEOUT;
+    while (commands.size() > 1 && commands[1].time < keepAfter) {
+        commands.removeFirst();
+    }
+}
+
+const SystemDelayEstimator::CommandSample *SystemDelayEstimator::commandAt(const QList<CommandSample> &commands, qint64 time) const
+{
+    // the command which was active at the given time
+    auto it = std::upper_bound(commands.begin(), commands.end(), time,
+                               [](qint64 t, const CommandSample &c) { return t < c.time; });
+    if (it == commands.begin()) {
+        return nullptr;
+    }
+    --it;
+    if (time - it->time > COMMAND_TIMEOUT) {
+        return nullptr;
+    }
+    return &*it;
+}
+
+void SystemDelayEstimator::addDetection(bool isBlue, uint id, qint32 cameraId, float x, float y, float phi,
+                                        qint64 receiveTime, qint64 visionLatency)
+{
+    const qint64 captureTime = receiveTime - visionLatency;
+    const int robotKey = (isBlue ? 0x100 : 0) | id;
+    // speeds are only calculated between detections from the same camera
+    const qint64 key = (qint64(robotKey) << 32) | quint32(cameraId);
+    auto last = m_detections.find(key);
+    if (last == m_detections.end()) {
+        m_detections.insert(key, Detection{captureTime, x, y, phi});
+        return;
+    }
+    const Detection previous = *last;
+    *last = Detection{captureTime, x, y, phi};
+
+    const qint64 interval = captureTime - previous.time;
+    if (interval < MIN_DETECTION_INTERVAL || interval > MAX_DETECTION_INTERVAL) {
+        return;
+    }
+    auto commands = m_commands.constFind(robotKey);
+    if (commands == m_commands.constEnd()) {
+        return;
+    }
+
+    const float dt = interval * 1E-9f;
+    // vision positions are in millimeters
+    const float speed = std::hypot(x - previous.x, y - previous.y) / 1000.0f / dt;
+    const float omega = std::abs(std::remainder(phi - previous.phi, float(2 * M_PI))) / dt;
+    if (speed > MAX_SPEED || omega > MAX_OMEGA) {
+        return;
+    }
+
+    // the speed is the average over the detection interval
+    const qint64 sampleTime = previous.time + interval / 2;
+    std::array<const CommandSample *, LAG_COUNT> lagged;
+    for (int lag = 0; lag < LAG_COUNT; lag++) {
+        lagged[lag] = commandAt(*commands, sampleTime - lag * LAG_STEP);
+        // use the same samples for every lag, otherwise the correlations are not comparable
+        if (!lagged[lag]) {
+            return;
+        }
+    }
+    for (int lag = 0; lag < LAG_COUNT; lag++) {
+        m_speed[lag].add(lagged[lag]->speed, speed);
+        m_omega[lag].add(lagged[lag]->omega, omega);
+    }
+}
+
+bool SystemDelayEstimator::score(int lag, double &score) const
+{
+    double speed, omega;
+    const bool hasSpeed = m_speed[lag].coefficient(speed);
+    const bool hasOmega = m_omega[lag].coefficient(omega);
+    if (hasSpeed && hasOmega) {
+        score = (speed + omega) / 2;
+    } else if (hasSpeed) {
+        score = speed;
+    } else if (hasOmega) {
+        score = omega;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void SystemDelayEstimator::update(qint64 time)
+{
+    if (time - m_lastUpdate < UPDATE_INTERVAL && time >= m_lastUpdate) {
+        return;
+    }
+    m_lastUpdate = time;
+
+    std::array<double, LAG_COUNT> scores;
+    int best = -1;
+    for (int lag = 0; lag < LAG_COUNT; lag++) {
+        if (!score(lag, scores[lag])) {
+            // all lags share the same samples, so either all or none are valid
+            // unless one lag happens to have no variance
+            scores[lag] = -1;
+            continue;
+        }
+        if (best < 0 || scores[lag] > scores[best]) {
+            best = lag;
+        }
+    }
+
+    if (best >= 0 && scores[best] > 0) {
+        // refine the peak using a parabola through the neighbouring lags
+        double offset = 0;
+        if (best > 0 && best < LAG_COUNT - 1) {
+            const double left = scores[best - 1];
+            const double right = scores[best + 1];
+            const double curvature = left - 2 * scores[best] + right;
+            if (curvature < 0) {
+                offset = qBound(-0.5, 0.5 * (left - right) / curvature, 0.5);
+            }
+        }
+        m_hasEstimate = true;
+        m_delay = qint64((best + offset) * LAG_STEP);
+        m_confidence = scores[best];
+    }
+
+    // forget old samples to follow changes of the delay
+    for (int lag = 0; lag < LAG_COUNT; lag++) {
+        m_speed[lag].scale(DECAY);
+        m_omega[lag].scale(DECAY);
+    }
+}
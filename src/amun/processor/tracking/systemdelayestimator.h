@@ -0,0 +1,98 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef SYSTEMDELAYESTIMATOR_H
+#define SYSTEMDELAYESTIMATOR_H
+
+#include "protobuf/robot.pb.h"
+#include <QList>
+#include <QMap>
+#include <array>
+
+// Estimates the delay between sending a radio command and the resulting robot
+// motion as seen by the vision, by correlating the commanded speeds with the
+// speeds observed in the raw detections for a range of candidate delays.
+// Only speed magnitudes are compared, which makes the estimate independent
+// of the robot orientation and of the field transform.
+class SystemDelayEstimator
+{
+public:
+    SystemDelayEstimator();
+
+    void addCommand(bool isBlue, uint id, const robot::Command &command, qint64 time);
+    // visionLatency is the time between capturing and receiving the frame, it is
+    // already compensated separately and thus not part of the system delay
+    void addDetection(bool isBlue, uint id, qint32 cameraId, float x, float y, float phi,
+                      qint64 receiveTime, qint64 visionLatency);
+    // recomputes the estimate at most once per update interval
+    void update(qint64 time);
+    void reset();
+
+    bool hasEstimate() const { return m_hasEstimate; }
+    qint64 delay() const { return m_delay; }
+    // peak correlation between commanded and observed speed, between 0 and 1
+    float confidence() const { return m_confidence; }
+
+private:
+    struct CommandSample {
+        qint64 time;
+        float speed;
+        float omega;
+    };
+
+    struct Detection {
+        qint64 time;
+        float x;
+        float y;
+        float phi;
+    };
+
+    struct Correlation {
+        double n = 0;
+        double x = 0;
+        double y = 0;
+        double xx = 0;
+        double yy = 0;
+        double xy = 0;
+
+        void add(double a, double b);
+        void scale(double factor);
+        // returns false if there are too few samples or no variation
+        bool coefficient(double &r) const;
+    };
+
+    static constexpr int LAG_COUNT = 81;
+    static constexpr qint64 LAG_STEP = 2500 * 1000; // 2.5ms, up to 200ms
+
+    const CommandSample *commandAt(const QList<CommandSample> &commands, qint64 time) const;
+    bool score(int lag, double &score) const;
+
+    QMap<int, QList<CommandSample>> m_commands; // indexed by team and robot id
+    QMap<qint64, Detection> m_detections; // indexed by team, robot id and camera id
+    std::array<Correlation, LAG_COUNT> m_speed;
+    std::array<Correlation, LAG_COUNT> m_omega;
+
+    qint64 m_lastUpdate;
+    bool m_hasEstimate;
+    qint64 m_delay;
+    float m_confidence;
+};
+
+#endif // SYSTEMDELAYESTIMATOR_H
@@ -22,16 +22,26 @@
 #include "balltracker.h"
 #include "protobuf/ssl_wrapper.pb.h"
 #include "robotfilter.h"
+#include "systemdelayestimator.h"
 #include "protobuf/debug.pb.h"
 #include "protobuf/geometry.h"
+#include "protobuf/visionframes.h"
 #include "core/fieldtransform.h"
+#include "core/timer.h"
 #include <QDebug>
+#include <algorithm>
 #include <iostream>
 #include <limits>
 
+// below this the estimated system delay is not applied automatically
+static const float MIN_SYSTEM_DELAY_CONFIDENCE = 0.5f;
+
 Tracker::Tracker(bool robotsOnly, bool isSpeedTracker) :
     m_cameraInfo(new CameraInfo),
     m_systemDelay(0),
+    m_configuredSystemDelay(0),
+    m_systemDelayAuto(false),
+    m_delayEstimator(new SystemDelayEstimator),
     m_timeSinceLastReset(0),
     m_geometryUpdated(false),
     m_hasVisionData(false),
@@ -82,6 +92,7 @@ void Tracker::reset()
 
     qDeleteAll(m_ballFilter);
     m_ballFilter.clear();
+    m_ballCandidates.clear();
 
     m_hasVisionData = false;
     m_timeSinceLastReset = 0;
@@ -90,6 +101,7 @@ void Tracker::reset()
     m_cameraInfo->cameraPosition.clear();
     m_cameraInfo->focalLength.clear();
     m_cameraInfo->cameraSender.clear();
+    m_delayEstimator->reset();
 }
 
 void Tracker::setFlip(bool flip)
@@ -125,7 +137,7 @@ void Tracker::process(qint64 currentTime)
         }
 
         if (!m_robotsOnly) {
-            m_detectionWrappers.append({wrapper, p.time});
+            m_detectionWrappers.append({p.data, p.time});
         }
 
         if (!wrapper.has_detection()) {
@@ -180,7 +192,8 @@ void Tracker::process(qint64 currentTime)
             break;
         }
 
-        // drop frames older than the current state
+        // frames of one camera arrive in order, so only duplicates are dropped here.
+        // Frames of other cameras may still be older, the filters fuse them at their capture time
         if (sourceTime <= m_lastUpdateTime[detection.camera_id()]) {
             continue;
         }
@@ -193,8 +206,23 @@ void Tracker::process(qint64 currentTime)
             trackRobot(m_robotFilterBlue, detection.robots_blue(i), sourceTime, detection.camera_id(), visionProcessingTime, false);
         }
 
+        auto addToDelayEstimator = [this, &detection, &p, visionProcessingTime](const SSL_DetectionRobot &robot, bool isBlue) {
+            if (robot.has_robot_id() && robot.has_orientation()) {
+                m_delayEstimator->addDetection(isBlue, robot.robot_id(), detection.camera_id(),
+                                               robot.x(), robot.y(), robot.orientation(), p.time, visionProcessingTime);
+            }
+        };
+        for (const SSL_DetectionRobot &robot : detection.robots_yellow()) {
+            addToDelayEstimator(robot, false);
+        }
+        for (const SSL_DetectionRobot &robot : detection.robots_blue()) {
+            addToDelayEstimator(robot, true);
+        }
+
         if (!m_robotsOnly) {
+            const qint64 ballTrackingStart = Timer::systemTime();
             trackBallDetections(detection, sourceTime, visionProcessingTime);
+            m_ballTrackingTime += Timer::systemTime() - ballTrackingStart;
 
             for (BallTracker * filter : m_ballFilter) {
                 filter->updateConfidence();
@@ -204,6 +232,25 @@ void Tracker::process(qint64 currentTime)
         m_lastUpdateTime[detection.camera_id()] = sourceTime;
     }
     m_visionPackets.clear();
+
+    m_delayEstimator->update(currentTime);
+    if (m_systemDelayAuto) {
+        qint64 estimatedDelay;
+        float confidence;
+        const bool isReliable = systemDelayEstimate(estimatedDelay, confidence)
+                && confidence >= MIN_SYSTEM_DELAY_CONFIDENCE;
+        m_systemDelay = isReliable ? estimatedDelay : m_configuredSystemDelay;
+    }
+}
+
+bool Tracker::systemDelayEstimate(qint64 &delay, float &confidence) const
+{
+    if (!m_delayEstimator->hasEstimate()) {
+        return false;
+    }
+    delay = m_delayEstimator->delay();
+    confidence = m_delayEstimator->confidence();
+    return true;
 }
 
 static RobotFilter* bestFilter(QList<RobotFilter*> &filters, int minFrameCount, int desiredCamera)
@@ -296,7 +343,7 @@ Status Tracker::worldState(qint64 currentTime, bool resetRaw)
     const int minFrameCount = (currentTime > m_timeSinceLastReset + m_resetTimeout) ? 5: 0;
 
     // create world state for the given time
-    Status status(new amun::Status);
+    Status status = m_statusPool.createStatus();
     world::State *worldState = status->mutable_world_state();
     worldState->set_time(currentTime);
     worldState->set_has_vision_data(m_hasVisionData);
@@ -330,9 +377,8 @@ Status Tracker::worldState(qint64 currentTime, bool resetRaw)
     }
 
     if (!m_robotsOnly) {
-        for (auto &data : m_detectionWrappers) {
-            worldState->add_vision_frames()->CopyFrom(data.first);
-            worldState->add_vision_frame_times(data.second);
+        for (const auto &data : m_detectionWrappers) {
+            addVisionFrame(worldState, data.first, data.second);
         }
         m_detectionWrappers.clear();
 
@@ -375,6 +421,24 @@ Status Tracker::worldState(qint64 currentTime, bool resetRaw)
         filter->clearDebugValues();
     }
 #endif
+    if (!m_robotsOnly) {
+        // cheap enough to always report, shows the load caused by noisy ball detections
+        amun::DebugValue *hypotheses = mutable_debug(&debug, status)->add_value();
+        hypotheses->set_key("ball hypotheses");
+        hypotheses->set_float_value(m_ballFilter.size());
+        amun::DebugValue *candidates = debug->add_value();
+        candidates->set_key("ball candidates");
+        candidates->set_float_value(m_ballCandidates.size());
+        amun::DebugValue *flyFilters = debug->add_value();
+        flyFilters->set_key("ball fly filters");
+        flyFilters->set_float_value(std::count_if(m_ballFilter.begin(), m_ballFilter.end(), [](const BallTracker *filter) {
+            return filter->hasFlyFilter();
+        }));
+        amun::DebugValue *trackingTime = debug->add_value();
+        trackingTime->set_key("ball tracking time");
+        trackingTime->set_float_value(m_ballTrackingTime * 1E-6);
+    }
+    m_ballTrackingTime = 0;
     if (m_errorMessages.size() > 0 && !m_robotsOnly) {
         for (const QString &message : m_errorMessages) {
             amun::StatusLog *log = mutable_debug(&debug, status)->add_log();
@@ -586,6 +650,12 @@ void Tracker::trackBallDetections(const SSL_DetectionFrame &frame, qint64 receiv
         }
     }
 
+    // forget unconfirmed detections after a few frames
+    const qint64 CANDIDATE_TIMEOUT = 50*1000*1000;
+    m_ballCandidates.erase(std::remove_if(m_ballCandidates.begin(), m_ballCandidates.end(), [receiveTime](const VisionFrame &candidate) {
+        return candidate.time + CANDIDATE_TIMEOUT < receiveTime;
+    }), m_ballCandidates.end());
+
     if (ballFrames.empty()) {
         return;
     }
@@ -613,15 +683,50 @@ void Tracker::trackBallDetections(const SSL_DetectionFrame &frame, qint64 receiv
         }
     }
 
+    const float MAX_CANDIDATE_SPEED = 10; // m/s
+    const float MAX_CANDIDATE_NOISE = 0.05;
+    const std::size_t MAX_BALL_CANDIDATES = 32;
+
     for (std::size_t i = 0;i<ballFrames.size();i++) {
         if (!acceptingFilterWithCamId[i]) {
             BallTracker* bt;
             if (acceptingFilterWithOtherCamId[i] != nullptr) {
+                if (!makeRoomForBallFilter(acceptingFilterWithOtherCamId)) {
+                    continue;
+                }
                 // copy filter from old camera
                 bt = new BallTracker(*acceptingFilterWithOtherCamId[i], cameraId);
             } else {
+                // most single detections are noise, only allocate a filter
+                // once a detection is confirmed by an earlier one close enough to it
+                const VisionFrame &ballFrame = ballFrames[i];
+                auto candidate = m_ballCandidates.end();
+                float candidateDist = std::numeric_limits<float>::max();
+                for (auto it = m_ballCandidates.begin(); it != m_ballCandidates.end(); ++it) {
+                    if (it->time >= ballFrame.time) {
+                        continue;
+                    }
+                    const float dist = (Eigen::Vector2f(it->x, it->y) - Eigen::Vector2f(ballFrame.x, ballFrame.y)).norm();
+                    const float maxDist = MAX_CANDIDATE_SPEED * (ballFrame.time - it->time) * 1E-9f + MAX_CANDIDATE_NOISE;
+                    if (dist < maxDist && dist < candidateDist) {
+                        candidate = it;
+                        candidateDist = dist;
+                    }
+                }
+                if (candidate == m_ballCandidates.end()) {
+                    if (m_ballCandidates.size() >= MAX_BALL_CANDIDATES) {
+                        m_ballCandidates.erase(m_ballCandidates.begin());
+                    }
+                    m_ballCandidates.push_back(ballFrame);
+                    continue;
+                }
+                if (!makeRoomForBallFilter(acceptingFilterWithOtherCamId)) {
+                    continue;
+                }
                 // create new Ball Filter without initial movement
-                bt = new BallTracker(ballFrames[i], m_cameraInfo, *m_fieldTransform, m_ballModel);
+                bt = new BallTracker(*candidate, m_cameraInfo, *m_fieldTransform, m_ballModel);
+                bt->addVisionFrame(*candidate);
+                m_ballCandidates.erase(candidate);
             }
             m_ballFilter.append(bt);
             bt->addVisionFrame(ballFrames[i]);
@@ -634,6 +739,34 @@ void Tracker::trackBallDetections(const SSL_DetectionFrame &frame, qint64 receiv
     }
 }
 
+bool Tracker::makeRoomForBallFilter(const std::vector<BallTracker*> &keep)
+{
+    // bounds the per frame cost of the ball tracking with noisy vision data
+    const int MAX_BALL_FILTERS = 16;
+    const int MIN_ESTABLISHED_FRAMES = 3;
+
+    if (m_ballFilter.size() < MAX_BALL_FILTERS) {
+        return true;
+    }
+    BallTracker *weakest = nullptr;
+    for (BallTracker *filter : m_ballFilter) {
+        if (filter == m_currentBallFilter || filter->frameCounter() >= MIN_ESTABLISHED_FRAMES
+                || std::find(keep.begin(), keep.end(), filter) != keep.end()) {
+            continue;
+        }
+        if (weakest == nullptr || filter->frameCounter() < weakest->frameCounter()
+                || (filter->frameCounter() == weakest->frameCounter() && filter->confidence() < weakest->confidence())) {
+            weakest = filter;
+        }
+    }
+    if (weakest == nullptr) {
+        return false;
+    }
+    m_ballFilter.removeOne(weakest);
+    delete weakest;
+    return true;
+}
+
 void Tracker::trackRobot(RobotMap &robotMap, const SSL_DetectionRobot &robot, qint64 receiveTime, qint32 cameraId,
                          qint64 visionProcessingDelay, bool teamIsYellow)
 {
@@ -645,58 +778,38 @@ void Tracker::trackRobot(RobotMap &robotMap, const SSL_DetectionRobot &robot, qi
         return;
     }
 
-    // Keep one robot filter per camera in which a robot is visible
-    // Every filter gets the data from every camera (if the position matches),
-    // but the primary camera for each filter is still important if the camera calibration is bad
+    // Keep a single filter per robot which fuses the detections of all cameras.
+    // Detections of the primary camera are trusted more (see RobotFilter::applyVisionFrame),
+    // as camera calibrations may be slightly off relative to each other.
+    // Additional filters for the same id are only kept while the association is ambiguous,
+    // that is if a detection is too far away from every existing filter
 
     const float MAX_DISTANCE = 0.5;
     const qint64 PRIMARY_TIMEOUT = 42*1000*1000;
 
-    std::map<qint32, std::pair<float, RobotFilter*>> nearestFilterByCamera;
-    RobotFilter *totalClosest = nullptr;
-    float totalClosestDist = MAX_DISTANCE;
+    RobotFilter *closest = nullptr;
+    float closestDist = MAX_DISTANCE;
 
     QList<RobotFilter*>& list = robotMap[robot.robot_id()];
     for (RobotFilter *filter : list) {
         filter->update(receiveTime);
         const float dist = filter->distanceTo(robot);
-        if (dist > MAX_DISTANCE) {
-            continue;
-        }
-        const bool isYoung = receiveTime - filter->lastPrimaryTime() > PRIMARY_TIMEOUT;
-        if (static_cast<qint32>(filter->primaryCamera()) != cameraId && isYoung) {
-            continue;
-        }
-
-        if (dist < totalClosestDist) {
-            totalClosestDist = dist;
-            totalClosest = filter;
-        }
-
-        const auto f = nearestFilterByCamera.find(filter->primaryCamera());
-        if (f == nearestFilterByCamera.end() || dist < f->first) {
-            nearestFilterByCamera[filter->primaryCamera()] = {dist, filter};
+        if (dist < closestDist) {
+            closestDist = dist;
+            closest = filter;
         }
     }
 
-    if (!totalClosest) {
-        totalClosest = new RobotFilter(robot, receiveTime, teamIsYellow);
-        list.append(totalClosest);
-        nearestFilterByCamera[cameraId] = {totalClosestDist, totalClosest};
+    if (!closest) {
+        closest = new RobotFilter(robot, receiveTime, teamIsYellow);
+        list.append(closest);
     }
 
-    const auto ownCamera = nearestFilterByCamera.find(cameraId);
-    const bool createOwnCameraFilter = ownCamera == nearestFilterByCamera.end();
-    if (createOwnCameraFilter) {
-        RobotFilter *filter = new RobotFilter(*totalClosest);
-        list.append(filter);
-        nearestFilterByCamera[cameraId] = {totalClosestDist, filter};
-    }
-
-    for (const auto &[id, data] : nearestFilterByCamera) {
-        RobotFilter *filter = data.second;
-        filter->addVisionFrame(cameraId, robot, receiveTime, visionProcessingDelay, id == cameraId && createOwnCameraFilter);
-    }
+    // hand the filter over to another camera once the primary one lost the robot
+    const qint32 primaryCamera = static_cast<qint32>(closest->primaryCamera());
+    const bool switchCamera = primaryCamera != -1 && primaryCamera != cameraId
+            && receiveTime - closest->lastPrimaryTime() > PRIMARY_TIMEOUT;
+    closest->addVisionFrame(cameraId, robot, receiveTime, visionProcessingDelay, switchCamera);
 }
 
 void Tracker::queuePacket(const QByteArray &packet, qint64 time, QString sender)
@@ -713,6 +826,8 @@ void Tracker::queueRadioCommands(const QList<robot::RadioCommand> &radio_command
             continue;
         }
 
+        m_delayEstimator->addCommand(radioCommand.is_blue(), radioCommand.id(), radioCommand.command(), time);
+
         // add radio responses to every available filter
         const RobotMap &teamMap = radioCommand.is_blue() ? m_robotFilterBlue : m_robotFilterYellow;
         const QList<RobotFilter*>& list = teamMap.value(radioCommand.id());
@@ -735,8 +850,18 @@ void Tracker::handleCommand(const amun::CommandTracking &command, qint64 time)
         m_aoi_y2 = command.aoi().y2();
     }
 
+    if (command.has_system_delay_auto()) {
+        m_systemDelayAuto = command.system_delay_auto();
+        if (!m_systemDelayAuto) {
+            m_systemDelay = m_configuredSystemDelay;
+        }
+    }
+
     if (command.has_system_delay()) {
-        m_systemDelay = command.system_delay();
+        m_configuredSystemDelay = command.system_delay();
+        if (!m_systemDelayAuto) {
+            m_systemDelay = m_configuredSystemDelay;
+        }
     }
 
     // allows resetting by the strategy
@@ -21,6 +21,7 @@
 #include "trackingreplay.h"
 #include "core/timer.h"
 #include "core/configuration.h"
+#include "protobuf/visionframes.h"
 
 static const QString SENDER_NAME_FOR_REFEREE = "TrackingReplay";
 
@@ -137,22 +138,15 @@ void TrackingReplay::handleStatus(const Status &status)
             command->mutable_tracking()->set_system_delay(status->world_state().system_delay());
             m_replayProcessor.handleCommand(command);
         }
-        for (int i = 0;i<status->world_state().vision_frames_size();i++) {
-            auto vision = status->world_state().vision_frames(i);
-            QByteArray visionData(vision.ByteSize(), 0);
-            if (vision.SerializeToArray(visionData.data(), visionData.size())) {
-                auto time = status->world_state().time();
-                if (i < status->world_state().vision_frame_times_size()) {
-                    time = status->world_state().vision_frame_times(i);
-                }
-                m_replayProcessor.handleVisionPacket(visionData, time, "replay");
+        const world::State &worldState = status->world_state();
+        for (int i = 0; i < visionFrameCount(worldState); i++) {
+            const QByteArray visionData = visionFrameData(worldState, i);
+            if (!visionData.isEmpty()) {
+                m_replayProcessor.handleVisionPacket(visionData, visionFrameTime(worldState, i), "replay");
             }
         }
         for (const auto &truth : status->world_state().reality()) {
-            QByteArray simulatorData(truth.ByteSize(), 0);
-            if (truth.SerializeToArray(simulatorData.data(), simulatorData.size())) {
-                m_replayProcessor.handleSimulatorExtraVision(simulatorData);
-            }
+            m_replayProcessor.handleSimulatorExtraVision(SimulatorTruth(new world::SimulatorState(truth)));
         }
         m_replayProcessor.process(status->world_state().time());
     }
@@ -21,25 +21,23 @@
 #include "backlogwriter.h"
 #include "logfilewriter.h"
 #include "longlivingstatuscache.h"
+#include "protobuf/visionframes.h"
 #include <QString>
 #include <QByteArray>
 #include <QCoreApplication>
+#include <QTimer>
 
-BacklogStatusSource::BacklogStatusSource(const QContiguousCache<QByteArray> &backlog, const QContiguousCache<qint64> &timings)
-    : m_packets(backlog)
-{
-    m_timings.reserve(timings.size());
-    for (int i = timings.firstIndex();i<=timings.lastIndex();i++) {
-        m_timings.append(timings[i]);
-    }
-}
+BacklogStatusSource::BacklogStatusSource(const QList<QByteArray> &backlog, const QList<qint64> &timings)
+    : m_packets(backlog),
+      m_timings(timings)
+{ }
 
 Status BacklogStatusSource::readStatus(int packet)
 {
     if (packet < 0 || packet >= m_timings.size()) {
         return Status();
     }
-    QByteArray uncompressed = qUncompress(m_packets.at(packet + m_packets.firstIndex()));
+    QByteArray uncompressed = qUncompress(m_packets.at(packet));
     Status status = Status::createArena();
     status->ParseFromArray(uncompressed.data(), uncompressed.size());
     return status;
@@ -53,29 +51,170 @@ void BacklogStatusSource::readPackets(int startPacket, int count)
 }
 
 
-BacklogWriter::BacklogWriter(unsigned seconds) : m_packets(BACKLOG_SIZE_PER_SECOND * seconds), m_timings(BACKLOG_SIZE_PER_SECOND * seconds), m_cache(new LongLivingStatusCache(this))
+static bool isGameStateChange(const amun::GameState &last, const amun::GameState &current)
+{
+    return last.state() != current.state() || last.stage() != current.stage()
+            || last.yellow().score() != current.yellow().score() || last.blue().score() != current.blue().score()
+            || last.yellow().goalie() != current.yellow().goalie() || last.blue().goalie() != current.blue().goalie();
+}
+
+BacklogWriter::BacklogWriter(unsigned seconds, qint64 decimatedBudget) :
+    m_recentLimit(seconds * BACKLOG_SIZE_PER_SECOND),
+    m_decimatedBudget(decimatedBudget),
+    m_decimationTimer(new QTimer(this)),
+    m_cache(new LongLivingStatusCache(this))
 {
     connect(this, SIGNAL(clearData()), this, SLOT(clear()), Qt::QueuedConnection);
+    m_decimationTimer->setSingleShot(true);
+    m_decimationTimer->setInterval(DECIMATION_INTERVAL);
+    connect(m_decimationTimer, &QTimer::timeout, this, &BacklogWriter::decimatePending);
+}
+
+void BacklogWriter::setLength(unsigned seconds, qint64 decimatedBudget)
+{
+    m_recentLimit = seconds * BACKLOG_SIZE_PER_SECOND;
+    m_decimatedBudget = decimatedBudget;
+    trimTiers();
+}
+
+void BacklogWriter::collectPackets(QList<QByteArray> &packets, QList<qint64> *timings) const
+{
+    // the tiers are concatenated in chronological order
+    const int size = m_decimated.size() + m_undecimated.size() + m_recent.size();
+    packets.reserve(size);
+    if (timings) {
+        timings->reserve(size);
+    }
+    for (const QList<Packet> *tier : {&m_decimated, &m_undecimated, &m_recent}) {
+        for (const Packet &packet : *tier) {
+            packets.append(packet.data);
+            if (timings) {
+                timings->append(packet.time);
+            }
+        }
+    }
 }
 
 std::shared_ptr<StatusSource> BacklogWriter::makeStatusSource()
 {
-    return std::shared_ptr<StatusSource>(new BacklogStatusSource(m_packets, m_timings));
+    QList<QByteArray> packets;
+    QList<qint64> timings;
+    collectPackets(packets, &timings);
+    return std::shared_ptr<StatusSource>(new BacklogStatusSource(packets, timings));
 }
 
-void BacklogWriter::handleStatus(const Status &status)
+QByteArray BacklogWriter::compressStatus(const Status &status) const
 {
     QByteArray packetData;
     packetData.resize(status->ByteSize());
     if (status->IsInitialized() && status->SerializeToArray(packetData.data(), packetData.size())) {
-        if (m_packets.isFull()) {
-            Status discarded = packetFromByteArray(m_packets.first());
-            m_cache->handleStatus(discarded);
-        }
         // compress the status to save a lot of memory, but be quick
         // the packets are uncompressed before writing to a logfile
-        m_packets.append(qCompress(packetData, 1));
-        m_timings.append(status->time());
+        return qCompress(packetData, 1);
+    }
+    return QByteArray();
+}
+
+void BacklogWriter::handleStatus(const Status &status)
+{
+    const QByteArray compressed = compressStatus(status);
+    if (compressed.isEmpty()) {
+        return;
+    }
+    m_recent.append(Packet{compressed, status->time()});
+    trimTiers();
+}
+
+void BacklogWriter::trimTiers()
+{
+    while (m_recent.size() > m_recentLimit) {
+        m_undecimated.append(m_recent.takeFirst());
+    }
+    if (!m_undecimated.isEmpty() && !m_decimationTimer->isActive()) {
+        m_decimationTimer->start();
+    }
+    while (m_decimatedBytes > m_decimatedBudget && !m_decimated.isEmpty()) {
+        const Packet packet = m_decimated.takeFirst();
+        m_decimatedBytes -= packet.data.size();
+        m_cache->handleStatus(packetFromByteArray(packet.data));
+    }
+}
+
+void BacklogWriter::decimatePending()
+{
+    m_decimationTimer->stop();
+    for (const Packet &packet : qAsConst(m_undecimated)) {
+        decimate(packet);
+    }
+    m_undecimated.clear();
+    trimTiers();
+}
+
+void BacklogWriter::decimate(const Packet &packet)
+{
+    Status status = packetFromByteArray(packet.data);
+
+    // debug output and data that is only relevant for a single frame is dropped
+    status->clear_debug();
+    status->clear_radio_command();
+    status->clear_timing();
+    status->clear_user_input_blue();
+    status->clear_user_input_yellow();
+    status->clear_execution_state();
+    status->clear_execution_game_state();
+    status->clear_execution_user_input();
+
+    if (status->has_game_state()) {
+        if (m_hasDecimatedGameState && !isGameStateChange(m_lastDecimatedGameState, status->game_state())) {
+            status->clear_game_state();
+        } else {
+            m_lastDecimatedGameState.CopyFrom(status->game_state());
+            m_hasDecimatedGameState = true;
+        }
+    }
+
+    if (status->has_world_state()) {
+        world::State *worldState = status->mutable_world_state();
+        // the field geometry is required to show anything, thus it is never dropped
+        QList<std::pair<QByteArray, qint64>> geometryFrames;
+        for (int i = 0; i < visionFrameCount(*worldState); i++) {
+            if (visionFrameHasGeometry(*worldState, i)) {
+                geometryFrames.append(std::make_pair(visionFrameData(*worldState, i), visionFrameTime(*worldState, i)));
+            }
+        }
+        // a jump back in time restarts the decimation
+        if (worldState->time() < m_lastDecimatedTracking
+                || worldState->time() - m_lastDecimatedTracking >= DECIMATED_TRACKING_INTERVAL) {
+            m_lastDecimatedTracking = worldState->time();
+            worldState->clear_vision_frames();
+            worldState->clear_raw_vision_frames();
+        } else if (!geometryFrames.isEmpty()) {
+            const qint64 worldTime = worldState->time();
+            worldState->Clear();
+            worldState->set_time(worldTime);
+        } else {
+            status->clear_world_state();
+        }
+        if (status->has_world_state()) {
+            for (const auto &frame : geometryFrames) {
+                addVisionFrame(worldState, frame.first, frame.second);
+            }
+        }
+    }
+
+    // skip packets that only contain a timestamp
+    const qint64 time = status->time();
+    status->clear_time();
+    const bool isEmpty = status->ByteSize() == 0;
+    status->set_time(time);
+    if (isEmpty) {
+        return;
+    }
+
+    const QByteArray compressed = compressStatus(status);
+    if (!compressed.isEmpty()) {
+        m_decimated.append(Packet{compressed, packet.time});
+        m_decimatedBytes += compressed.size();
     }
 }
 
@@ -89,20 +228,23 @@ Status BacklogWriter::packetFromByteArray(QByteArray packetData)
 
 void BacklogWriter::saveBacklog(QString filename/*, Status teamStatus*/, bool processEvents)
 {
-    if (m_packets.size() == 0) {
+    decimatePending();
+    if (m_recent.isEmpty() && m_decimated.isEmpty()) {
         return;
     }
     emit enableBacklogSave(false);
     LogFileWriter writer;
+    writer.setArchiveStore(m_archiveStore);
     if (writer.open(filename)) {
         connect(m_cache, &LongLivingStatusCache::sendStatus, &writer, &LogFileWriter::writeStatus);
         m_cache->publish();
         disconnect(m_cache, &LongLivingStatusCache::sendStatus, &writer, &LogFileWriter::writeStatus);
 
-        QContiguousCache<QByteArray> packetCopy = m_packets;
-        packetCopy.normalizeIndexes();
-        for (int i = 0;i<packetCopy.size();i++) {
-            Status status = packetFromByteArray(packetCopy.at(packetCopy.firstIndex() + i));
+        // copy the packets, as processing events may modify the backlog
+        QList<QByteArray> packets;
+        collectPackets(packets, nullptr);
+        for (int i = 0;i<packets.size();i++) {
+            Status status = packetFromByteArray(packets.at(i));
             writer.writeStatus(status);
 
             // process incoming status packages to avoid building up memory
@@ -119,6 +261,11 @@ void BacklogWriter::saveBacklog(QString filename/*, Status teamStatus*/, bool pr
 
 void BacklogWriter::clear()
 {
-    m_packets.clear();
-    m_timings.clear();
+    m_recent.clear();
+    m_undecimated.clear();
+    m_decimationTimer->stop();
+    m_decimated.clear();
+    m_decimatedBytes = 0;
+    m_lastDecimatedTracking = 0;
+    m_hasDecimatedGameState = false;
 }
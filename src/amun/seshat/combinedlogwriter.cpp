@@ -26,6 +26,8 @@
 
 #include <QThread>
 #include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
 #include <QSettings>
 #include <QCoreApplication>
 #include <QVector>
@@ -39,16 +41,21 @@ namespace CombinedLogWriterInternal {
 
     signals:
         void saveBacklogFile(QString filename, bool processEvents);
+        void setBacklogArchiveStore(const QString &store);
+        void setBacklogLength(unsigned seconds, qint64 decimatedBudget);
         void gotStatusForRecording(const Status &status);
         void gotStatusForBacklog(const Status &status);
 
     public:
-        void emitSaveBacklog(QString filename, const Status &status, bool processEvents);
+        void emitSaveBacklog(QString filename, const QString &archiveStore, const Status &status, bool processEvents);
         void emitStatusToRecording(const Status &status);
         void emitStatusToBacklog(const Status &status);
+        void emitBacklogLength(unsigned seconds, qint64 decimatedBudget);
     };
 
-    void SignalSource::emitSaveBacklog(QString filename, const Status &status, bool processEvents) {
+    void SignalSource::emitSaveBacklog(QString filename, const QString &archiveStore, const Status &status, bool processEvents) {
+        // both signals are queued to the backlog thread in order
+        emit setBacklogArchiveStore(archiveStore);
         emit saveBacklogFile(filename, processEvents);
     }
 
@@ -59,6 +66,10 @@ namespace CombinedLogWriterInternal {
     void SignalSource::emitStatusToBacklog(const Status & status) {
         emit gotStatusForBacklog(status);
     }
+
+    void SignalSource::emitBacklogLength(unsigned seconds, qint64 decimatedBudget) {
+        emit setBacklogLength(seconds, decimatedBudget);
+    }
 }
 
 using CombinedLogWriterInternal::SignalSource;
@@ -70,6 +81,8 @@ CombinedLogWriter::CombinedLogWriter(bool replay, int backlogLength) :
     m_logFileThread(NULL),
     m_lastTime(0),
     m_isLoggingEnabled(true),
+    m_backlogLength(backlogLength),
+    m_backlogDecimatedBudget(BacklogWriter::DEFAULT_DECIMATED_BUDGET),
     m_signalSource(new SignalSource(this)),
     m_statusCache(new LongLivingStatusCache(this))
 {
@@ -82,6 +95,8 @@ CombinedLogWriter::CombinedLogWriter(bool replay, int backlogLength) :
 
     connect(m_backlogWriter, SIGNAL(enableBacklogSave(bool)), this, SLOT(enableLogging(bool)));
     connect(m_signalSource, SIGNAL(gotStatusForBacklog(Status)), m_backlogWriter, SLOT(handleStatus(Status)));
+    connect(m_signalSource, &SignalSource::setBacklogArchiveStore, m_backlogWriter, &BacklogWriter::setArchiveStore);
+    connect(m_signalSource, &SignalSource::setBacklogLength, m_backlogWriter, &BacklogWriter::setLength);
     connect(m_signalSource, SIGNAL(saveBacklogFile(QString,bool)), m_backlogWriter, SLOT(saveBacklog(QString,bool)));
     connect(this, SIGNAL(resetBacklog()), m_backlogWriter, SLOT(clear()));
 }
@@ -120,6 +135,8 @@ void CombinedLogWriter::sendBacklogStatus(int lastNPackets)
     // copy the response afterwards in one large UI-Response:
     Status s = Status::createArena();
     amun::UiResponse* response = s->mutable_pure_ui_response();
+    // the string tables might have been sent before the oldest packet
+    response->add_logger_status()->CopyFrom(*m_statusCache->getStringTableStatus());
     {
         int i = 0;
         for (const auto& status: packets) {
@@ -141,6 +158,18 @@ void CombinedLogWriter::handleCommand(Command comm) {
     if (recordCommand.has_use_logfile_location()) {
         useLogfileLocation(recordCommand.use_logfile_location());
     }
+    if (recordCommand.has_use_archive()) {
+        m_useArchive = recordCommand.use_archive();
+    }
+    if (recordCommand.has_backlog_length() || recordCommand.has_backlog_decimated_memory()) {
+        if (recordCommand.has_backlog_length()) {
+            m_backlogLength = recordCommand.backlog_length();
+        }
+        if (recordCommand.has_backlog_decimated_memory()) {
+            m_backlogDecimatedBudget = qint64(recordCommand.backlog_decimated_memory()) * 1024 * 1024;
+        }
+        m_signalSource->emitBacklogLength(m_backlogLength, m_backlogDecimatedBudget);
+    }
     if (recordCommand.has_run_logging() && recordCommand.for_replay() == m_isReplay) {
         QString overwriteFilename;
         if (recordCommand.has_overwrite_record_filename()) {
@@ -239,7 +268,7 @@ void CombinedLogWriter::saveBackLog()
     Status status{getTeamStatus()};
     status->clear_time();
 
-    m_signalSource->emitSaveBacklog(filename, status, true);
+    m_signalSource->emitSaveBacklog(filename, archiveStore(filename), status, true);
 }
 
 QString CombinedLogWriter::dateTimeToString(const QDateTime & dt)
@@ -291,11 +320,25 @@ QString CombinedLogWriter::createLogFilename() const
     }
 }
 
+QString CombinedLogWriter::archiveStore(const QString &filename) const
+{
+    if (!m_useArchive) {
+        return QString();
+    }
+    // all logs in a directory share their store
+    return QFileInfo(filename).dir().filePath(ARCHIVE_DIRECTORY);
+}
+
 Status CombinedLogWriter::getTeamStatus()
 {
     return m_statusCache->getTeamStatus();
 }
 
+Status CombinedLogWriter::getStringTableStatus()
+{
+    return m_statusCache->getStringTableStatus();
+}
+
 void CombinedLogWriter::startLogfile()
 {
     connect(m_statusCache, &LongLivingStatusCache::sendStatus, m_logFile, &LogFileWriter::writeStatus);
@@ -326,6 +369,7 @@ void CombinedLogWriter::recordButtonToggled(bool enabled, QString overwriteFilen
 
         // create log file and forward status
         m_logFile = new LogFileWriter();
+        m_logFile->setArchiveStore(archiveStore(filename));
         if (!m_logFile->open(filename)) {
             delete m_logFile;
             m_logFile = nullptr;
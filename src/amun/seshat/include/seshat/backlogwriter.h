@@ -22,19 +22,21 @@
 #define BACKLOGWRITER_H
 
 #include "protobuf/status.h"
+#include "protobuf/gamestate.pb.h"
 #include "statussource.h"
-#include <QContiguousCache>
+#include <QList>
 #include <QObject>
+#include <QString>
 
-class QString;
 class QByteArray;
+class QTimer;
 class LongLivingStatusCache;
 
 class BacklogStatusSource : public StatusSource
 {
     Q_OBJECT
 public:
-    BacklogStatusSource(const QContiguousCache<QByteArray> &backlog, const QContiguousCache<qint64> &timings);
+    BacklogStatusSource(const QList<QByteArray> &backlog, const QList<qint64> &timings);
     ~BacklogStatusSource() override {}
     bool isOpen() const override { return true; }
 
@@ -48,18 +50,26 @@ public slots:
     void readPackets(int startPacket, int count) override;
 
 private:
-    QContiguousCache<QByteArray> m_packets;
+    QList<QByteArray> m_packets;
     QList<qint64> m_timings;
 };
 
+// The backlog consists of two tiers. The recent tier keeps every status of the configured duration.
+// Packets leaving it are decimated into the old tier, which is limited by the memory used by its
+// compressed packets: debug output is dropped, tracking is only kept at a reduced rate and game state
+// changes are always kept. Packets leaving the old tier are only remembered by the long living status cache.
+
 
 class BacklogWriter : public QObject
 {
     Q_OBJECT
 public:
-    BacklogWriter(unsigned seconds);
+    // decimatedBudget is given in bytes of compressed packets
+    BacklogWriter(unsigned seconds, qint64 decimatedBudget = DEFAULT_DECIMATED_BUDGET);
     std::shared_ptr<StatusSource> makeStatusSource();
 
+    static const qint64 DEFAULT_DECIMATED_BUDGET = 32 * 1024 * 1024;
+
 signals:
     void enableBacklogSave(bool enabled);
     void clearData();
@@ -70,17 +80,46 @@ public slots:
     void clear();
     void handleStatus(const Status &status);
     void saveBacklog(QString filename/*, Status teamStatus*/, bool processEvents);
+    void setLength(unsigned seconds, qint64 decimatedBudget);
+    // saved backlogs are archived into the store if it isn't empty, see LogFileWriter::setArchiveStore
+    void setArchiveStore(const QString &store) { m_archiveStore = store; }
 
 private:
+    struct Packet {
+        QByteArray data;
+        qint64 time;
+    };
+
     Status packetFromByteArray(QByteArray packetData);
+    QByteArray compressStatus(const Status &status) const;
+    void decimate(const Packet &packet);
+    void trimTiers();
+    void decimatePending();
+    void collectPackets(QList<QByteArray> &packets, QList<qint64> *timings) const;
 
 private:
     // approximately, with both strategys running
-    const int BACKLOG_SIZE_PER_SECOND = 570;
+    static const int BACKLOG_SIZE_PER_SECOND = 570;
+    // tracking in the decimated tier is kept at most every 100ms
+    static const qint64 DECIMATED_TRACKING_INTERVAL = 100 * 1000 * 1000;
+    // packets leaving the recent tier are decimated in batches, not for every incoming status
+    static const int DECIMATION_INTERVAL = 1000; // in ms
+
+    QList<Packet> m_recent;
+    // left the recent tier, but not yet decimated
+    QList<Packet> m_undecimated;
+    QList<Packet> m_decimated;
+    qint64 m_decimatedBytes = 0;
+    int m_recentLimit;
+    qint64 m_decimatedBudget;
+    QTimer *m_decimationTimer;
+
+    qint64 m_lastDecimatedTracking = 0;
+    bool m_hasDecimatedGameState = false;
+    amun::GameState m_lastDecimatedGameState;
 
-    QContiguousCache<QByteArray> m_packets;
-    QContiguousCache<qint64> m_timings;
     LongLivingStatusCache *m_cache;
+    QString m_archiveStore;
 
 };
 
@@ -52,6 +52,8 @@ public:
     std::shared_ptr<StatusSource> makeStatusSource();
     void sendBacklogStatus(int lastNPackets);
     Status getTeamStatus();
+    // the complete string tables of the live debug output
+    Status getStringTableStatus();
     static QString dateTimeToString(const QDateTime & dt);
 
 signals:
@@ -65,6 +67,7 @@ public slots:
 
 private:
     QString createLogFilename() const;
+    QString archiveStore(const QString &filename) const;
     void startLogfile();
     void saveBackLog();
     void recordButtonToggled(bool enabled, QString overwriteFilename);
@@ -72,6 +75,8 @@ private:
     void sendIsLogging(bool log);
 
 private:
+    static constexpr const char *ARCHIVE_DIRECTORY = "archive";
+
     enum class LogState {
         PENDING,
         LOGGING,
@@ -79,6 +84,7 @@ private:
     } m_logState;
     const bool m_isReplay;
     bool m_useSettingLocation = false;
+    bool m_useArchive = false;
     BacklogWriter *m_backlogWriter;
     QThread *m_backlogThread;
     LogFileWriter *m_logFile;
@@ -91,6 +97,8 @@ private:
     qint64 m_lastTime;
 
     bool m_isLoggingEnabled;
+    unsigned m_backlogLength;
+    qint64 m_backlogDecimatedBudget;
 
     CombinedLogWriterInternal::SignalSource *m_signalSource;
 
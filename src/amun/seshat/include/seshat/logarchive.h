@@ -0,0 +1,55 @@
+/***************************************************************************
+ *   Copyright 2018 Tobias Heineken                                        *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef LOGARCHIVE_H
+#define LOGARCHIVE_H
+
+#include <QByteArray>
+#include <QString>
+
+// Content addressed storage for the packet groups of archived logs.
+// An archived log is a manifest which references its groups by the hash
+// of their uncompressed content, groups shared by several logs are stored once.
+// The manifest uses version 3 of the log format:
+//   QString "AMUN-RA LOG", int 3, qint32 maximum group size, QString store
+// followed by one entry per group:
+//   qint32 packet count, QByteArray group hash, QByteArray prelude hash, qint64 timestamps[packet count]
+// The group content has the layout of a version 2 group with packet count offsets,
+// the optional prelude is merged into the first packet of the group when reading it.
+// Only stretches of identical packets share their groups. Logs written with different
+// encoding profiles and the decimated part of backlogs don't match the full rate log.
+namespace LogArchive {
+
+    const int VERSION = 3;
+
+    // the store is given relative to the directory containing the manifest
+    QString resolveStore(const QString &manifest, const QString &store);
+    QString relativeStore(const QString &manifest, const QString &store);
+
+    QString objectPath(const QString &store, const QByteArray &hash);
+    // returns the hash of the data, the data is only written if it isn't part of the store yet.
+    // An empty hash is returned if writing failed
+    QByteArray store(const QString &store, const QByteArray &data);
+    // returns an empty array if the object is missing or corrupt
+    QByteArray load(const QString &store, const QByteArray &hash);
+
+}
+
+#endif // LOGARCHIVE_H
@@ -21,6 +21,8 @@
 #ifndef LOGFILEREADER_H
 #define LOGFILEREADER_H
 
+#include "protobuf/compactworldstate.h"
+#include "protobuf/imagevisualization.h"
 #include "protobuf/status.h"
 #include "statussource.h"
 #include "seqlogfilereader.h"
@@ -29,11 +31,10 @@
 #include <QDataStream>
 #include <QFile>
 #include <QList>
+#include <QMutex>
 
 #include <optional>
 
-class QMutex;
-
 class LogFileReader : public StatusSource
 {
     Q_OBJECT
@@ -59,6 +60,7 @@ public:
     // equals timings().size()
     int packetCount() const override { return m_packets.size(); }
     Status readStatus(int packet) override;
+    bool updateIndex() override;
 
     qint32 groupSize() const { return m_reader.groupSize(); }
 
@@ -69,6 +71,7 @@ public slots:
 
 private:
     bool indexFile();
+    bool indexPackets();
     void close();
 
     QString m_errorMsg;
@@ -76,6 +79,15 @@ private:
 
     QList<SeqLogFileReader::Memento> m_packets;
     QList<qint64> m_timings;
+    // where indexing continues once the log has grown
+    std::optional<SeqLogFileReader::Memento> m_indexEnd;
+    // a zero timestamp is only written when the log is closed
+    bool m_logEnded = false;
+    // updateIndex and readStatus are called from different threads
+    QMutex m_indexMutex;
+    int m_lastPacket = -1;
+    CompactWorldStateDecoder m_worldStateDecoder;
+    ImageVisualizationKeyframes m_imageKeyframes;
     bool m_headerCorrect;
     SeqLogFileReader m_reader;
 };
@@ -21,6 +21,9 @@
 #ifndef LOGFILEWRITER_H
 #define LOGFILEWRITER_H
 
+#include "protobuf/compactworldstate.h"
+#include "protobuf/debugstringtable.h"
+#include "protobuf/imagevisualization.h"
 #include "protobuf/status.h"
 #include "logfilehasher.h"
 #include "statussource.h"
@@ -36,6 +39,12 @@ class LogFileWriter : public QObject
 {
     Q_OBJECT
 public:
+    enum class EncodingProfile {
+        Default,
+        // world states are quantized and delta coded, see CompactWorldStateEncoder
+        CompactTracking
+    };
+
     explicit LogFileWriter();
     ~LogFileWriter() override;
     LogFileWriter(const LogFileWriter &) = delete;
@@ -48,6 +57,11 @@ public:
     QString filename() const { return m_file.fileName(); }
     std::shared_ptr<StatusSource> makeStatusSource();
 
+    void setEncodingProfile(EncodingProfile profile) { m_profile = profile; }
+    // writes a manifest referencing content addressed groups in the store, see LogArchive.
+    // Must be set before opening the log, an empty store writes a normal log file
+    void setArchiveStore(const QString &store) { m_archiveStore = store; }
+
     bool hasHash() const { return m_hashState == HashingState::HAS_HASHING; }
     logfile::Uid getHash() const { return m_hashStatus->log_id(); }
 
@@ -57,6 +71,9 @@ public slots:
 private:
     void writePackageEntry(qint64 time, QByteArray &&data);
     void addFirstPackage(qint64 time, QByteArray &&data);
+    void writeArchiveGroup();
+    bool isArchive() const { return !m_archiveStore.isEmpty(); }
+    const QByteArray &stringTableData();
 
     mutable QMutex *m_mutex;
     QFile m_file;
@@ -72,12 +89,29 @@ private:
     };
     HashingState m_hashState = HashingState::UNINITIALIZED;
     Status m_hashStatus = Status(new amun::Status);
+    DebugStringTable m_debugStrings;
+    QByteArray m_stringTableData;
+    EncodingProfile m_profile = EncodingProfile::Default;
+    CompactWorldStateEncoder m_worldStateEncoder;
+    // m_writtenPackages when the last keyframe was written, identifies its group
+    qint64 m_keyframeGroup = -1;
+    ImageVisualizationKeyframes m_imageKeyframes;
+    qint64 m_imageKeyframeGroup = -1;
+    QString m_archiveStore;
+    // string tables for the first packet of the current group
+    QByteArray m_archivePrelude;
 
     const static qint32 GROUPED_PACKAGES = 100;
     static_assert(GROUPED_PACKAGES >= LogFileHasher::HASHED_PACKAGES, "Grouped Packages have to be larger than hashed packages to make sure that the hash is produced before the first group is written to the disc");
     static_assert(LogFileHasher::HASHED_PACKAGES > 2, "Hashing way too few packages can result in unwanted collisions");
 
+    // archived groups end at packets chosen by their timestamp, this makes logs
+    // containing the same packets split them into the same groups
+    const static qint32 MIN_ARCHIVE_GROUP = 20;
+    const static int ARCHIVE_BOUNDARY_BITS = 6;
+
     qint32 m_packageBufferOffsets[GROUPED_PACKAGES];
+    qint64 m_archiveTimeStamps[GROUPED_PACKAGES];
     qint64 m_packageTimeStamps[LogFileHasher::HASHED_PACKAGES-2]; //Only to be used while HashingState::NEEDS_HASHING
 };
 
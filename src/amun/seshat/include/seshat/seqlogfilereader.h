@@ -27,6 +27,7 @@
 #include <QDataStream>
 #include <QFile>
 #include <QList>
+#include <QVector>
 
 class QMutex;
 
@@ -39,6 +40,9 @@ class SeqLogFileReader
 public:
     class Memento
     {
+    public:
+        // index of the packet inside its group, always zero for logs without groups
+        int indexInGroup() const { return groupIndex; }
     private:
         explicit Memento(qint64 base, int index): baseOffset(base), groupIndex(index) {}
         qint64 baseOffset;
@@ -59,24 +63,40 @@ public:
 
     Status readStatus();
     qint64 readTimestamp();
-    bool atEnd() const { return m_stream->atEnd() && (m_version != Version2 || m_currentGroupIndex >= m_currentGroupMaxIndex); }
+    bool atEnd() const;
     // returns how much data has been read from the disc at the moment. pecent() should only be used to visiualize some kind of progress.
     // Do not use percent in any way to check if the reader finished working. Use atEnd() instead.
-    double percent() const {return 1.0 * m_file->pos() / m_file->size();}
+    double percent() const;
     void close();
     void reset() { applyMemento(Memento{m_startOffset, 0}); }
 
-    Memento createMemento() const { return m_version == Version2 ? Memento(m_baseOffset, m_currentGroupIndex): Memento(m_file->pos(), 0); }
+    Memento createMemento() const { return m_version >= Version2 ? Memento(m_baseOffset, m_currentGroupIndex): Memento(m_file->pos(), 0); }
     void applyMemento(const Memento& m);
+    // continues reading timestamps at the memento without loading its group
+    void resumeTimestamps(const Memento& m);
     static QList<Memento> createMementos(const QList<qint64>& offsets, qint32 groupedPackages);
 
+    // the maximum group size for archived logs, whose groups vary in size
     qint32 groupSize() const { return m_packageGroupSize; }
+    bool isArchive() const { return m_version == Version3; }
+
+    // for logs that are still being written
+    // a version 2 group is only usable once its data follows the timestamps
+    bool isNextGroupComplete();
+    // reads the manifest entries appended since the archive was opened
+    void readAppendedGroups();
 
 private:
     bool readVersion();
     qint64 readTimestampVersion0();
     qint64 readTimestampVersion1();
     qint64 readTimestampVersion2();
+    qint64 readTimestampVersion3();
+    bool readArchiveManifest();
+    void readArchiveEntries();
+    void loadArchiveGroup(int group);
+    Status readArchiveStatus();
+    Status parseGroupPacket(const QByteArray &prelude);
     bool readNextGroup();
     bool readCurrentGroup();
     // calling readStatus with false will NOT load the next group if necessary.
@@ -90,7 +110,8 @@ private:
     std::unique_ptr<QFile> m_file;
     std::unique_ptr<QDataStream> m_stream;
 
-    enum Version { Version0, Version1, Version2 };
+    // Version3 is a manifest of an archived log, see LogArchive
+    enum Version { Version0, Version1, Version2, Version3 };
     Version m_version;
     // a group of Status packages and an array of offsets
     QByteArray m_currentGroup;
@@ -105,6 +126,19 @@ private:
     bool m_readingTimstamps;
     // m_baseOffset for the first group
     qint64 m_startOffset;
+
+    struct ArchiveGroup {
+        QByteArray hash;
+        QByteArray prelude;
+        QVector<qint64> timings;
+    };
+    // for archived logs m_baseOffset is the index of the current group
+    QString m_archiveStore;
+    QList<ArchiveGroup> m_archiveGroups;
+    // file position after the last complete manifest entry
+    qint64 m_manifestEnd = 0;
+    int m_loadedArchiveGroup = -1;
+    QByteArray m_archivePrelude;
 };
 
 #endif // SEQLOGFILEREADER_H
@@ -39,12 +39,16 @@ public:
     virtual int packetCount() const = 0;
     virtual Status readStatus(int packet) = 0;
     virtual QString logUID() = 0;
+    // indexes packets appended to a log that is still being written,
+    // returns true and emits packetsAppended if new packets were found
+    virtual bool updateIndex() { return false; }
 
 public slots:
     virtual void readPackets(int startPacket, int count) = 0;
 
 signals:
     void gotStatus(int packet, const Status &status);
+    void packetsAppended(int packetCount);
 
 protected:
     StatusSource() = default;
@@ -51,10 +51,14 @@ public:
     void start();
     void setPaused(bool pause);
     bool isPaused() const { return m_paused; }
+    // periodically checks whether the log has grown
+    void setFollow(bool follow);
 
 private slots:
     void playNext();
     void handleNewData();
+    void followLog();
+    void handlePacketsAppended(int packetCount);
 
 signals:
     void gotStatus(Status s);
@@ -62,6 +66,8 @@ signals:
 
 private:
     void indexLogFile();
+    void indexFrames(int packetCount);
+    void sendLogInfo(bool appended);
     // Frame is timed, time in 0.1s (resolution for TimedStatusSource)
     void seekFrame(int time);
     // Packet is part of the log.
@@ -74,16 +80,22 @@ private:
 private:
     QTimer m_timer;
     Timer m_playTimer;
+    QTimer m_followTimer;
+    static const int FOLLOW_INTERVAL = 500; // in ms
 
     BufferedStatusSource m_statusSource;
     // time -> frame
     QList<int> m_frames;
+    int m_indexedPackets = 0;
+    qint64 m_startTime = 0;
 
     int m_nextPacket;
     int m_spoolCounter;
 
     int m_lastPacket;
     bool m_paused;
+    // the playback only paused because the end of the log was reached
+    bool m_stoppedAtEnd = false;
 };
 
 #endif
@@ -0,0 +1,80 @@
+/***************************************************************************
+ *   Copyright 2018 Tobias Heineken                                        *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "logarchive.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+QString LogArchive::resolveStore(const QString &manifest, const QString &store)
+{
+    return QFileInfo(manifest).dir().filePath(store);
+}
+
+QString LogArchive::relativeStore(const QString &manifest, const QString &store)
+{
+    return QFileInfo(manifest).dir().relativeFilePath(QFileInfo(store).absoluteFilePath());
+}
+
+QString LogArchive::objectPath(const QString &store, const QByteArray &hash)
+{
+    // split the objects into subdirectories to keep the directory size reasonable
+    const QString hex = QString::fromLatin1(hash.toHex());
+    return store + "/" + hex.left(2) + "/" + hex.mid(2);
+}
+
+QByteArray LogArchive::store(const QString &store, const QByteArray &data)
+{
+    const QByteArray hash = QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+    const QString path = objectPath(store, hash);
+    if (QFile::exists(path)) {
+        return hash;
+    }
+
+    if (!QDir().mkpath(QFileInfo(path).path())) {
+        return QByteArray();
+    }
+    // a partially written object must never be visible under its hash
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return QByteArray();
+    }
+    file.write(qCompress(data));
+    if (!file.commit()) {
+        return QByteArray();
+    }
+    return hash;
+}
+
+QByteArray LogArchive::load(const QString &store, const QByteArray &hash)
+{
+    QFile file(objectPath(store, hash));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    const QByteArray data = qUncompress(file.readAll());
+    if (QCryptographicHash::hash(data, QCryptographicHash::Sha256) != hash) {
+        return QByteArray();
+    }
+    return data;
+}
@@ -19,6 +19,7 @@
  ***************************************************************************/
 
 #include "logfilereader.h"
+#include "protobuf/debugstringtable.h"
 
 #include <QMutex>
 #include <QMutexLocker>
@@ -97,19 +98,38 @@ void LogFileReader::close()
     m_errorMsg.clear();
     m_packets.clear();
     m_timings.clear();
+    m_indexEnd.reset();
+    m_logEnded = false;
+    m_lastPacket = -1;
+    m_worldStateDecoder.reset();
+    m_imageKeyframes.reset();
 }
 
 bool LogFileReader::indexFile()
 {
-    qint64 lastTime = 0;
-    bool atEnd = false;
-    while (!m_reader.atEnd()) {
+    if (!indexPackets()) {
+        return false;
+    }
+
+    if (m_packets.size() == 0) {
+        m_errorMsg = "Invalid or empty logfile";
+        return false;
+    }
+
+    return true;
+}
+
+bool LogFileReader::indexPackets()
+{
+    qint64 lastTime = m_timings.isEmpty() ? 0 : m_timings.last();
+    // groups which are still being written are indexed by a later updateIndex
+    while (!m_reader.atEnd() && m_reader.isNextGroupComplete()) {
         SeqLogFileReader::Memento mem = m_reader.createMemento();
 
         qint64 time = m_reader.readTimestamp();
         // a timestamp of 0 indicates a invalid packet
         if (time != 0) {
-            if (atEnd) {
+            if (m_logEnded) {
                 m_errorMsg = "Packet with timestamp zero in the middle of the log found!";
                 return false;
             }
@@ -124,27 +144,85 @@ bool LogFileReader::indexFile()
             m_packets.append(mem);
             m_timings.append(time);
         } else {
-            atEnd = true;
+            m_logEnded = true;
         }
         lastTime = time;
     }
+    m_indexEnd = m_reader.createMemento();
 
-    if (m_packets.size() == 0) {
-        m_errorMsg = "Invalid or empty logfile";
+    return true;
+}
+
+bool LogFileReader::updateIndex()
+{
+    QMutexLocker locker(&m_indexMutex);
+    if (!m_reader.isOpen() || m_logEnded || !m_indexEnd) {
         return false;
     }
-
+    const int oldCount = m_packets.size();
+    m_reader.readAppendedGroups();
+    m_reader.resumeTimestamps(*m_indexEnd);
+    if (!indexPackets()) {
+        // keep the packets indexed so far, but stop following the broken log
+        m_logEnded = true;
+    }
+    const int packetCount = m_packets.size();
+    locker.unlock();
+    if (packetCount == oldCount) {
+        return false;
+    }
+    emit packetsAppended(packetCount);
     return true;
 }
 
 Status LogFileReader::readStatus(int packetNum)
 {
+    QMutexLocker locker(&m_indexMutex);
     if (packetNum < 0 || packetNum >= m_packets.size()) {
         return Status();
     }
+    DebugStringTable debugStrings;
+    const bool seeked = packetNum != m_lastPacket + 1 && m_reader.groupSize() > 0;
+    if (seeked) {
+        // the string tables are repeated at the start of every group,
+        // collect everything defined until the requested packet
+        // compact world states and images are delta coded starting at the group start
+        const int groupStart = packetNum - m_packets.at(packetNum).indexInGroup();
+        m_worldStateDecoder.reset();
+        m_imageKeyframes.reset();
+        m_reader.applyMemento(m_packets.at(groupStart));
+        for (int i = groupStart; i < packetNum; i++) {
+            Status status = m_reader.readStatus();
+            if (!status.isNull()) {
+                debugStrings.update(*status);
+                if (status->has_compact_world_state()) {
+                    m_worldStateDecoder.decode(&*status);
+                }
+                m_imageKeyframes.update(*status, debugStrings);
+            }
+        }
+        // the receiver doesn't know the images preceding the requested packet
+        m_imageKeyframes.requestKeyframes();
+    }
+    m_lastPacket = packetNum;
+
     //seek to the requested packetgroup
     m_reader.applyMemento(m_packets.at(packetNum));
-    return m_reader.readStatus();
+    Status status = m_reader.readStatus();
+    if (!status.isNull() && status->has_compact_world_state()) {
+        m_worldStateDecoder.decode(&*status);
+    }
+    if (seeked && !status.isNull()) {
+        debugStrings.update(*status);
+        if (m_imageKeyframes.update(*status, debugStrings)) {
+            m_imageKeyframes.makeKeyframes(&*status, debugStrings);
+        }
+        if (!debugStrings.isEmpty()) {
+            status->clear_string_table();
+            debugStrings.writeTo(&*status);
+        }
+    }
+    return status;
 }
 
 void LogFileReader::readPackets(int startPacket, int count)
@@ -176,6 +254,7 @@ std::optional<QString> LogFileReader::logUIDFromStatus(const Status status) {
 
 QString LogFileReader::logUID()
 {
+    QMutexLocker locker(&m_indexMutex);
     SeqLogFileReader::Memento mem = m_reader.createMemento();
     m_reader.reset();
     Status status = m_reader.readStatus();
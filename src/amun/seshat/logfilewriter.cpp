@@ -19,7 +19,9 @@
  ***************************************************************************/
 
 #include "logfilewriter.h"
+#include "logarchive.h"
 #include <QByteArray>
+#include <QDir>
 #include <QMutexLocker>
 #include <functional>
 
@@ -43,6 +45,14 @@ LogFileWriter::~LogFileWriter()
 
 std::shared_ptr<StatusSource> LogFileWriter::makeStatusSource()
 {
+    if (isArchive()) {
+        // the manifest contains all timestamps, thus indexing it is cheap
+        QMutexLocker locker(m_mutex);
+        m_file.flush();
+        LogFileReader *reader = new LogFileReader();
+        reader->open(m_file.fileName());
+        return std::shared_ptr<StatusSource>(reader);
+    }
     auto packetOffsets(m_packetOffsets);
     auto timeStamps(m_timeStamps);
     packetOffsets.erase(packetOffsets.begin() + m_writtenPackages, packetOffsets.end());
@@ -77,8 +87,15 @@ bool LogFileWriter::open(const QString &filename, bool ignoreHashing)
 
     // write log header
     m_stream << QString("AMUN-RA LOG");
-    m_stream << (int) 2; // log file version
-    m_stream << GROUPED_PACKAGES;
+    if (isArchive()) {
+        QDir().mkpath(m_archiveStore);
+        m_stream << (int) LogArchive::VERSION;
+        m_stream << GROUPED_PACKAGES;
+        m_stream << LogArchive::relativeStore(filename, m_archiveStore);
+    } else {
+        m_stream << (int) 2; // log file version
+        m_stream << GROUPED_PACKAGES;
+    }
 
     // initialize variables
     m_packageBufferCount = 0;
@@ -87,6 +104,13 @@ bool LogFileWriter::open(const QString &filename, bool ignoreHashing)
     m_hasher.clear();
     m_hashState = HashingState::UNINITIALIZED;
     m_hashStatus->Clear();
+    m_debugStrings.clear();
+    m_stringTableData.clear();
+    m_worldStateEncoder.reset();
+    m_keyframeGroup = -1;
+    m_imageKeyframes.reset();
+    m_imageKeyframeGroup = -1;
+    m_archivePrelude.clear();
 
     if (ignoreHashing) {
         m_hashState = HashingState::HAS_HASHING;
@@ -103,8 +127,8 @@ void LogFileWriter::close()
         return;
     }
     if (m_hashState == HashingState::NEEDS_HASHING) {
-        //first: fill m_packageTimeStamps
-        while (m_packageBufferCount < LogFileHasher::HASHED_PACKAGES - 2) {
+        //first: fill m_packageTimeStamps, archived groups don't need a fixed size
+        while (!isArchive() && m_packageBufferCount < LogFileHasher::HASHED_PACKAGES - 2) {
             writePackageEntry(0, QByteArray());
         }
         //second: insert hash
@@ -114,6 +138,10 @@ void LogFileWriter::close()
         //third: continue as usual
     }
 
+    if (isArchive() && m_packageBufferCount > 0) {
+        writeArchiveGroup();
+    }
+
     // write the last header part and compressed data
     while (m_packageBufferCount > 0) {
         // packet with time 0 get discarded
@@ -130,6 +158,11 @@ bool LogFileWriter::writeStatus(const Status &status)
         return false;
     }
 
+    if (status->string_table_size() > 0) {
+        m_debugStrings.update(*status);
+        m_stringTableData.clear();
+    }
+
     bool serialize = true;
     if (m_hashState == HashingState::UNINITIALIZED && status->has_log_id()) {
         m_hashState = HashingState::HAS_HASHING;
@@ -151,14 +184,66 @@ bool LogFileWriter::writeStatus(const Status &status)
         m_hasher.clear();
     }
 
+    // every group starts with full images, delta coded images are resolved using the previous groups
+    if (m_imageKeyframeGroup != m_writtenPackages) {
+        m_imageKeyframes.requestKeyframes();
+        m_imageKeyframeGroup = m_writtenPackages;
+    }
+    Status output = status;
+    if (m_imageKeyframes.update(*status, m_debugStrings)) {
+        output = Status(new amun::Status);
+        output->CopyFrom(*status);
+        m_imageKeyframes.makeKeyframes(&*output, m_debugStrings);
+    }
+
+    if (serialize && m_profile == EncodingProfile::CompactTracking && output->has_world_state()) {
+        // the first world state of every group is a keyframe, this allows to seek in the log.
+        // Groups often start with statuses without a world state, thus the group start can't be used
+        if (m_keyframeGroup != m_writtenPackages) {
+            m_worldStateEncoder.reset();
+            m_keyframeGroup = m_writtenPackages;
+        }
+        Status compact(new amun::Status);
+        compact->CopyFrom(*output);
+        if (m_worldStateEncoder.encode(&*compact)) {
+            return serializeStatus(&LogFileWriter::writePackageEntry, compact, this);
+        }
+    }
+
     if (serialize) {
-        return serializeStatus(&LogFileWriter::writePackageEntry, status, this);
+        return serializeStatus(&LogFileWriter::writePackageEntry, output, this);
     }
     return true;
 }
 
 void LogFileWriter::writePackageEntry(qint64 time, QByteArray&& data)
 {
+    if (isArchive()) {
+        // the string tables are stored separately, otherwise groups with equal packets would differ
+        if (m_packageBufferCount == 0 && m_writtenPackages > 0 && !data.isEmpty() && !m_debugStrings.isEmpty()) {
+            m_archivePrelude = stringTableData();
+        }
+        m_packageBufferOffsets[m_packageBufferCount] = m_packageBuffer.size();
+        m_packageBuffer.append(data);
+        m_archiveTimeStamps[m_packageBufferCount] = time;
+        m_packageBufferCount++;
+
+        // the first group is only complete once the hash is known
+        const quint64 mixed = quint64(time) * 0x9E3779B97F4A7C15ULL;
+        const bool boundary = m_packageBufferCount >= MIN_ARCHIVE_GROUP && (mixed >> (64 - ARCHIVE_BOUNDARY_BITS)) == 0;
+        if (m_hashState != HashingState::NEEDS_HASHING && (boundary || m_packageBufferCount == GROUPED_PACKAGES)) {
+            writeArchiveGroup();
+        }
+        return;
+    }
+
+    // repeat the string tables at the start of every group, this allows to seek in the log
+    // without reading it from the start. The first group is left unmodified as it is hashed
+    if (m_packageBufferCount == 0 && m_writtenPackages > 0 && !data.isEmpty() && !m_debugStrings.isEmpty()) {
+        // concatenated protobuf messages are merged when parsed
+        data.append(stringTableData());
+    }
+
     m_timeStamps.append(time);
 
     m_packageBufferOffsets[m_packageBufferCount] = m_packageBuffer.size();
@@ -177,6 +262,8 @@ void LogFileWriter::writePackageEntry(qint64 time, QByteArray&& data)
             ds << offset;
         }
         m_stream << qCompress(m_packageBuffer);
+        // make complete groups visible to readers following the log
+        m_file.flush();
         m_packageBufferCount = 0;
         m_packageBuffer.clear();
         m_writtenPackages += GROUPED_PACKAGES;
@@ -185,13 +272,20 @@ void LogFileWriter::writePackageEntry(qint64 time, QByteArray&& data)
 
 void LogFileWriter::addFirstPackage(qint64 time, QByteArray&& data)
 {
-    m_timeStamps.prepend(time);
-    m_packetOffsets.append(m_file.pos());
-    m_stream << time;
-
-    for (qint64 oldTime : m_packageTimeStamps) {
+    if (isArchive()) {
+        for (int i = m_packageBufferCount; i > 0; --i) {
+            m_archiveTimeStamps[i] = m_archiveTimeStamps[i - 1];
+        }
+        m_archiveTimeStamps[0] = time;
+    } else {
+        m_timeStamps.prepend(time);
         m_packetOffsets.append(m_file.pos());
-        m_stream << oldTime;
+        m_stream << time;
+
+        for (qint64 oldTime : m_packageTimeStamps) {
+            m_packetOffsets.append(m_file.pos());
+            m_stream << oldTime;
+        }
     }
 
     qint32 oldOffset = m_packageBufferOffsets[0];
@@ -211,3 +305,37 @@ void LogFileWriter::addFirstPackage(qint64 time, QByteArray&& data)
         qFatal("Some strange thing happend in addFirstPackage");
     }
 }
+
+void LogFileWriter::writeArchiveGroup()
+{
+    QDataStream ds(&m_packageBuffer, QIODevice::WriteOnly | QIODevice::Append);
+    ds.setVersion(QDataStream::Qt_4_6);
+    for (int i = 0; i < m_packageBufferCount; ++i) {
+        ds << m_packageBufferOffsets[i];
+    }
+
+    // the timestamps are kept in the manifest, even if storing the group failed
+    m_stream << m_packageBufferCount;
+    m_stream << LogArchive::store(m_archiveStore, m_packageBuffer);
+    m_stream << (m_archivePrelude.isEmpty() ? QByteArray() : LogArchive::store(m_archiveStore, m_archivePrelude));
+    for (int i = 0; i < m_packageBufferCount; ++i) {
+        m_stream << m_archiveTimeStamps[i];
+    }
+    m_file.flush();
+
+    m_writtenPackages += m_packageBufferCount;
+    m_packageBufferCount = 0;
+    m_packageBuffer.clear();
+    m_archivePrelude.clear();
+}
+
+const QByteArray &LogFileWriter::stringTableData()
+{
+    if (m_stringTableData.isEmpty()) {
+        amun::Status status;
+        m_debugStrings.writeTo(&status);
+        m_stringTableData.resize(status.ByteSize());
+        status.SerializeToArray(m_stringTableData.data(), m_stringTableData.size());
+    }
+    return m_stringTableData;
+}
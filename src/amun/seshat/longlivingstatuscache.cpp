@@ -19,6 +19,7 @@
  ***************************************************************************/
 
 #include "longlivingstatuscache.h"
+#include "protobuf/visionframes.h"
 
 void LongLivingStatusCache::handleStatus(const Status& status) {
     // keep team configurations for the logfile
@@ -30,8 +31,11 @@ void LongLivingStatusCache::handleStatus(const Status& status) {
     }
 
     if (status->has_world_state()) {
-        for (const auto &vision : status->world_state().vision_frames()) {
-            if (vision.has_geometry()) {
+        const world::State &worldState = status->world_state();
+        for (int i = 0; i < visionFrameCount(worldState); i++) {
+            // only geometry packets have to be parsed
+            SSL_WrapperPacket vision;
+            if (visionFrameHasGeometry(worldState, i) && parseVisionFrame(worldState, i, vision)) {
                 for (const auto &calib : vision.geometry().calib()) {
                     // avoid copying the vision geometry since it is rather large (around 1kb)
                     m_lastVisionGeometryStatus[calib.camera_id()] = status;
@@ -46,6 +50,10 @@ void LongLivingStatusCache::handleStatus(const Status& status) {
     for(const auto& gitInfo: status->git_info()) {
         m_lastGitInfos[gitInfo.kind()] = status;
     }
+    // the ids used in debug output are only defined once
+    if (status->string_table_size() > 0) {
+        m_debugStrings.update(*status);
+    }
 }
 
 void LongLivingStatusCache::publish(bool debug) {
@@ -58,6 +66,7 @@ void LongLivingStatusCache::publish(bool debug) {
     emit sendStatus(getTeamStatus());
     emit sendStatus(getVisionGeometryStatus());
     emit sendStatus(getGitStatus());
+    emit sendStatus(getStringTableStatus());
 }
 
 Status LongLivingStatusCache::getTeamStatus()
@@ -69,6 +78,14 @@ Status LongLivingStatusCache::getTeamStatus()
     return status;
 }
 
+Status LongLivingStatusCache::getStringTableStatus()
+{
+    Status status(new amun::Status);
+    status->set_time(m_lastTime);
+    m_debugStrings.writeTo(&*status);
+    return status;
+}
+
 Status LongLivingStatusCache::getVisionGeometryStatus()
 {
     Status status(new amun::Status);
@@ -77,10 +94,16 @@ Status LongLivingStatusCache::getVisionGeometryStatus()
         auto *world = status->mutable_world_state();
         world->set_time(m_lastTime);
         for (int id : m_lastVisionGeometryStatus.keys()) {
-            for (const auto &vision : m_lastVisionGeometryStatus[id]->world_state().vision_frames()) {
-                if (vision.has_geometry()) {
-                    world->add_vision_frames()->mutable_geometry()->CopyFrom(vision.geometry());
-                    world->add_vision_frame_times(m_lastTime);
+            const world::State &worldState = m_lastVisionGeometryStatus[id]->world_state();
+            for (int i = 0; i < visionFrameCount(worldState); i++) {
+                SSL_WrapperPacket vision;
+                if (visionFrameHasGeometry(worldState, i) && parseVisionFrame(worldState, i, vision)) {
+                    SSL_WrapperPacket geometry;
+                    geometry.mutable_geometry()->Swap(vision.mutable_geometry());
+                    QByteArray data(geometry.ByteSize(), 0);
+                    if (geometry.SerializeToArray(data.data(), data.size())) {
+                        addVisionFrame(world, data, m_lastTime);
+                    }
                 }
             }
         }
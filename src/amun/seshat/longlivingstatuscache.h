@@ -21,6 +21,7 @@
 #define LONGLIVINGSTATUSCACHE_H
 #include "protobuf/status.h"
 #include "protobuf/command.h"
+#include "protobuf/debugstringtable.h"
 
 #include <QObject>
 #include <QMap>
@@ -38,6 +39,7 @@ signals:
 
 public:
     Status getTeamStatus();
+    Status getStringTableStatus();
     void publish(bool debug = false);
     void handleStatus(const Status& s);
 
@@ -51,6 +53,7 @@ private:
     // camera id -> geometry (each geometry only has at most 1 camera calibration)
     QMap<int, Status> m_lastVisionGeometryStatus;
     QMap<amun::GitInfo::Kind, Status> m_lastGitInfos;
+    DebugStringTable m_debugStrings;
     qint64 m_lastTime = 0;
 };
 #endif
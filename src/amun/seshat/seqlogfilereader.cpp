@@ -19,6 +19,7 @@
  ***************************************************************************/
 
 #include "seqlogfilereader.h"
+#include "logarchive.h"
 
 #include <QMutex>
 #include <QMutexLocker>
@@ -50,7 +51,12 @@ SeqLogFileReader::SeqLogFileReader(SeqLogFileReader&& o) :
     m_packageGroupSize(std::move(o.m_packageGroupSize)),
     m_baseOffset(std::move(o.m_baseOffset)),
     m_readingTimstamps(std::move(o.m_readingTimstamps)),
-    m_startOffset(std::move(o.m_startOffset))
+    m_startOffset(std::move(o.m_startOffset)),
+    m_archiveStore(std::move(o.m_archiveStore)),
+    m_archiveGroups(std::move(o.m_archiveGroups)),
+    m_manifestEnd(std::move(o.m_manifestEnd)),
+    m_loadedArchiveGroup(std::move(o.m_loadedArchiveGroup)),
+    m_archivePrelude(std::move(o.m_archivePrelude))
 {
     //leave o in a valid state
     o.m_file.reset(new QFile());
@@ -85,7 +91,12 @@ bool SeqLogFileReader::open(const QString &filename)
 
     // initialize variables
     m_currentGroupIndex = 0;
-    m_baseOffset = m_file->pos() + sizeof(qint64) * m_packageGroupSize;
+    if (m_version == Version3) {
+        // archived logs count groups instead of file offsets
+        m_baseOffset = 0;
+    } else {
+        m_baseOffset = m_file->pos() + sizeof(qint64) * m_packageGroupSize;
+    }
     m_startOffset = m_baseOffset;
     m_readingTimstamps = true;
     //assume its a full packet. As we are reading timestamps, thats fine. If we swap to read packets, we update m_currentGroupMaxIndex
@@ -102,6 +113,27 @@ void SeqLogFileReader::close()
 
     m_errorMsg.clear();
     m_currentGroup.clear();
+    m_archiveStore.clear();
+    m_archiveGroups.clear();
+    m_manifestEnd = 0;
+    m_loadedArchiveGroup = -1;
+    m_archivePrelude.clear();
+}
+
+bool SeqLogFileReader::atEnd() const
+{
+    if (m_version == Version3) {
+        return m_baseOffset >= m_archiveGroups.size();
+    }
+    return m_stream->atEnd() && (m_version != Version2 || m_currentGroupIndex >= m_currentGroupMaxIndex);
+}
+
+double SeqLogFileReader::percent() const
+{
+    if (m_version == Version3) {
+        return m_archiveGroups.isEmpty() ? 1.0 : 1.0 * m_baseOffset / m_archiveGroups.size();
+    }
+    return 1.0 * m_file->pos() / m_file->size();
 }
 
 QList<SeqLogFileReader::Memento> SeqLogFileReader::createMementos(const QList<qint64>& offsets, qint32 groupedPackages)
@@ -121,6 +153,8 @@ QList<SeqLogFileReader::Memento> SeqLogFileReader::createMementos(const QList<qi
 bool SeqLogFileReader::readNextGroup()
 {
     QMutexLocker locker(m_mutex);
+    // a group that is still being written may have failed to load before
+    m_stream->resetStatus();
     qint64 baseOffset = m_file->pos() + sizeof(qint64) * m_packageGroupSize;
     //assume its a full group
     m_currentGroupMaxIndex = m_packageGroupSize;
@@ -188,6 +222,11 @@ bool SeqLogFileReader::readVersion()
             *m_stream >> m_packageGroupSize;
             break;
 
+        case LogArchive::VERSION:
+            m_version = Version3;
+            *m_stream >> m_packageGroupSize;
+            return readArchiveManifest();
+
         default:
             m_errorMsg = "File format not supported!";
             return false;
@@ -267,6 +306,118 @@ qint64 SeqLogFileReader::readTimestampVersion2()
     return time;
 }
 
+bool SeqLogFileReader::readArchiveManifest()
+{
+    QString store;
+    *m_stream >> store;
+    if (m_stream->status() != QDataStream::Ok || m_packageGroupSize <= 0) {
+        m_errorMsg = "Invalid log archive manifest";
+        return false;
+    }
+    m_archiveStore = LogArchive::resolveStore(m_file->fileName(), store);
+    m_manifestEnd = m_file->pos();
+    readArchiveEntries();
+    return true;
+}
+
+void SeqLogFileReader::readArchiveEntries()
+{
+    m_file->seek(m_manifestEnd);
+    while (!m_stream->atEnd()) {
+        ArchiveGroup group;
+        qint32 count;
+        *m_stream >> count >> group.hash >> group.prelude;
+        if (m_stream->status() != QDataStream::Ok || count <= 0 || count > m_packageGroupSize) {
+            break;
+        }
+        group.timings.resize(count);
+        for (qint64 &time : group.timings) {
+            *m_stream >> time;
+        }
+        // the last entry may be truncated if the writer didn't close the log
+        if (m_stream->status() != QDataStream::Ok) {
+            break;
+        }
+        m_archiveGroups.append(group);
+        m_manifestEnd = m_file->pos();
+    }
+    m_stream->resetStatus();
+}
+
+void SeqLogFileReader::readAppendedGroups()
+{
+    QMutexLocker locker(m_mutex);
+    if (m_version == Version3) {
+        readArchiveEntries();
+    }
+}
+
+bool SeqLogFileReader::isNextGroupComplete()
+{
+    QMutexLocker locker(m_mutex);
+    if (m_version != Version2 || m_currentGroupIndex != 0) {
+        return true;
+    }
+    // the timestamps are written packet by packet, the group data only once the group is full
+    const qint64 sizeOffset = m_baseOffset;
+    if (m_file->size() < sizeOffset + qint64(sizeof(quint32))) {
+        return false;
+    }
+    const qint64 pos = m_file->pos();
+    m_file->seek(sizeOffset);
+    quint32 size;
+    *m_stream >> size;
+    const bool complete = m_stream->status() == QDataStream::Ok
+            && m_file->size() >= sizeOffset + qint64(sizeof(quint32)) + size;
+    m_stream->resetStatus();
+    m_file->seek(pos);
+    return complete;
+}
+
+void SeqLogFileReader::loadArchiveGroup(int group)
+{
+    m_loadedArchiveGroup = group;
+    m_currentGroup.clear();
+    m_currentGroupOffsets.clear();
+    m_archivePrelude.clear();
+
+    const ArchiveGroup &g = m_archiveGroups.at(group);
+    const int count = g.timings.size();
+    m_currentGroupMaxIndex = count;
+    const QByteArray data = LogArchive::load(m_archiveStore, g.hash);
+    if (data.size() < int(sizeof(qint32)) * count) {
+        return;
+    }
+    if (!g.prelude.isEmpty()) {
+        m_archivePrelude = LogArchive::load(m_archiveStore, g.prelude);
+    }
+    m_currentGroup = data;
+
+    QDataStream ds(m_currentGroup);
+    ds.setVersion(QDataStream::Qt_4_6);
+    ds.skipRawData(m_currentGroup.size() - sizeof(qint32) * count);
+    for (int i = 0; i < count; ++i) {
+        qint32 offset;
+        ds >> offset;
+        m_currentGroupOffsets.append(offset);
+    }
+}
+
+qint64 SeqLogFileReader::readTimestampVersion3()
+{
+    if (m_baseOffset >= m_archiveGroups.size()) {
+        return 0;
+    }
+    const QVector<qint64> &timings = m_archiveGroups.at(m_baseOffset).timings;
+    const qint64 time = timings.at(m_currentGroupIndex);
+    m_currentGroupIndex++;
+    if (m_currentGroupIndex >= timings.size()) {
+        m_baseOffset++;
+        m_currentGroupIndex = 0;
+    }
+    return time;
+}
+
 qint64 SeqLogFileReader::readTimestamp()
 {
     // lock to prevent intermediate file changes
@@ -275,16 +426,23 @@ qint64 SeqLogFileReader::readTimestamp()
         case Version0: return readTimestampVersion0();
         case Version1: return readTimestampVersion1();
         case Version2: return readTimestampVersion2();
+        case Version3: return readTimestampVersion3();
         default: qFatal("unknown Version");
     }
 }
 
 void SeqLogFileReader::applyMemento(const Memento& mem){
     // handle old versions
-    if (m_version != Version2) {
+    if (m_version < Version2) {
         m_file->seek(mem.baseOffset);
         return;
     }
+    // groups of archived logs are loaded once a status is read
+    if (m_version == Version3) {
+        m_baseOffset = mem.baseOffset;
+        m_currentGroupIndex = mem.groupIndex;
+        return;
+    }
 
     if (mem.baseOffset != m_baseOffset) {
         m_baseOffset = mem.baseOffset;
@@ -295,16 +453,89 @@ void SeqLogFileReader::applyMemento(const Memento& mem){
     m_currentGroupIndex = mem.groupIndex;
 }
 
+void SeqLogFileReader::resumeTimestamps(const Memento& mem)
+{
+    QMutexLocker locker(m_mutex);
+    m_stream->resetStatus();
+    if (m_version != Version2) {
+        applyMemento(mem);
+        return;
+    }
+    // readTimestampVersion2 seeks to the timestamp once it notices the missing group
+    m_baseOffset = mem.baseOffset;
+    m_currentGroupIndex = mem.groupIndex;
+    m_currentGroupMaxIndex = m_packageGroupSize;
+    m_currentGroup.clear();
+    m_readingTimstamps = false;
+}
+
 Status SeqLogFileReader::readStatus()
 {
     return readStatus(true);
 }
 
+Status SeqLogFileReader::parseGroupPacket(const QByteArray &prelude)
+{
+    qint32 packetOffset = m_currentGroupOffsets[m_currentGroupIndex];
+    m_currentGroupIndex++;
+    Status res;
+    //check for invalid offset
+    if (packetOffset < m_currentGroup.size() && packetOffset >= 0) {
+        const int count = m_currentGroupOffsets.size();
+        qint32 packetSize;
+        if (m_currentGroupIndex < count) {
+            packetSize = m_currentGroupOffsets[m_currentGroupIndex] - packetOffset;
+        } else {
+            packetSize = m_currentGroup.size() - sizeof(qint32) * count - packetOffset;
+        }
+
+        Status status = Status::createArena();
+        if (prelude.isEmpty()) {
+            if (status->ParseFromArray(m_currentGroup.data() + packetOffset, packetSize)) {
+                res = status;
+            }
+        } else if (packetSize >= 0 && packetOffset + packetSize <= m_currentGroup.size()) {
+            // concatenated protobuf messages are merged when parsed
+            QByteArray packet = m_currentGroup.mid(packetOffset, packetSize);
+            packet.append(prelude);
+            if (status->ParseFromArray(packet.data(), packet.size())) {
+                res = status;
+            }
+        }
+    }
+    return res;
+}
+
+Status SeqLogFileReader::readArchiveStatus()
+{
+    if (m_baseOffset >= m_archiveGroups.size()) {
+        return Status();
+    }
+    const int group = m_baseOffset;
+    if (group != m_loadedArchiveGroup) {
+        loadArchiveGroup(group);
+    }
+    Status res;
+    if (m_currentGroupIndex < m_currentGroupOffsets.size()) {
+        res = parseGroupPacket(m_currentGroupIndex == 0 ? m_archivePrelude : QByteArray());
+    } else {
+        // a missing object only loses its own packets
+        m_currentGroupIndex++;
+    }
+    if (m_currentGroupIndex >= m_archiveGroups.at(group).timings.size()) {
+        m_baseOffset++;
+        m_currentGroupIndex = 0;
+    }
+    return res;
+}
+
 Status SeqLogFileReader::readStatus(bool loadNextGroup)
 {
     // lock to prevent intermediate file changes
     QMutexLocker locker(m_mutex);
-    if (m_version == Version2) {
+    if (m_version == Version3) {
+        return readArchiveStatus();
+    } else if (m_version == Version2) {
         // if the group is not loaded yet, do so.
         if (m_currentGroup.isEmpty()) {
             // There's no need to check m_readingTimstamps, as readCurrentGroup does not care about that and resets it to false
@@ -319,23 +550,7 @@ Status SeqLogFileReader::readStatus(bool loadNextGroup)
             return Status();
         }
 
-        qint32 packetOffset = m_currentGroupOffsets[m_currentGroupIndex];
-        m_currentGroupIndex++;
-        Status res;
-        //check for invalid offset
-        if (packetOffset < m_currentGroup.size() && packetOffset >= 0) {
-            qint32 packetSize;
-            if (m_currentGroupIndex < m_packageGroupSize) {
-                packetSize = m_currentGroupOffsets[m_currentGroupIndex] - packetOffset;
-            } else {
-                packetSize = m_currentGroup.size() - sizeof(qint32) * m_packageGroupSize - packetOffset;
-            }
-
-            Status status = Status::createArena();
-            if (status->ParseFromArray(m_currentGroup.data() + packetOffset, packetSize)) {
-                res = status;
-            }
-        }
+        Status res = parseGroupPacket(QByteArray());
 
         //load next group if possible
         if (loadNextGroup && m_currentGroupIndex >= m_currentGroupMaxIndex && !m_stream->atEnd()) {
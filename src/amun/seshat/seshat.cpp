@@ -118,6 +118,8 @@ void Seshat::forceUi(bool ra)
 
 void Seshat::sendBufferedStatus()
 {
+    // the ui resolved the ids of the log meanwhile, the live ids were only sent once
+    emit sendUi(m_logger.getStringTableStatus());
     for (const Status &status : m_horusStrategyBuffer) {
         emit sendUi(status);
     }
@@ -198,6 +200,10 @@ void Seshat::handleCommand(const Command& command)
         if (playback.has_find_logfile()) {
             handleLogFindRequest(playback.find_logfile());
         }
+
+        if (playback.has_follow_log() && m_statusSource) {
+            m_statusSource->setFollow(playback.follow_log());
+        }
     }
 
     if (m_isPlayback && m_statusSource) {
@@ -238,6 +244,9 @@ void Seshat::openLogfile(const logfile::LogRequest& logRequest)
 
             sendLogfileInfo(QFileInfo(QString::fromStdString(filename)).fileName().toStdString(), false);
             setStatusSource(logfile);
+            if (logRequest.follow()) {
+                m_statusSource->setFollow(true);
+            }
 
             return;
 
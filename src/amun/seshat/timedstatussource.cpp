@@ -35,6 +35,19 @@ TimedStatusSource::TimedStatusSource(std::shared_ptr<StatusSource> source, QObje
     m_timer.setSingleShot(true);
 
    connect(&m_statusSource, SIGNAL(gotNewData()), this, SLOT(handleNewData()));
+
+    // new packets are announced from the thread which calls updateIndex
+    connect(source.get(), &StatusSource::packetsAppended, this, &TimedStatusSource::handlePacketsAppended);
+    connect(&m_followTimer, &QTimer::timeout, this, &TimedStatusSource::followLog);
+}
+
+void TimedStatusSource::setFollow(bool follow)
+{
+    if (follow) {
+        m_followTimer.start(FOLLOW_INTERVAL);
+    } else {
+        m_followTimer.stop();
+    }
 }
 
 void TimedStatusSource::start()
@@ -72,38 +85,69 @@ void TimedStatusSource::handleCommand(const Command& command)
 
 }
 
+void TimedStatusSource::followLog()
+{
+    m_statusSource.getStatusSource()->updateIndex();
+}
+
 void TimedStatusSource::indexLogFile()
 {
     const QList<qint64> &timings = m_statusSource.getStatusSource()->timings();
-    // create frame index for the scroll bar
-    qint64 startTime;
-    qint64 duration;
-    if (!timings.isEmpty()) {
-        startTime = timings.first();
-        duration = timings.last() - startTime;
-    } else {
-        startTime = 0;
-        duration = 0;
-    }
-    qint64 seekTime = 0;
-    for (int i = 0; i < timings.size(); ++i) {
+    m_startTime = timings.isEmpty() ? 0 : timings.first();
+    indexFrames(m_statusSource.getStatusSource()->packetCount());
+    sendLogInfo(false);
+    // load first frame
+    seekPacket(0);
+}
+
+void TimedStatusSource::indexFrames(int packetCount)
+{
+    const QList<qint64> &timings = m_statusSource.getStatusSource()->timings();
+    // create frame index for the scroll bar, continuing after the already indexed frames
+    qint64 seekTime = m_frames.size();
+    for (int i = m_indexedPackets; i < packetCount; ++i) {
         // time indexing is done with 0.1s precision
-        const qint64 curTime = (timings.value(i) - startTime) / 1E8;
+        const qint64 curTime = (timings.value(i) - m_startTime) / 1E8;
         while (seekTime <= curTime) {
             // index of the belonging packet
             m_frames.append(i);
             seekTime++;
         }
     }
+    m_indexedPackets = std::max(m_indexedPackets, packetCount);
+}
+
+void TimedStatusSource::sendLogInfo(bool appended)
+{
+    const QList<qint64> &timings = m_statusSource.getStatusSource()->timings();
+    const qint64 duration = timings.isEmpty() ? 0 : timings.value(m_indexedPackets - 1) - m_startTime;
     // send startTime and duration to Ra.
     Status s = Status::createArena();
     amun::LogPlaybackInfo *logInfo = s->mutable_pure_ui_response()->mutable_log_info();
     logInfo->set_duration(duration);
-    logInfo->set_start_time(startTime);
-    logInfo->set_packet_count(m_statusSource.getStatusSource()->packetCount());
+    logInfo->set_start_time(m_startTime);
+    logInfo->set_packet_count(m_indexedPackets);
+    if (appended) {
+        logInfo->set_appended(true);
+    }
     emit gotStatus(s);
-    // load first frame
-    seekPacket(0);
+}
+
+void TimedStatusSource::handlePacketsAppended(int packetCount)
+{
+    const int previousCount = m_indexedPackets;
+    indexFrames(packetCount);
+    if (m_indexedPackets == previousCount) {
+        return;
+    }
+    // a limit at the previous end of the log moves along
+    if (m_lastPacket == previousCount - 1) {
+        m_lastPacket = -1;
+    }
+    sendLogInfo(true);
+    if (m_stoppedAtEnd) {
+        setPaused(false);
+    }
 }
 
 void TimedStatusSource::seekFrame(int time)
@@ -124,6 +168,7 @@ void TimedStatusSource::seekFrameBackwards(int time)
 
 void TimedStatusSource::seekPacket(int packet)
 {
+    m_stoppedAtEnd = false;
     // do not start the (imprecise) process of jumping to the packet if we can simply spool ahead a little instead
     bool canSpool = packet >= m_nextPacket && packet <= m_nextPacket + m_statusSource.requestedBufferSize();
     if (canSpool) {
@@ -173,6 +218,7 @@ void TimedStatusSource::togglePaused()
 
 void TimedStatusSource::setPaused(bool paused)
 {
+    m_stoppedAtEnd = false;
     m_paused = paused;
     // pause if playback has reached the end
     if (m_nextPacket == m_statusSource.getStatusSource()->packetCount()) {
@@ -237,7 +283,10 @@ void TimedStatusSource::playNext()
 
         // stop after last packet
         if (m_nextPacket == m_statusSource.getStatusSource()->packetCount()) {
+            const bool wasPlaying = !m_paused;
             setPaused(true);
+            // continue once a followed log grows
+            m_stoppedAtEnd = wasPlaying;
         }
         // break if the current frame should have been the last one
         if (m_spoolCounter == 0 && currentPacket == m_lastPacket) {
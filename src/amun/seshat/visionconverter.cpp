@@ -21,6 +21,7 @@
 #include "visionconverter.h"
 #include "visionlog/visionlogwriter.h"
 #include "protobuf/ssl_referee.h"
+#include "protobuf/visionframes.h"
 
 QString VisionExtractor::extractVision(StatusSource& source, const QString& saveFileLocation)
 {
@@ -35,8 +36,12 @@ QString VisionExtractor::extractVision(StatusSource& source, const QString& save
         Status current = source.readStatus(i);
 
         if (current->has_world_state()) {
-            for (const auto &frame : current->world_state().vision_frames()) {
-                logfileOut.addVisionPacket(frame, current->time());
+            const world::State &worldState = current->world_state();
+            for (int j = 0; j < visionFrameCount(worldState); j++) {
+                const QByteArray data = visionFrameData(worldState, j);
+                if (!data.isEmpty()) {
+                    logfileOut.addVisionPacket(data, current->time());
+                }
             }
         }
 
@@ -23,11 +23,13 @@
 
 #include "protobuf/command.h"
 #include "protobuf/status.h"
+#include "protobuf/simulatortruth.h"
 #include "protobuf/sslsim.h"
 #include <QList>
 #include <QMap>
 #include <QPair>
 #include <QQueue>
+#include <QVector>
 #include <QByteArray>
 #include <tuple>
 #include <random>
@@ -76,7 +78,7 @@ signals:
     void gotPacket(const QByteArray &data, qint64 time, QString sender);
     void sendStatus(const Status &status);
     void sendRadioResponses(const QList<robot::RadioResponse> &responses);
-    void sendRealData(const QByteArray& data); // sends amun::SimulatorState
+    void sendRealData(const SimulatorTruth &truth);
     void sendSSLSimError(const QList<SSLSimError>& errors, ErrorSource source);
 
 public slots:
@@ -95,7 +97,10 @@ private slots:
 private:
     void sendSSLSimErrorInternal(ErrorSource source);
     void resetFlipped(RobotMap &robots, float side);
-    std::tuple<QList<QByteArray>, QByteArray, qint64> createVisionPacket();
+    std::tuple<QList<QByteArray>, SimulatorTruth, qint64> createVisionPacket();
+    SimulatorTruth createTruth() const;
+    QList<QByteArray> createDetections();
+    bool isCameraEnabled(std::size_t cameraId) const;
     void resetVisionPackets();
     void setTeam(RobotMap &list, float side, const robot::Team &team, QMap<uint32_t, robot::Specs>& specs);
     void moveBall(const sslsim::TeleportBall &ball);
@@ -107,7 +112,7 @@ private:
     typedef std::tuple<SSLSimRobotControl, qint64, bool> RadioCommand;
     SimulatorData *m_data;
     QQueue<RadioCommand> m_radioCommands;
-    QQueue<std::tuple<QList<QByteArray>, QByteArray, qint64>> m_visionPackets;
+    QQueue<std::tuple<QList<QByteArray>, SimulatorTruth, qint64>> m_visionPackets;
     QQueue<QTimer *> m_visionTimers;
     bool m_isPartial;
     const Timer *m_timer;
@@ -121,6 +126,17 @@ private:
     qint64 m_visionDelay;
     qint64 m_visionProcessingTime;
 
+    // requested vision outputs, see amun::SimulatorVisionOutput
+    static constexpr qint64 DEFAULT_VISION_INTERVAL = 12500000;
+    bool m_sendTruth = true;
+    bool m_sendDetections = true;
+    // detections are generated for all cameras if empty
+    QVector<std::size_t> m_detectionCameras;
+    qint64 m_visionInterval = DEFAULT_VISION_INTERVAL;
+    // generation time of the last vision frame
+    qint64 m_truthTiming = 0;
+    qint64 m_detectionTiming = 0;
+
     qint64 m_minRobotDetectionTime = 0;
     qint64 m_minBallDetectionTime = 0;
     qint64 m_lastBallSendTime = 0;
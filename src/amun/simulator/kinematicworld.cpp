@@ -0,0 +1,531 @@
+/***************************************************************************
+ *   Copyright 2015 Michael Eischer, Philipp Nordhus                       *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "kinematicworld.h"
+#include "core/coordinates.h"
+#include "core/rng.h"
+#include "protobuf/ssl_detection.pb.h"
+#include "simball.h"
+#include "simulator.h"
+#include <cmath>
+#include <vector>
+
+using namespace camun::simulator;
+
+// use the same ball model as reported in the geometry (see Simulator::createVisionPacket)
+const float BALL_SLIDE_DECELERATION = 3.9f;
+const float BALL_ROLL_DECELERATION = 0.35f;
+const float BALL_SWITCH_RATIO = 0.69f;
+const float BALL_DAMPING_Z = 0.566f;
+const float BALL_DAMPING_XY_FIRST_HOP = 0.715f;
+const float BALL_MIN_BOUNCE_SPEED = 0.1f;
+const float BALL_ROBOT_RESTITUTION = 0.6f;
+const float BALL_WALL_RESTITUTION = 0.3f;
+const float GRAVITY = 9.81f;
+// let robot accelerate / brake faster than the accelerator does, just like SimRobot
+const float ACCELERATION_SCALE = 2.0f;
+const double COMMAND_TIMEOUT = 0.1;
+const double RECHARGE_TIME = 0.1;
+
+static float boundAcceleration(float acceleration, float oldSpeed, float speedupLimit, float brakeLimit)
+{
+    if ((std::signbit(acceleration) == std::signbit(oldSpeed)) || (oldSpeed == 0)) {
+        return qBound(-speedupLimit, acceleration, speedupLimit);
+    } else {
+        return qBound(-brakeLimit, acceleration, brakeLimit);
+    }
+}
+
+/*!
+ * \class KinematicWorld
+ * \ingroup simulator
+ * \brief Fast 2D replacement for the bullet physics
+ */
+
+KinematicWorld::KinematicWorld(RNG *rng, const world::Geometry &geometry) :
+    m_rng(rng),
+    m_halfWidth(geometry.field_width() / 2.0f + geometry.boundary_width()),
+    m_halfHeight(geometry.field_height() / 2.0f + geometry.boundary_width()),
+    m_goalWidthHalf(geometry.goal_width() / 2.0f),
+    m_goalLine(geometry.field_height() / 2.0f),
+    m_goalDepth(geometry.goal_depth()),
+    m_ballPos(0, 0, 0),
+    m_ballV(0, 0, 0)
+{
+}
+
+void KinematicWorld::step(double time)
+{
+    // use the same sub timestep as bullet, the collision handling relies on small steps
+    const int steps = std::max(1, int(std::ceil(time / SUB_TIMESTEP - 1E-6)));
+    const double stepTime = time / steps;
+    for (int i = 0; i < steps; i++) {
+        m_ballHeld = false;
+        for (Robot &robot : m_blue) {
+            stepRobot(robot, stepTime);
+        }
+        for (Robot &robot : m_yellow) {
+            stepRobot(robot, stepTime);
+        }
+        collideRobots();
+        stepBall(stepTime);
+        for (Robot &robot : m_blue) {
+            collideBall(robot);
+        }
+        for (Robot &robot : m_yellow) {
+            collideBall(robot);
+        }
+    }
+}
+
+btVector3 KinematicWorld::forward(const Robot &robot)
+{
+    return btVector3(-std::sin(robot.phi), std::cos(robot.phi), 0);
+}
+
+float KinematicWorld::frontDistance(const Robot &robot)
+{
+    return robot.specs.radius() * std::cos(robot.specs.angle() / 2.0f);
+}
+
+void KinematicWorld::stepRobot(Robot &robot, double time)
+{
+    robot.commandTime += time;
+    robot.touchesBall = false;
+    // after 0.1s without new command reset to stop
+    const bool inStandby = robot.commandTime > COMMAND_TIMEOUT;
+    if (inStandby) {
+        robot.command.Clear();
+    }
+
+    // charge kicker only if enabled
+    if (!inStandby && robot.charge) {
+        robot.shootTime += time;
+        if (!robot.isCharged && robot.shootTime > RECHARGE_TIME) {
+            robot.isCharged = true;
+        }
+    } else {
+        robot.isCharged = false;
+        robot.shootTime = 0;
+    }
+
+    const btVector3 f = forward(robot);
+    // local x axis
+    const btVector3 s(f.y(), -f.x(), 0);
+    const sslsim::RobotCommand &command = robot.command;
+
+    if (robot.isCharged && command.has_kick_speed() && command.kick_speed() > 0 && canKickBall(robot)) {
+        const float angle = command.kick_angle() / 180 * M_PI;
+        const float maxSpeed = command.kick_angle() == 0 ? robot.specs.shot_linear_max()
+                                                         : coordinates::chipVelFromChipDistance(robot.specs.shot_chip_max());
+        const float power = qBound(0.05f, command.kick_speed(), maxSpeed);
+        m_ballV = robot.v + f * (std::cos(angle) * power) + btVector3(0, 0, std::sin(angle) * power);
+        m_ballSwitchSpeed = BALL_SWITCH_RATIO * std::cos(angle) * power;
+        m_ballBounced = false;
+        robot.isCharged = false;
+        robot.shootTime = 0;
+    }
+
+    float targetF = 0;
+    float targetS = 0;
+    float targetOmega = 0;
+    if (!inStandby && command.has_move_command() && command.move_command().has_local_velocity()) {
+        targetF = command.move_command().local_velocity().forward();
+        targetS = -command.move_command().local_velocity().left();
+        targetOmega = command.move_command().local_velocity().angular();
+    }
+
+    const robot::LimitParameters &limits = robot.specs.strategy();
+    float vF = robot.v.dot(f);
+    float vS = robot.v.dot(s);
+    vF += boundAcceleration((targetF - vF) / time, vF, ACCELERATION_SCALE * limits.a_speedup_f_max(),
+                            ACCELERATION_SCALE * limits.a_brake_f_max()) * time;
+    vS += boundAcceleration((targetS - vS) / time, vS, ACCELERATION_SCALE * limits.a_speedup_s_max(),
+                            ACCELERATION_SCALE * limits.a_brake_s_max()) * time;
+    robot.omega += boundAcceleration((targetOmega - robot.omega) / time, robot.omega, ACCELERATION_SCALE * limits.a_speedup_phi_max(),
+                                     ACCELERATION_SCALE * limits.a_brake_phi_max()) * time;
+
+    robot.v = f * vF + s * vS;
+    robot.pos += robot.v * time;
+    robot.phi = std::remainder(robot.phi + robot.omega * time, 2 * M_PI);
+    limitToField(robot.pos, robot.v, robot.specs.radius(), 0);
+
+    if (!inStandby && command.has_dribbler_speed() && command.dribbler_speed() > 0 && robot.specs.can_dribble() && canKickBall(robot)) {
+        holdBall(robot);
+    }
+}
+
+void KinematicWorld::holdBall(const Robot &robot)
+{
+    // the ball moves with the dribbler, including the rotation of the robot
+    const btVector3 offset = forward(robot) * (frontDistance(robot) + BALL_RADIUS);
+    m_ballPos = robot.pos + offset;
+    m_ballPos.setZ(0);
+    m_ballV = robot.v + btVector3(0, 0, robot.omega).cross(offset);
+    m_ballSwitchSpeed = 0;
+    m_ballHeld = true;
+}
+
+bool KinematicWorld::canKickBall(const Robot &robot) const
+{
+    // can't kick jumping ball
+    if (m_ballPos.z() > 0.05f - BALL_RADIUS) {
+        return false;
+    }
+    const btVector3 f = forward(robot);
+    const btVector3 d = btVector3(m_ballPos.x(), m_ballPos.y(), 0) - robot.pos;
+    const float front = d.dot(f) - frontDistance(robot) - BALL_RADIUS;
+    const float side = d.dot(btVector3(f.y(), -f.x(), 0));
+    const float DRIBBLER_TOLERANCE = 0.01f;
+    return std::abs(front) < DRIBBLER_TOLERANCE
+            && std::abs(side) < robot.specs.radius() * std::sin(robot.specs.angle() / 2.0f);
+}
+
+void KinematicWorld::collideRobots()
+{
+    std::vector<Robot *> robots;
+    robots.reserve(m_blue.size() + m_yellow.size());
+    for (Robot &robot : m_blue) {
+        robots.push_back(&robot);
+    }
+    for (Robot &robot : m_yellow) {
+        robots.push_back(&robot);
+    }
+
+    // inelastic collisions between circles, both robots are pushed apart evenly
+    for (std::size_t i = 0; i < robots.size(); i++) {
+        for (std::size_t j = i + 1; j < robots.size(); j++) {
+            Robot &a = *robots[i];
+            Robot &b = *robots[j];
+            const btVector3 d = b.pos - a.pos;
+            const float dist = d.length();
+            const float minDist = a.specs.radius() + b.specs.radius();
+            if (dist >= minDist || dist < 1E-6f) {
+                continue;
+            }
+            const btVector3 normal = d / dist;
+            const float correction = (minDist - dist) / 2;
+            a.pos -= normal * correction;
+            b.pos += normal * correction;
+            const float approach = (b.v - a.v).dot(normal);
+            if (approach < 0) {
+                a.v += normal * (approach / 2);
+                b.v -= normal * (approach / 2);
+            }
+        }
+    }
+}
+
+void KinematicWorld::stepBall(double time)
+{
+    if (m_ballHeld) {
+        return;
+    }
+
+    if (m_ballPos.z() > 0 || m_ballV.z() > 0) {
+        m_ballV.setZ(m_ballV.z() - GRAVITY * time);
+        m_ballPos += m_ballV * time;
+        if (m_ballPos.z() <= 0) {
+            m_ballPos.setZ(0);
+            float vz = -m_ballV.z() * BALL_DAMPING_Z;
+            if (vz < BALL_MIN_BOUNCE_SPEED) {
+                vz = 0;
+            }
+            const float dampingXY = m_ballBounced ? 1.0f : BALL_DAMPING_XY_FIRST_HOP;
+            m_ballV = btVector3(m_ballV.x() * dampingXY, m_ballV.y() * dampingXY, vz);
+            m_ballBounced = true;
+            // the ball does no longer slide after a chip
+            m_ballSwitchSpeed = 0;
+        }
+    } else {
+        const float speed = m_ballV.length();
+        if (speed < 0.01f) {
+            // the real ball snaps to a dimple
+            m_ballV = btVector3(0, 0, 0);
+        } else {
+            const float deceleration = speed > m_ballSwitchSpeed ? BALL_SLIDE_DECELERATION : BALL_ROLL_DECELERATION;
+            m_ballV *= std::max(0.0f, speed - deceleration * float(time)) / speed;
+            m_ballPos += m_ballV * time;
+        }
+    }
+
+    limitToField(m_ballPos, m_ballV, BALL_RADIUS, BALL_WALL_RESTITUTION);
+    // the goal is a box behind the goal line
+    if (std::abs(m_ballPos.y()) > m_goalLine && std::abs(m_ballPos.x()) < m_goalWidthHalf) {
+        const float back = m_goalLine + m_goalDepth - BALL_RADIUS;
+        if (std::abs(m_ballPos.y()) > back) {
+            m_ballPos.setY(std::copysign(back, m_ballPos.y()));
+            m_ballV.setY(-m_ballV.y() * BALL_WALL_RESTITUTION);
+        }
+    }
+}
+
+void KinematicWorld::collideBall(Robot &robot)
+{
+    if (m_ballPos.z() > robot.specs.height()) {
+        return;
+    }
+    const btVector3 f = forward(robot);
+    const btVector3 d = btVector3(m_ballPos.x(), m_ballPos.y(), 0) - robot.pos;
+    const float along = d.dot(f);
+    const float side = d.dot(btVector3(f.y(), -f.x(), 0));
+    const float front = frontDistance(robot);
+
+    btVector3 normal;
+    float penetration;
+    if (along > front && std::abs(side) < robot.specs.radius() * std::sin(robot.specs.angle() / 2.0f)) {
+        // flat front of the robot
+        normal = f;
+        penetration = front + BALL_RADIUS - along;
+    } else {
+        const float dist = d.length();
+        if (dist < 1E-6f) {
+            return;
+        }
+        normal = d / dist;
+        penetration = robot.specs.radius() + BALL_RADIUS - dist;
+    }
+    if (penetration < 0) {
+        return;
+    }
+    robot.touchesBall = true;
+    if (m_ballHeld) {
+        return;
+    }
+
+    m_ballPos += normal * penetration;
+    const btVector3 contact = normal * robot.specs.radius();
+    const btVector3 robotV = robot.v + btVector3(0, 0, robot.omega).cross(contact);
+    const float approach = (m_ballV - robotV).dot(normal);
+    if (approach < 0) {
+        m_ballV -= normal * ((1 + BALL_ROBOT_RESTITUTION) * approach);
+        m_ballSwitchSpeed = 0;
+    }
+}
+
+void KinematicWorld::limitToField(btVector3 &pos, btVector3 &v, float radius, float restitution) const
+{
+    const float limits[2] = { m_halfWidth - radius, m_halfHeight - radius };
+    for (int axis = 0; axis < 2; axis++) {
+        if (std::abs(pos[axis]) > limits[axis]) {
+            pos[axis] = std::copysign(limits[axis], pos[axis]);
+            if (v[axis] * pos[axis] > 0) {
+                v[axis] *= -restitution;
+            }
+        }
+    }
+}
+
+void KinematicWorld::clearTeam(bool isBlue)
+{
+    robots(isBlue).clear();
+}
+
+void KinematicWorld::addRobot(bool isBlue, const robot::Specs &specs, const btVector3 &pos, float phi)
+{
+    Robot robot;
+    robot.specs.CopyFrom(specs);
+    robot.pos = btVector3(pos.x(), pos.y(), 0);
+    robot.v = btVector3(0, 0, 0);
+    robot.phi = phi;
+    robots(isBlue)[specs.id()] = robot;
+}
+
+void KinematicWorld::removeRobot(bool isBlue, uint32_t id)
+{
+    robots(isBlue).remove(id);
+}
+
+bool KinematicWorld::hasRobot(bool isBlue, uint32_t id) const
+{
+    return (isBlue ? m_blue : m_yellow).contains(id);
+}
+
+robot::RadioResponse KinematicWorld::setCommand(bool isBlue, const sslsim::RobotCommand &command, bool charge, float rxLoss, float txLoss)
+{
+    robot::RadioResponse response;
+    auto it = robots(isBlue).find(command.id());
+    if (it == robots(isBlue).end()) {
+        return response;
+    }
+    Robot &robot = *it;
+    robot.command = command;
+    robot.commandTime = 0;
+    robot.charge = charge;
+
+    response.set_generation(robot.specs.generation());
+    response.set_id(robot.specs.id());
+    response.set_battery(1);
+    response.set_packet_loss_rx(rxLoss);
+    response.set_packet_loss_tx(txLoss);
+    response.set_ball_detected(canKickBall(robot));
+    response.set_cap_charged(robot.isCharged);
+
+    const btVector3 f = forward(robot);
+    robot::SpeedStatus *speedStatus = response.mutable_estimated_speed();
+    speedStatus->set_v_f(robot.v.dot(f));
+    speedStatus->set_v_s(robot.v.dot(btVector3(f.y(), -f.x(), 0)));
+    speedStatus->set_omega(robot.omega);
+    return response;
+}
+
+void KinematicWorld::moveRobot(bool isBlue, const sslsim::TeleportRobot &move)
+{
+    auto it = robots(isBlue).find(move.id().id());
+    if (it == robots(isBlue).end()) {
+        return;
+    }
+    Robot &robot = *it;
+    // moving by force is just a teleport, there are no forces in here
+    if (move.has_x() && move.has_y()) {
+        coordinates::fromVision(move, robot.pos);
+        robot.pos.setZ(0);
+    }
+    if (move.has_orientation()) {
+        robot.phi = coordinates::fromVisionRotation(move.orientation()) - M_PI_2;
+    }
+    if (move.has_v_x() && move.has_v_y()) {
+        coordinates::fromVisionVelocity(move, robot.v);
+        robot.v.setZ(0);
+    } else if (move.by_force()) {
+        robot.v = btVector3(0, 0, 0);
+    }
+    if (move.has_v_angular()) {
+        robot.omega = move.v_angular();
+    }
+}
+
+void KinematicWorld::moveBall(const sslsim::TeleportBall &ball)
+{
+    if (ball.has_x() && ball.has_y()) {
+        Vector pos;
+        coordinates::fromVision(ball, pos);
+        m_ballPos = btVector3(pos.x, pos.y, ball.has_z() ? std::max(0.0f, ball.z()) : 0.0f);
+    }
+    if (ball.has_vx() && ball.has_vy()) {
+        Vector vel;
+        coordinates::fromVisionVelocity(ball, vel);
+        const float vz = ball.has_vz() ? ball.vz() * 1e-3f : 0.0f;
+        m_ballV = btVector3(vel.x, vel.y, vz);
+        m_ballSwitchSpeed = ball.roll() ? 0 : BALL_SWITCH_RATIO * m_ballV.length();
+        m_ballBounced = false;
+    } else if (ball.by_force()) {
+        m_ballV = btVector3(0, 0, 0);
+    }
+}
+
+void KinematicWorld::clearAround(const btVector3 &pos)
+{
+    // remove the speed of all robots in this radius to avoid them running over the ball
+    const float STOP_ROBOTS_RADIUS = 1.5f;
+    for (bool isBlue : {true, false}) {
+        for (Robot &robot : robots(isBlue)) {
+            btVector3 d = robot.pos - btVector3(pos.x(), pos.y(), 0);
+            const float minDist = robot.specs.radius() + BALL_RADIUS;
+            if (d.length() < minDist) {
+                if (d.length() < 1E-6f) {
+                    d = btVector3(1, 0, 0);
+                }
+                robot.pos += d.normalized() * (minDist - d.length());
+            }
+            if (d.length() < STOP_ROBOTS_RADIUS + robot.specs.radius()) {
+                robot.v = btVector3(0, 0, 0);
+            }
+        }
+    }
+}
+
+void KinematicWorld::restoreState(const world::SimulatorState &state)
+{
+    if (state.has_ball()) {
+        const world::SimBall &ball = state.ball();
+        m_ballPos = btVector3(ball.p_x(), ball.p_y(), std::max(0.0f, ball.p_z() - BALL_RADIUS));
+        m_ballV = btVector3(ball.v_x(), ball.v_y(), ball.v_z());
+    }
+    const auto restoreRobots = [](QMap<uint32_t, Robot> &map, const auto &robots) {
+        for (const world::SimRobot &state : robots) {
+            auto it = map.find(state.id());
+            if (it == map.end()) {
+                continue;
+            }
+            it->pos = btVector3(state.p_x(), state.p_y(), 0);
+            it->phi = 2 * std::atan2(state.rotation().k(), state.rotation().real());
+            it->v = btVector3(state.v_x(), state.v_y(), 0);
+            it->omega = state.r_z();
+        }
+    };
+    restoreRobots(m_blue, state.blue_robots());
+    restoreRobots(m_yellow, state.yellow_robots());
+}
+
+btVector3 KinematicWorld::ballPosition() const
+{
+    return m_ballPos + btVector3(0, 0, BALL_RADIUS);
+}
+
+void KinematicWorld::writeBallState(world::SimBall *ball) const
+{
+    const btVector3 pos = ballPosition();
+    ball->set_p_x(pos.x());
+    ball->set_p_y(pos.y());
+    ball->set_p_z(pos.z());
+    ball->set_v_x(m_ballV.x());
+    ball->set_v_y(m_ballV.y());
+    ball->set_v_z(m_ballV.z());
+}
+
+void KinematicWorld::writeRobotState(const Robot &robot, world::SimRobot *state) const
+{
+    state->set_id(robot.specs.id());
+    state->set_p_x(robot.pos.x());
+    state->set_p_y(robot.pos.y());
+    state->set_p_z(robot.specs.height() / 2.0f);
+
+    world::Quaternion *rotation = state->mutable_rotation();
+    rotation->set_i(0);
+    rotation->set_j(0);
+    rotation->set_k(std::sin(robot.phi / 2));
+    rotation->set_real(std::cos(robot.phi / 2));
+
+    state->set_v_x(robot.v.x());
+    state->set_v_y(robot.v.y());
+    state->set_v_z(0);
+    state->set_r_x(0);
+    state->set_r_y(0);
+    state->set_r_z(robot.omega);
+    state->set_touches_ball(robot.touchesBall);
+}
+
+void KinematicWorld::writeDetection(Robot &robot, SSL_DetectionRobot *detection, float stddevP, float stddevPhi, qint64 time,
+                                    const btVector3 &positionOffset) const
+{
+    detection->set_robot_id(robot.specs.id());
+    detection->set_confidence(1.0);
+    detection->set_pixel_x(0);
+    detection->set_pixel_y(0);
+
+    const btVector3 p = robot.pos + positionOffset;
+    const Vector noise = m_rng->normalVector(stddevP);
+    detection->set_x((p.y() + noise.x) * 1000.0f);
+    detection->set_y(-(p.x() + noise.y) * 1000.0f);
+    detection->set_orientation(robot.phi + m_rng->normal(stddevPhi));
+
+    robot.lastSendTime = time;
+}
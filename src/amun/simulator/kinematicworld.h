@@ -0,0 +1,119 @@
+/***************************************************************************
+ *   Copyright 2015 Michael Eischer, Philipp Nordhus                       *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef KINEMATICWORLD_H
+#define KINEMATICWORLD_H
+
+#include "protobuf/robot.pb.h"
+#include "protobuf/sslsim.h"
+#include "protobuf/world.pb.h"
+#include <QMap>
+#include <btBulletDynamicsCommon.h>
+
+class RNG;
+class SSL_DetectionRobot;
+
+namespace camun {
+    namespace simulator {
+        class KinematicWorld;
+    }
+}
+
+// Lightweight replacement for the bullet world, robots are circles with a flat front
+// and the ball is a point mass with a simple rolling, flight and bounce model.
+// Kicking and dribbling use the same commands and limits as SimRobot.
+// Used for strategy level tests which only need plausible motion, but lots of it.
+// All positions are in the simulator coordinate system, but without SIMULATOR_SCALE.
+class camun::simulator::KinematicWorld
+{
+public:
+    struct Robot
+    {
+        robot::Specs specs;
+        btVector3 pos;
+        btVector3 v;
+        // direction of the local x axis, the robot drives forward along the local y axis
+        float phi = 0;
+        float omega = 0;
+        sslsim::RobotCommand command;
+        double commandTime = 0;
+        bool charge = false;
+        bool isCharged = false;
+        double shootTime = 0;
+        bool touchesBall = false;
+        qint64 lastSendTime = 0;
+    };
+
+    KinematicWorld(RNG *rng, const world::Geometry &geometry);
+    KinematicWorld(const KinematicWorld&) = delete;
+    KinematicWorld& operator=(const KinematicWorld&) = delete;
+
+    void step(double time);
+
+    void clearTeam(bool isBlue);
+    void addRobot(bool isBlue, const robot::Specs &specs, const btVector3 &pos, float phi);
+    void removeRobot(bool isBlue, uint32_t id);
+    bool hasRobot(bool isBlue, uint32_t id) const;
+    QMap<uint32_t, Robot> &robots(bool isBlue) { return isBlue ? m_blue : m_yellow; }
+
+    // returns an uninitialized response if the robot does not exist
+    robot::RadioResponse setCommand(bool isBlue, const sslsim::RobotCommand &command, bool charge, float rxLoss, float txLoss);
+    void moveRobot(bool isBlue, const sslsim::TeleportRobot &robot);
+    void moveBall(const sslsim::TeleportBall &ball);
+    // moves robots out of the way and stops the ones close to pos
+    void clearAround(const btVector3 &pos);
+    void restoreState(const world::SimulatorState &state);
+
+    // ball center, z is the height of the center above the ground
+    btVector3 ballPosition() const;
+    void writeBallState(world::SimBall *ball) const;
+    void writeRobotState(const Robot &robot, world::SimRobot *state) const;
+    void writeDetection(Robot &robot, SSL_DetectionRobot *detection, float stddevP, float stddevPhi, qint64 time, const btVector3 &positionOffset) const;
+
+private:
+    void stepRobot(Robot &robot, double time);
+    void collideRobots();
+    void stepBall(double time);
+    void collideBall(Robot &robot);
+    void holdBall(const Robot &robot);
+    bool canKickBall(const Robot &robot) const;
+    // distance of the flat front from the robot center
+    static float frontDistance(const Robot &robot);
+    static btVector3 forward(const Robot &robot);
+    void limitToField(btVector3 &pos, btVector3 &v, float radius, float restitution) const;
+
+    RNG *m_rng;
+    float m_halfWidth;
+    float m_halfHeight;
+    float m_goalWidthHalf;
+    float m_goalLine;
+    float m_goalDepth;
+    QMap<uint32_t, Robot> m_blue;
+    QMap<uint32_t, Robot> m_yellow;
+    // the z component is the height of the ball bottom above the ground
+    btVector3 m_ballPos;
+    btVector3 m_ballV;
+    // the ball slides until it is slower than this speed, afterwards it rolls
+    float m_ballSwitchSpeed = 0;
+    bool m_ballBounced = false;
+    bool m_ballHeld = false;
+};
+
+#endif // KINEMATICWORLD_H
@@ -28,6 +28,7 @@
 #include "simfield.h"
 #include "simrobot.h"
 #include "erroraggregator.h"
+#include "kinematicworld.h"
 #include <QTimer>
 #include <algorithm>
 #include <QtDebug>
@@ -75,6 +76,8 @@ struct camun::simulator::SimulatorData
     QVector<btVector3> cameraPositions;
     SimField *field;
     SimBall *ball;
+    // replaces the bullet world for robots and ball if set
+    KinematicWorld *kinematic = nullptr;
     Simulator::RobotMap robotsBlue;
     Simulator::RobotMap robotsYellow;
     QMap<uint32_t, robot::Specs> specsBlue;
@@ -153,6 +156,9 @@ Simulator::Simulator(const Timer *timer, const amun::SimulatorSetup &setup, bool
     m_data->field = new SimField(m_data->dynamicsWorld, m_data->geometry);
     m_data->ball = new SimBall(&m_data->rng, m_data->dynamicsWorld);
     connect(m_data->ball, &SimBall::sendSSLSimError, m_aggregator, &ErrorAggregator::aggregate);
+    if (setup.backend() == amun::SimulatorSetup::Kinematic) {
+        m_data->kinematic = new KinematicWorld(&m_data->rng, m_data->geometry);
+    }
     m_data->flip = false;
     m_data->stddevBall = 0.0f;
     m_data->stddevBallArea = 0.0f;
@@ -189,6 +195,7 @@ Simulator::~Simulator()
 
     deleteAll(m_data->robotsBlue);
     deleteAll(m_data->robotsYellow);
+    delete m_data->kinematic;
     delete m_data->ball;
     delete m_data->field;
     delete m_data->dynamicsWorld;
@@ -231,9 +238,15 @@ void Simulator::process()
             auto time = m_time;
             auto charge = m_charge;
             auto fabricateResponse = [data, &responses, time, charge, &id, &command](const Simulator::RobotMap& map, const bool* isBlue) {
-                if (!map.contains(id)) return;
-                robot::RadioResponse response = map[id].first->setCommand(command, data->ball, charge,
-                                                                                   data->robotCommandPacketLoss, data->robotReplyPacketLoss);
+                robot::RadioResponse response;
+                if (data->kinematic) {
+                    if (!data->kinematic->hasRobot(*isBlue, id)) return;
+                    response = data->kinematic->setCommand(*isBlue, command, charge, data->robotCommandPacketLoss, data->robotReplyPacketLoss);
+                } else {
+                    if (!map.contains(id)) return;
+                    response = map[id].first->setCommand(command, data->ball, charge,
+                                                         data->robotCommandPacketLoss, data->robotReplyPacketLoss);
+                }
                 response.set_time(time);
 
                 if (isBlue != nullptr) {
@@ -265,12 +278,18 @@ void Simulator::process()
 
     // simulate to current strategy time
     double timeDelta = (current_time - m_time) * 1E-9;
-    m_data->dynamicsWorld->stepSimulation(timeDelta, 10, SUB_TIMESTEP);
+    if (m_data->kinematic) {
+        m_data->kinematic->step(timeDelta);
+    } else {
+        m_data->dynamicsWorld->stepSimulation(timeDelta, 10, SUB_TIMESTEP);
+    }
     m_time = current_time;
 
     // only send a vision packet every third frame = 15 ms - epsilon (=half frame)
-    // gives a vision frequency of 66.67Hz
-    if (m_lastSentStatusTime + 12500000 <= m_time) {
+    // gives a vision frequency of 66.67Hz, consumers may request a lower rate
+    // nothing is generated if there is nobody interested in the vision output
+    const bool visionFrame = (m_sendTruth || m_sendDetections) && m_lastSentStatusTime + m_visionInterval <= m_time;
+    if (visionFrame) {
         auto data = createVisionPacket();
 
 
@@ -298,6 +317,12 @@ void Simulator::process()
     // send timing information
     Status status(new amun::Status);
     status->mutable_timing()->set_simulator((Timer::systemTime() - start_time) * 1E-9f);
+    if (visionFrame && m_sendTruth) {
+        status->mutable_timing()->set_simulator_truth(m_truthTiming * 1E-9f);
+    }
+    if (visionFrame && m_sendDetections) {
+        status->mutable_timing()->set_simulator_detections(m_detectionTiming * 1E-9f);
+    }
     emit sendStatus(status);
 }
 
@@ -400,27 +425,76 @@ static btVector3 positionOffsetForCamera(float offsetStrength, btVector3 cameraP
     return btVector3(cameraPos.x(), cameraPos.y(), 0).normalized() * offsetStrength;
 }
 
-std::tuple<QList<QByteArray>, QByteArray, qint64> Simulator::createVisionPacket()
+std::tuple<QList<QByteArray>, SimulatorTruth, qint64> Simulator::createVisionPacket()
+{
+    SimulatorTruth simState;
+    QList<QByteArray> data;
+
+    if (m_sendTruth) {
+        const qint64 start = Timer::systemTime();
+        simState = createTruth();
+        m_truthTiming = Timer::systemTime() - start;
+    }
+    if (m_sendDetections) {
+        const qint64 start = Timer::systemTime();
+        data = createDetections();
+        m_detectionTiming = Timer::systemTime() - start;
+    }
+
+    return {data, simState, 0};
+}
+
+SimulatorTruth Simulator::createTruth() const
+{
+    // the ground truth is passed on without serializing it
+    QSharedPointer<world::SimulatorState> simState(new world::SimulatorState);
+    simState->set_time(m_time);
+
+    if (m_data->kinematic) {
+        m_data->kinematic->writeBallState(simState->mutable_ball());
+        for (bool teamIsBlue : {true, false}) {
+            for (const KinematicWorld::Robot &robot : m_data->kinematic->robots(teamIsBlue)) {
+                auto* robotProto = teamIsBlue ? simState->add_blue_robots() : simState->add_yellow_robots();
+                m_data->kinematic->writeRobotState(robot, robotProto);
+            }
+        }
+        return simState;
+    }
+
+    m_data->ball->writeBallState(simState->mutable_ball());
+    for (bool teamIsBlue : {true, false}) {
+        const auto &team = teamIsBlue ? m_data->robotsBlue : m_data->robotsYellow;
+        for (const auto& it : team) {
+            auto* robotProto = teamIsBlue ? simState->add_blue_robots() : simState->add_yellow_robots();
+            it.first->update(robotProto, m_data->ball);
+        }
+    }
+    return simState;
+}
+
+bool Simulator::isCameraEnabled(std::size_t cameraId) const
+{
+    return m_detectionCameras.isEmpty() || m_detectionCameras.contains(cameraId);
+}
+
+QList<QByteArray> Simulator::createDetections()
 {
     const std::size_t numCameras = m_data->reportedCameraSetup.size();
-    world::SimulatorState simState;
-    simState.set_time(m_time);
 
     std::vector<SSL_DetectionFrame> detections(numCameras);
     for (std::size_t i = 0;i<numCameras;i++) {
-        initializeDetection(&detections[i], i);
+        if (isCameraEnabled(i)) {
+            initializeDetection(&detections[i], i);
+        }
     }
 
-    auto* ball = simState.mutable_ball();
-    m_data->ball->writeBallState(ball);
-
-    const btVector3 ballPosition = m_data->ball->position() / SIMULATOR_SCALE;
+    const btVector3 ballPosition = m_data->kinematic ? m_data->kinematic->ballPosition() : m_data->ball->position() / SIMULATOR_SCALE;
     if (m_time - m_lastBallSendTime >= m_minBallDetectionTime) {
         m_lastBallSendTime = m_time;
 
         for (std::size_t cameraId = 0; cameraId < numCameras; ++cameraId) {
             // at least one id is always valid
-            if (!checkCameraID(cameraId, ballPosition, m_data->cameraPositions, m_data->cameraOverlap)) {
+            if (!isCameraEnabled(cameraId) || !checkCameraID(cameraId, ballPosition, m_data->cameraPositions, m_data->cameraOverlap)) {
                 continue;
             }
 
@@ -431,6 +505,12 @@ std::tuple<QList<QByteArray>, QByteArray, qint64> Simulator::createVisionPacket(
 
             // get ball position
             const btVector3 positionOffset = positionOffsetForCamera(m_data->objectPositionOffset, m_data->cameraPositions[cameraId]);
+            if (m_data->kinematic) {
+                // there is no 3D geometry to check the ball visibility against
+                m_data->ball->addDetection(detections[cameraId].add_balls(), ballPosition, m_data->stddevBall, m_data->stddevBallArea,
+                                           m_data->cameraPositions[cameraId], false, 0, positionOffset);
+                continue;
+            }
             bool visible = m_data->ball->update(detections[cameraId].add_balls(), m_data->stddevBall, m_data->stddevBallArea, m_data->cameraPositions[cameraId],
                     m_data->enableInvisibleBall, m_data->ballVisibilityThreshold, positionOffset);
             if (!visible) {
@@ -440,21 +520,43 @@ std::tuple<QList<QByteArray>, QByteArray, qint64> Simulator::createVisionPacket(
     }
 
     // get robot positions
+    if (m_data->kinematic) {
+        // the kinematic robots have no dribbler corners, so there are no ball mis-detections
+        for (bool teamIsBlue : {true, false}) {
+            for (KinematicWorld::Robot &robot : m_data->kinematic->robots(teamIsBlue)) {
+                if (m_time - robot.lastSendTime < m_minRobotDetectionTime) {
+                    continue;
+                }
+                for (std::size_t cameraId = 0; cameraId < numCameras; ++cameraId) {
+                    if (!isCameraEnabled(cameraId) || !checkCameraID(cameraId, robot.pos, m_data->cameraPositions, m_data->cameraOverlap)) {
+                        continue;
+                    }
+
+                    bool missingRobot = m_data->missingRobotDetections > 0 && m_data->rng.uniformFloat(0, 1) <= m_data->missingRobotDetections;
+                    if (missingRobot) {
+                        continue;
+                    }
+
+                    const btVector3 positionOffset = positionOffsetForCamera(m_data->objectPositionOffset, m_data->cameraPositions[cameraId]);
+                    auto* detection = teamIsBlue ? detections[cameraId].add_robots_blue() : detections[cameraId].add_robots_yellow();
+                    m_data->kinematic->writeDetection(robot, detection, m_data->stddevRobot, m_data->stddevRobotPhi, m_time, positionOffset);
+                }
+            }
+        }
+    }
+
     for (bool teamIsBlue : {true, false}) {
         auto &team = teamIsBlue ? m_data->robotsBlue : m_data->robotsYellow;
 
         for (const auto& it : team) {
             SimRobot* robot = it.first;
-            auto* robotProto = teamIsBlue ? simState.add_blue_robots() : simState.add_yellow_robots();
-            robot->update(robotProto, m_data->ball);
-
             if (m_time - robot->getLastSendTime() >= m_minRobotDetectionTime) {
                 const float timeDiff = (m_time - robot->getLastSendTime()) * 1E-9;
                 const btVector3 robotPos = robot->position() / SIMULATOR_SCALE;
 
                 for (std::size_t cameraId = 0; cameraId < numCameras; ++cameraId) {
 
-                    if (!checkCameraID(cameraId, robotPos, m_data->cameraPositions, m_data->cameraOverlap)) {
+                    if (!isCameraEnabled(cameraId) || !checkCameraID(cameraId, robotPos, m_data->cameraPositions, m_data->cameraOverlap)) {
                         continue;
                     }
 
@@ -490,7 +592,11 @@ std::tuple<QList<QByteArray>, QByteArray, qint64> Simulator::createVisionPacket(
 
     // add a wrapper packet for all detections (also for empty ones).
     // The reason is that other teams might rely on the fact that these detections are in regular intervals.
-    for (auto &frame : detections) {
+    for (std::size_t cameraId = 0; cameraId < numCameras; ++cameraId) {
+        if (!isCameraEnabled(cameraId)) {
+            continue;
+        }
+        SSL_DetectionFrame &frame = detections[cameraId];
 
         // if multiple balls are reported, shuffle them randomly (the tracking might have systematic errors depending on the ball order)
         if (frame.balls_size() > 1) {
@@ -541,12 +647,7 @@ std::tuple<QList<QByteArray>, QByteArray, qint64> Simulator::createVisionPacket(
         }
     }
 
-    QByteArray d;
-    d.resize(simState.ByteSize());
-    if (!simState.SerializeToArray(d.data(), d.size())) {
-        d = {};
-    }
-    return {data,d, 0};
+    return data;
 }
 
 void Simulator::sendVisionPacket()
@@ -557,7 +658,9 @@ void Simulator::sendVisionPacket()
         // the receive time may be a bit jittered just like a real transmission
 
     }
-    emit sendRealData(std::get<1>(currentVisionPackets));
+    if (!std::get<1>(currentVisionPackets).isNull()) {
+        emit sendRealData(std::get<1>(currentVisionPackets));
+    }
     if (!m_isPartial) {
         QTimer *timer = m_visionTimers.dequeue();
         timer->deleteLater();
@@ -582,6 +685,10 @@ void Simulator::setTeam(Simulator::RobotMap &list, float side, const robot::Team
     // remove old team
     deleteAll(list);
     list.clear();
+    const bool isBlue = &list == &m_data->robotsBlue;
+    if (m_data->kinematic) {
+        m_data->kinematic->clearTeam(isBlue);
+    }
 
     // changing a team is also triggering a tracking reset
     // thus the old robots will disappear immediatelly
@@ -606,9 +713,15 @@ void Simulator::setTeam(Simulator::RobotMap &list, float side, const robot::Team
         }
         teamSpecs[id].CopyFrom(specs);
 
-
-
-        createRobot(list, x, side * y, id, m_aggregator, m_data, teamSpecs);
+        if (m_data->kinematic) {
+            if (m_data->kinematic->hasRobot(isBlue, id)) {
+                std::cerr << "Error: Two ids for the same color, aborting!" << std::endl;
+                continue;
+            }
+            m_data->kinematic->addRobot(isBlue, teamSpecs[id], btVector3(x, side * y, 0), 0.f);
+        } else {
+            createRobot(list, x, side * y, id, m_aggregator, m_data, teamSpecs);
+        }
         y -= 0.3;
     }
 }
@@ -646,6 +759,10 @@ void Simulator::moveBall(const sslsim::TeleportBall& ball)
         safelyTeleportBall(b.x(), b.y());
     }
 
+    if (m_data->kinematic) {
+        m_data->kinematic->moveBall(b);
+        return;
+    }
     m_data->ball->move(b);
 
 }
@@ -656,7 +773,8 @@ void Simulator::moveRobot(const sslsim::TeleportRobot &robot) {
     bool is_blue = robot.id().team() == gameController::Team::BLUE;
 
     RobotMap& list = is_blue ? m_data->robotsBlue : m_data->robotsYellow;
-    bool isPresent = list.contains(robot.id().id());
+    KinematicWorld* kinematic = m_data->kinematic;
+    bool isPresent = kinematic ? kinematic->hasRobot(is_blue, robot.id().id()) : list.contains(robot.id().id());
     QMap<uint32_t, robot::Specs>& teamSpecs = is_blue ? m_data->specsBlue : m_data->specsYellow;
     if (robot.has_present()) {
         if (robot.present() && !isPresent) {
@@ -679,11 +797,19 @@ void Simulator::moveRobot(const sslsim::TeleportRobot &robot) {
                 Vector targetPos;
                 coordinates::fromVision(robot, targetPos);
                 //TODO: check if the given position is fine
-                createRobot(list, targetPos.x, targetPos.y, robot.id().id(), m_aggregator, m_data, teamSpecs);
+                if (kinematic) {
+                    kinematic->addRobot(is_blue, teamSpecs[robot.id().id()], btVector3(targetPos.x, targetPos.y, 0), 0.f);
+                } else {
+                    createRobot(list, targetPos.x, targetPos.y, robot.id().id(), m_aggregator, m_data, teamSpecs);
+                }
             }
         }
         else if (!robot.present() && isPresent) {
             //remove the robot
+            if (kinematic) {
+                kinematic->removeRobot(is_blue, robot.id().id());
+                return;
+            }
             auto val = list.take(robot.id().id());
             val.first->stopDribbling();
             delete val.first;
@@ -697,7 +823,9 @@ void Simulator::moveRobot(const sslsim::TeleportRobot &robot) {
         if (!isPresent) return;
     }
 
-    if (!list.contains(robot.id().id())) return; // Recheck the list in case the has_present paragraph did change it.
+    if (kinematic) {
+        if (!kinematic->hasRobot(is_blue, robot.id().id())) return;
+    } else if (!list.contains(robot.id().id())) return; // Recheck the list in case the has_present paragraph did change it.
 
 
     sslsim::TeleportRobot r = robot;
@@ -709,6 +837,10 @@ void Simulator::moveRobot(const sslsim::TeleportRobot &robot) {
         FLIP(r, v_y);
     }
 
+    if (kinematic) {
+        kinematic->moveRobot(is_blue, r);
+        return;
+    }
     SimRobot* sim_robot = list[robot.id().id()].first;
     if (!r.has_by_force() || !r.by_force()) {
         sim_robot->stopDribbling();
@@ -816,6 +948,23 @@ void Simulator::handleCommand(const Command &command)
             }
         }
 
+        if (sim.has_vision_output()) {
+            const amun::SimulatorVisionOutput &output = sim.vision_output();
+            if (output.has_ground_truth()) {
+                m_sendTruth = output.ground_truth();
+            }
+            if (output.has_detections()) {
+                m_sendDetections = output.detections();
+            }
+            m_detectionCameras.clear();
+            for (uint32_t cameraId : output.camera_id()) {
+                m_detectionCameras.append(cameraId);
+            }
+            if (output.has_min_frame_interval()) {
+                m_visionInterval = std::max(DEFAULT_VISION_INTERVAL, qint64(output.min_frame_interval() * 1E9));
+            }
+        }
+
         if (sim.has_vision_worst_case()) {
             if (sim.vision_worst_case().has_min_ball_detection_time()) {
                 m_minBallDetectionTime = sim.vision_worst_case().min_ball_detection_time() * 1E9;
@@ -826,6 +975,9 @@ void Simulator::handleCommand(const Command &command)
         }
 
         if (sim.has_set_simulator_state()) {
+            if (m_data->kinematic) {
+                m_data->kinematic->restoreState(sim.set_simulator_state());
+            }
             if (sim.set_simulator_state().has_ball()) {
                 m_data->ball->restoreState(sim.set_simulator_state().ball());
             }
@@ -946,6 +1098,10 @@ void Simulator::safelyTeleportBall(const float x, const float y)
     const float STOP_ROBOTS_RADIUS = 1.5f;
 
     btVector3 newBallPos(x, y, 0);
+    if (m_data->kinematic) {
+        m_data->kinematic->clearAround(newBallPos);
+        return;
+    }
     for (const auto& robotList : {m_data->robotsBlue, m_data->robotsYellow}) {
         for (const auto& it : robotList) {
             SimRobot* robot = it.first;
@@ -24,6 +24,8 @@
 
 #include "gamecontroller/strategygamecontrollermediator.h"
 #include "protobuf/command.h"
+#include "protobuf/debugstringtable.h"
+#include "protobuf/imagevisualization.h"
 #include "protobuf/robotcommand.h"
 #include "protobuf/status.h"
 #include "strategy/script/scriptstate.h"
@@ -95,6 +97,7 @@ private:
     void fail(const QString &error, const amun::UserInput & userInput = amun::UserInput(), double pathPlanning = 0, double totalTime = 0);
     void setStrategyStatus(Status &status, amun::StatusStrategy::STATE state);
     Status takeStrategyDebugStatus();
+    void compactDebugOutput(Status &status);
     amun::DebugSource debugSource() const;
     void createDummyTeam();
     bool updateTeam(const robot::Team &team, StrategyType teamType, bool isReplayTeam);
@@ -108,6 +111,9 @@ private:
     world::Geometry m_geometry;
     robot::Team m_team;
     Status m_debugStatus;
+    DebugStringInterner m_debugStrings;
+    int m_debugStringsSource = -1;
+    ImageVisualizationEncoder m_imageEncoder;
     const StrategyType m_type;
     ScriptState m_scriptState;
     qint64 m_lastReplayTime = 0;
@@ -308,8 +308,8 @@ Lua::Lua(const Timer *timer, StrategyType type, ScriptState& scriptState, bool d
 
     // create file system watcher
     m_watcher = new FileWatcher(this);
-    connect(m_watcher, SIGNAL(fileChanged(QString)), SIGNAL(requestReload()));
-    connect(m_watcher, SIGNAL(fileChanged(QString)), SLOT(requestRecording()));
+    connect(m_watcher, SIGNAL(filesChanged(QStringList)), SIGNAL(requestReload()));
+    connect(m_watcher, SIGNAL(filesChanged(QStringList)), SLOT(requestRecording()));
 
     // timeout hook
     lua_sethook(m_state, luaDebugHook, LUA_MASKCOUNT, 1000000);
@@ -162,6 +162,14 @@ static int amunLog(lua_State *state)
 static int amunAddVisualization(lua_State *state)
 {
     Lua *thread = getStrategyThread(state);
+    if (lua_istable(state, 1)) {
+        lua_getfield(state, 1, "name");
+        const bool enabled = !lua_isstring(state, -1) || thread->isVisualizationEnabled(lua_tostring(state, -1));
+        lua_pop(state, 1);
+        if (!enabled) {
+            return 0;
+        }
+    }
     amun::Visualization *vis = thread->addVisualization();
     std::string errorMsg;
     protobufToMessage(state, 1, *vis, &errorMsg);
@@ -180,9 +188,12 @@ static int amunAddVisualizationCircle(lua_State *state)
     }
 
     Lua *thread = getStrategyThread(state);
+    const char *name = lua_tostring(state, 1);
+    if (!thread->isVisualizationEnabled(name ? name : "")) {
+        return 0;
+    }
     amun::Visualization *vis = thread->addVisualization();
 
-    const char *name = lua_tostring(state, 1);
     const float center_x = lua_tonumber(state, 2);
     const float center_y = lua_tonumber(state, 3);
     const float radius = lua_tonumber(state, 4);
@@ -214,6 +225,9 @@ static int amunAddVisualizationCircle(lua_State *state)
 static int amunAddDebug(lua_State *state)
 {
     Lua *thread = getStrategyThread(state);
+    if (!thread->isDebugValueEnabled()) {
+        return 0;
+    }
     amun::DebugValue *value = thread->addDebug();
     value->set_key(luaL_checkstring(state, 1));
 
@@ -241,6 +255,9 @@ static int amunAddDebug(lua_State *state)
 static int amunAddPlot(lua_State *state)
 {
     Lua *thread = getStrategyThread(state);
+    if (!thread->isPlotEnabled()) {
+        return 0;
+    }
     amun::PlotValue *value = thread->addPlot();
     value->set_name(luaL_checkstring(state, 1));
     value->set_value(lua_tonumber(state, 2));
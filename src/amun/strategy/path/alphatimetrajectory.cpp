@@ -21,6 +21,7 @@
 #include "alphatimetrajectory.h"
 #include "parameterization.h"
 #include <QDebug>
+#include <limits>
 
 // helper functions
 static float sign(float x)
@@ -383,6 +384,20 @@ std::optional<Trajectory> AlphaTimeTrajectory::findTrajectory(const RobotState &
     return {};
 }
 
+void AlphaTimeTrajectory::reachTimes(const std::vector<RobotState> &starts, const std::vector<RobotState> &targets, float acc, float vMax,
+                                     std::vector<float> &result)
+{
+    result.resize(starts.size() * targets.size());
+    std::size_t i = 0;
+    for (const RobotState &start : starts) {
+        for (const RobotState &target : targets) {
+            // same as the direct trajectory of the trajectory path, but without slow down
+            const auto trajectory = findTrajectory(start, target, acc, vMax, 0, EndSpeed::FAST);
+            result[i++] = trajectory ? trajectory->endTime() : std::numeric_limits<float>::infinity();
+        }
+    }
+}
+
 #ifdef ACTIVE_PATHFINDING_PARAMETER_OPTIMIZATION
 int AlphaTimeTrajectory::searchIterationCounter = 0;
 #endif
@@ -46,6 +46,11 @@ public:
     // search for position
     static std::optional<Trajectory> findTrajectory(const RobotState &start, const RobotState &target, float acc, float vMax, float slowDownTime, EndSpeed endSpeedType);
 
+    // minimum travel time from every start to every target, ignoring obstacles
+    // result is row major with one row per start, infinity if no trajectory was found
+    static void reachTimes(const std::vector<RobotState> &starts, const std::vector<RobotState> &targets, float acc, float vMax,
+                           std::vector<float> &result);
+
     // speed profile output
     // any input is valid as long as time is not negative
     // if minTime is given, it must be the value of minTimeFastEndSped(v0, v1, acc)
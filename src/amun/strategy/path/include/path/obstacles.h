@@ -250,6 +250,25 @@ namespace Obstacles {
         static constexpr float ROBOT_RADIUS = 0.09f;
     };
 
+    // circles stored as structure of arrays, so that checking many segments against all of them vectorizes
+    class CircleBatch {
+    public:
+        void reserve(std::size_t count);
+        void add(Vector center, float radius);
+        void clear();
+        std::size_t size() const { return m_radius.size(); }
+
+        // distance between the segment from start to end and the border of the closest circle, negative if a circle
+        // intersects it and infinity without circles, closest is set to the index of that circle or -1
+        float clearance(const Vector &start, const Vector &end, int &closest) const;
+
+    private:
+        std::vector<float> m_x;
+        std::vector<float> m_y;
+        std::vector<float> m_radius;
+        mutable std::vector<float> m_distances;
+    };
+
 }
 
 #endif // OBSTACLES_H
@@ -728,3 +728,63 @@ bool Obstacles::OpponentRobotObstacle::operator==(const Obstacle &otherObst) con
     const Obstacles::OpponentRobotObstacle &other = dynamic_cast<const Obstacles::OpponentRobotObstacle&>(otherObst);
     return prio == other.prio && radius == other.radius && startPos == other.startPos && speed == other.speed;
 }
+
+void Obstacles::CircleBatch::reserve(std::size_t count)
+{
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_radius.reserve(count);
+}
+
+void Obstacles::CircleBatch::add(Vector center, float radius)
+{
+    m_x.push_back(center.x);
+    m_y.push_back(center.y);
+    m_radius.push_back(radius);
+}
+
+void Obstacles::CircleBatch::clear()
+{
+    m_x.clear();
+    m_y.clear();
+    m_radius.clear();
+}
+
+float Obstacles::CircleBatch::clearance(const Vector &start, const Vector &end, int &closest) const
+{
+    const float startX = start.x;
+    const float startY = start.y;
+    const float dirX = end.x - startX;
+    const float dirY = end.y - startY;
+    const float lengthSq = dirX * dirX + dirY * dirY;
+    const float invLengthSq = lengthSq > 0 ? 1 / lengthSq : 0;
+
+    const std::size_t count = m_radius.size();
+    m_distances.resize(count);
+    const float *x = m_x.data();
+    const float *y = m_y.data();
+    const float *radius = m_radius.data();
+    float *distancesSq = m_distances.data();
+    // branch free and without sqrt (which may set errno), so that the compiler can vectorize it
+    for (std::size_t i = 0; i < count; i++) {
+        const float relX = x[i] - startX;
+        const float relY = y[i] - startY;
+        float t = (relX * dirX + relY * dirY) * invLengthSq;
+        t = t < 0 ? 0 : t;
+        t = t > 1 ? 1 : t;
+        const float dx = relX - dirX * t;
+        const float dy = relY - dirY * t;
+        distancesSq[i] = dx * dx + dy * dy;
+    }
+
+    closest = -1;
+    float result = std::numeric_limits<float>::infinity();
+    for (std::size_t i = 0; i < count; i++) {
+        const float distance = std::sqrt(distancesSq[i]) - radius[i];
+        if (distance < result) {
+            result = distance;
+            closest = i;
+        }
+    }
+    return result;
+}
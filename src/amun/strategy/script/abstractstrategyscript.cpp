@@ -93,9 +93,25 @@ amun::Visualization *AbstractStrategyScript::addVisualization()
     return m_debugValues->add_visualization();
 }
 
+bool AbstractStrategyScript::isVisualizationEnabled(const std::string &name)
+{
+    return m_scriptState.debugSubscription.requestVisualization(m_debugValues, name);
+}
+
+bool AbstractStrategyScript::isPlotEnabled() const
+{
+    return m_scriptState.debugSubscription.isPlotEnabled();
+}
+
+bool AbstractStrategyScript::isDebugValueEnabled() const
+{
+    return m_scriptState.debugSubscription.isDebugValueEnabled();
+}
+
 void AbstractStrategyScript::removeVisualizations()
 {
     m_debugValues->clear_visualization();
+    m_scriptState.debugSubscription.clearAnnouncements();
 }
 
 amun::DebugValue *AbstractStrategyScript::addDebug()
@@ -166,6 +182,7 @@ bool AbstractStrategyScript::process(double &pathPlanning, const world::State &w
 
     m_worldState.CopyFrom(worldState);
     m_worldState.clear_vision_frames();
+    m_worldState.clear_raw_vision_frames();
     m_refereeState.CopyFrom(refereeState);
     m_userInput.CopyFrom(userInput);
 
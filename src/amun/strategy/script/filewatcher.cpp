@@ -19,8 +19,16 @@
  ***************************************************************************/
 
 #include "filewatcher.h"
+#include <QDir>
 #include <QFileSystemWatcher>
 #include <QFileInfo>
+#include <QTimer>
+#include <algorithm>
+
+// editors and git usually touch all files of a change within a few milliseconds
+static const int DEFAULT_SETTLE_TIME = 200;
+// report continuously changing files at least this often
+static const int MAX_SETTLE_DELAY = 2000;
 
 FileWatcher::FileWatcher(QObject *parent) :
     QObject(parent)
@@ -28,6 +36,11 @@ FileWatcher::FileWatcher(QObject *parent) :
     m_watcher = new QFileSystemWatcher(this);
     connect(m_watcher, &QFileSystemWatcher::fileChanged, this, &FileWatcher::onFileChanged);
     connect(m_watcher, SIGNAL(directoryChanged(QString)), SLOT(handleDirectoryChange(QString)));
+
+    m_settleTimer = new QTimer(this);
+    m_settleTimer->setSingleShot(true);
+    m_settleTimer->setInterval(DEFAULT_SETTLE_TIME);
+    connect(m_settleTimer, &QTimer::timeout, this, &FileWatcher::emitChanges);
 }
 
 FileWatcher::~FileWatcher()
@@ -35,6 +48,11 @@ FileWatcher::~FileWatcher()
     delete m_watcher;
 }
 
+void FileWatcher::setSettleTime(int msec)
+{
+    m_settleTimer->setInterval(msec);
+}
+
 // return true if file is watched or false if a parent folder is watched
 bool FileWatcher::addFile(const QString &filename)
 {
@@ -62,16 +80,92 @@ bool FileWatcher::addFile(const QString &filename)
     return isReadable;
 }
 
+void FileWatcher::addDirectory(const QString &path, const QStringList &ignoredPaths)
+{
+    for (const QString &ignored : ignoredPaths) {
+        m_ignoredPaths.append(QDir::cleanPath(ignored));
+    }
+    indexDirectory(QDir::cleanPath(path), false);
+}
+
+void FileWatcher::indexDirectory(const QString &path, bool markNewFiles)
+{
+    for (const QString &ignored : m_ignoredPaths) {
+        if (path == ignored || path.startsWith(ignored + "/")) {
+            return;
+        }
+    }
+
+    const bool isNew = !m_directoryFiles.contains(path);
+    if (isNew) {
+        m_watcher->addPath(path);
+    }
+
+    // files have to be watched individually, as modifying a file does not change its directory
+    QSet<QString> files;
+    const QFileInfoList entries = QDir(path).entryInfoList(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QFileInfo &info : entries) {
+        const QString filePath = info.filePath();
+        if (info.isDir()) {
+            if (!m_directoryFiles.contains(filePath)) {
+                indexDirectory(filePath, markNewFiles);
+            }
+            continue;
+        }
+        files.insert(filePath);
+    }
+
+    const QSet<QString> oldFiles = m_directoryFiles.value(path);
+    for (const QString &file : files) {
+        if (!oldFiles.contains(file)) {
+            m_watcher->addPath(file);
+            if (markNewFiles) {
+                markChanged(file);
+            }
+        }
+    }
+    for (const QString &file : oldFiles) {
+        if (!files.contains(file)) {
+            // removed or renamed
+            markChanged(file);
+        }
+    }
+    m_directoryFiles[path] = files;
+}
+
 void FileWatcher::onFileChanged(const QString &name)
 {
-    if (!m_watcher->files().contains(name))
-        addFile(name);
-    emit fileChanged(name);
+    // some editors replace the file on saving, which removes the watch
+    if (!m_watcher->files().contains(name)) {
+        const bool inWatchedDirectory = m_directoryFiles.contains(QFileInfo(name).path());
+        if (!inWatchedDirectory) {
+            addFile(name);
+        } else if (QFileInfo::exists(name)) {
+            m_watcher->addPath(name);
+        }
+    }
+    markChanged(name);
 }
 
 void FileWatcher::handleDirectoryChange(const QString &name)
 {
-    emit directoryChanged(name);
+    if (m_directoryFiles.contains(name)) {
+        if (QFileInfo(name).isDir()) {
+            indexDirectory(name, true);
+        } else {
+            // the directory itself was removed, also forget its subdirectories
+            for (auto it = m_directoryFiles.begin(); it != m_directoryFiles.end();) {
+                if (it.key() == name || it.key().startsWith(name + "/")) {
+                    for (const QString &file : it.value()) {
+                        markChanged(file);
+                    }
+                    it = m_directoryFiles.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
 
     if (!m_missingFiles.contains(name)) {
         return;
@@ -82,7 +176,27 @@ void FileWatcher::handleDirectoryChange(const QString &name)
     foreach (const QString &filename, files) {
         // update watcher to be as close to a file as possible
         if (addFile(filename)) {
-            emit fileChanged(filename);
+            markChanged(filename);
         }
     }
 }
+
+void FileWatcher::markChanged(const QString &name)
+{
+    if (!m_settleTimer->isActive()) {
+        m_burstTimer.start();
+    }
+    m_changedFiles.insert(name);
+    // restart the settle window
+    if (m_burstTimer.elapsed() < MAX_SETTLE_DELAY) {
+        m_settleTimer->start();
+    }
+}
+
+void FileWatcher::emitChanges()
+{
+    QStringList files = m_changedFiles.values();
+    m_changedFiles.clear();
+    std::sort(files.begin(), files.end());
+    emit filesChanged(files);
+}
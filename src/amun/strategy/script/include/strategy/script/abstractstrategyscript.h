@@ -37,6 +37,7 @@
 #include <QDir>
 #include <QList>
 #include <QThread>
+#include <string>
 
 class DebugHelper;
 class Timer;
@@ -97,6 +98,10 @@ public:
 
     void log(const QString &text);
     amun::Visualization *addVisualization();
+    // visualizations that are not subscribed to only announce their name, see DebugSubscription
+    bool isVisualizationEnabled(const std::string &name);
+    bool isPlotEnabled() const;
+    bool isDebugValueEnabled() const;
     void removeVisualizations();
     amun::DebugValue *addDebug();
     amun::PlotValue *addPlot();
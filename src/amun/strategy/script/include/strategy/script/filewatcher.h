@@ -21,12 +21,19 @@
 #ifndef FILEWATCHER_H
 #define FILEWATCHER_H
 
+#include <QElapsedTimer>
+#include <QHash>
 #include <QObject>
+#include <QSet>
 #include <QString>
+#include <QStringList>
 #include <QMultiHash>
 
 class QFileSystemWatcher;
+class QTimer;
 
+// Change notifications are collected until no further change happened for the settle time,
+// thus a burst of changes (saving many files, git checkout) results in a single filesChanged.
 class FileWatcher : public QObject
 {
     Q_OBJECT
@@ -36,18 +43,34 @@ public:
     FileWatcher(const FileWatcher&) = delete;
     FileWatcher& operator=(const FileWatcher&) = delete;
     bool addFile(const QString &filename);
-
+    // watches all files in path and its subdirectories, new files are picked up automatically
+    // the ignored paths and everything below them are skipped.
+    // Every file and directory still needs its own watch, this does not reduce the number of inotify watches
+    void addDirectory(const QString &path, const QStringList &ignoredPaths = QStringList());
+    void setSettleTime(int msec);
 
 signals:
-    void fileChanged(const QString &name);
-    void directoryChanged(const QString &name);
+    // changed, created and removed files since the last signal
+    void filesChanged(const QStringList &files);
 
 private slots:
     void onFileChanged(const QString &name);
     void handleDirectoryChange(const QString &name);
+    void emitChanges();
+
 private:
+    void indexDirectory(const QString &path, bool markNewFiles);
+    void markChanged(const QString &name);
+
     QFileSystemWatcher* m_watcher;
+    QTimer *m_settleTimer;
+    // time since the first change that was not reported yet
+    QElapsedTimer m_burstTimer;
     QMultiHash<QString, QString> m_missingFiles;
+    // files contained in the recursively watched directories
+    QHash<QString, QSet<QString>> m_directoryFiles;
+    QStringList m_ignoredPaths;
+    QSet<QString> m_changedFiles;
 };
 
 #endif // FILEWATCHER_H
@@ -23,6 +23,7 @@
 
 #include <QStringList>
 
+#include "protobuf/debugsubscription.h"
 #include "protobuf/status.h"
 
 class DebugHelper;
@@ -41,6 +42,7 @@ public:
     bool isRunningInLogplayer = false;
     Status currentStatus; // used for replay tests
     ProtobufFileSaver *pathInputSaver = nullptr;
+    DebugSubscription debugSubscription; // debug output requested by the consumers
 };
 
 #endif // SCRIPTSTATE_H
@@ -0,0 +1,60 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef VISUALIZATIONBATCH_H
+#define VISUALIZATIONBATCH_H
+
+#include "protobuf/debug.pb.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Validated shapes of amun.addVisualizationBatch
+// styles: [r, g, b, alpha, lineWidth, flags, penStyle]* with colors in [0, 255], flags: 1 = filled, 2 = background,
+// penStyle 0 draws a solid line
+// shapes: [0, style, x, y, radius] for circles, [1, style, n, x1, y1, ..., xn, yn] for paths
+// and [2, style, n, x1, y1, ...] for polygons
+class VisualizationBatch
+{
+public:
+    static const std::size_t STYLE_STRIDE = 7;
+
+    // validates the whole batch, returns an error message or nullptr if the batch is valid
+    // nothing is stored for an invalid batch
+    const char *parse(std::vector<float> styles, std::vector<float> shapes);
+
+    std::size_t size() const { return m_batch.size(); }
+    void write(std::size_t index, const std::string &name, amun::Visualization *vis) const;
+
+private:
+    enum class Kind { Circle = 0, Path = 1, Polygon = 2 };
+    struct Shape {
+        Kind kind;
+        std::size_t styleIndex;
+        std::size_t offset;
+        std::size_t count;
+    };
+
+    std::vector<float> m_styles;
+    std::vector<float> m_shapes;
+    std::vector<Shape> m_batch;
+};
+
+#endif // VISUALIZATIONBATCH_H
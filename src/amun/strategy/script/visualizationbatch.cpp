@@ -0,0 +1,130 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "visualizationbatch.h"
+#include <cmath>
+#include <utility>
+
+// converts a float which is used as index or count, fails unless it is an integer in [0, limit)
+static bool batchIndex(float value, std::size_t limit, std::size_t &result)
+{
+    if (!std::isfinite(value) || value < 0 || value != std::floor(value) || value >= float(limit)) {
+        return false;
+    }
+    result = static_cast<std::size_t>(value);
+    return result < limit;
+}
+
+const char *VisualizationBatch::parse(std::vector<float> styles, std::vector<float> shapes)
+{
+    m_batch.clear();
+    if (styles.size() % STYLE_STRIDE != 0) {
+        return "Invalid array length";
+    }
+    const std::size_t styleCount = styles.size() / STYLE_STRIDE;
+    for (std::size_t s = 0; s < styleCount; s++) {
+        const float *style = styles.data() + s * STYLE_STRIDE;
+        // colors are stored as unsigned integers, flags and pen style are converted to int in write
+        for (int c = 0; c < 4; c++) {
+            if (!(style[c] >= 0 && style[c] <= 255)) {
+                return "Invalid style";
+            }
+        }
+        std::size_t checked;
+        if (!batchIndex(style[5], 4, checked) || !batchIndex(style[6], 256, checked)) {
+            return "Invalid style";
+        }
+    }
+
+    std::vector<Shape> batch;
+    std::size_t i = 0;
+    while (i < shapes.size()) {
+        Shape shape;
+        std::size_t kind;
+        if (i + 2 >= shapes.size() || !batchIndex(shapes[i], 3, kind)
+                || !batchIndex(shapes[i + 1], styleCount, shape.styleIndex)) {
+            return "Invalid shape";
+        }
+        shape.kind = static_cast<Kind>(kind);
+        shape.offset = i + 2;
+        // the remaining entries bound the number of points
+        const std::size_t remaining = shapes.size() - i - 3;
+        std::size_t length;
+        if (shape.kind == Kind::Circle) {
+            shape.count = 0;
+            length = 5;
+        } else if (batchIndex(shapes[i + 2], remaining / 2 + 1, shape.count)) {
+            length = 3 + 2 * shape.count;
+        } else {
+            return "Invalid shape";
+        }
+        if (length > shapes.size() - i) {
+            return "Invalid shape";
+        }
+        batch.push_back(shape);
+        i += length;
+    }
+
+    m_styles = std::move(styles);
+    m_shapes = std::move(shapes);
+    m_batch = std::move(batch);
+    return nullptr;
+}
+
+void VisualizationBatch::write(std::size_t index, const std::string &name, amun::Visualization *vis) const
+{
+    const Shape &shape = m_batch[index];
+    const float *style = m_styles.data() + shape.styleIndex * STYLE_STRIDE;
+    const int flags = style[5];
+    const int penStyle = style[6];
+    vis->set_name(name);
+    vis->set_width(style[4]);
+    if (flags & 2) {
+        vis->set_background(true);
+    }
+    amun::Pen *pen = vis->mutable_pen();
+    if (penStyle != 0 && amun::Pen::Style_IsValid(penStyle)) {
+        pen->set_style(static_cast<amun::Pen::Style>(penStyle));
+    }
+    amun::Color *color = pen->mutable_color();
+    color->set_red(style[0]);
+    color->set_green(style[1]);
+    color->set_blue(style[2]);
+    color->set_alpha(style[3]);
+    if ((flags & 1) && shape.kind != Kind::Path) {
+        vis->mutable_brush()->CopyFrom(*color);
+    }
+
+    const float *data = m_shapes.data() + shape.offset;
+    if (shape.kind == Kind::Circle) {
+        amun::Circle *circle = vis->mutable_circle();
+        circle->set_p_x(data[0]);
+        circle->set_p_y(data[1]);
+        circle->set_radius(data[2]);
+    } else {
+        auto *points = shape.kind == Kind::Path ? vis->mutable_path()->mutable_point() : vis->mutable_polygon()->mutable_point();
+        points->Reserve(shape.count);
+        for (std::size_t p = 0; p < shape.count; p++) {
+            amun::Point *point = points->Add();
+            point->set_x(data[1 + 2 * p]);
+            point->set_y(data[2 + 2 * p]);
+        }
+    }
+}
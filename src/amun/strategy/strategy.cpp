@@ -279,6 +279,10 @@ void Strategy::handleCommand(const Command &command)
     }
     // autoref has no robots
 
+    if (command->has_debug_subscription()) {
+        m_scriptState.debugSubscription.update(command->debug_subscription());
+    }
+
     if (cmd) {
         if (cmd->has_enable_debug()) {
             // only reload on change
@@ -536,10 +540,12 @@ void Strategy::process()
         addTimingInfos(status, pathPlanning, totalTime, m_type);
         status->mutable_execution_state()->CopyFrom(worldState);
         status->mutable_execution_state()->clear_vision_frames();
+        status->mutable_execution_state()->clear_raw_vision_frames();
         status->mutable_execution_game_state()->CopyFrom(m_scriptState.currentStatus->execution_game_state().IsInitialized()
                                                             ? m_scriptState.currentStatus->execution_game_state()
                                                             : m_scriptState.currentStatus->game_state());
         status->mutable_execution_user_input()->CopyFrom(userInput);
+        compactDebugOutput(status);
         emit sendStatus(status);
     } else {
         double totalTime = (Timer::systemTime() - startTime) * 1E-9;
@@ -609,6 +615,7 @@ void Strategy::loadStateChanged(amun::StatusStrategy::STATE state)
         log->set_text(QString("<font color=\"darkgreen\">Successfully loaded %1 with entry point %2!</font>").arg(m_filename, m_entryPoint).toStdString());
     }
 
+    compactDebugOutput(status);
     emit sendStatus(status);
 }
 
@@ -730,6 +737,7 @@ void Strategy::fail(const QString &error, const amun::UserInput & userInput, dou
     log->set_timestamp(m_timer->currentTime());
     log->set_text(error.toStdString());
 
+    compactDebugOutput(status);
     emit sendStatus(status);
 
     // log errors to disk
@@ -824,6 +832,20 @@ Status Strategy::takeStrategyDebugStatus()
     return out;
 }
 
+void Strategy::compactDebugOutput(Status &status)
+{
+    // the ids are only known to the receivers of the previous source
+    if (m_debugStringsSource != debugSource()) {
+        m_debugStrings.reset();
+        m_debugStringsSource = debugSource();
+    }
+    for (amun::DebugValues &debug : *status->mutable_debug()) {
+        m_imageEncoder.encode(&debug);
+        m_debugStrings.compact(&debug);
+    }
+    m_debugStrings.flush(debugSource(), &*status);
+}
+
 amun::DebugSource Strategy::debugSource() const
 {
     if (m_scriptState.isRunningInLogplayer && m_type == StrategyType::BLUE) {
@@ -26,6 +26,8 @@
 #include <v8.h>
 #include <cmath>
 #include <algorithm>
+#include <limits>
+#include <optional>
 
 #include "js_protobuf.h"
 #include "typescript.h"
@@ -34,6 +36,9 @@
 #include "protobuf/ssl_game_controller_auto_ref.pb.h"
 #include "v8utility.h"
 #include "strategy/script/scriptstate.h"
+#include "strategy/script/visualizationbatch.h"
+#include "core/ballprediction.h"
+#include "path/obstacles.h"
 
 using namespace v8;
 using namespace v8helper;
@@ -101,6 +106,7 @@ static void amunGetWorldState(const FunctionCallbackInfo<Value>& args)
     // transfering data between C++ and typescript is costly
     // remove all fields that the strategy does not need
     state.clear_vision_frames();
+    state.clear_raw_vision_frames();
     state.clear_simple_tracking_blue();
     state.clear_simple_tracking_yellow();
     state.clear_radio_response();
@@ -176,6 +182,22 @@ static bool verifyNumber(Isolate *isolate, Local<Value> value, float &result)
     return true;
 }
 
+static bool floatArrayFromValue(Isolate *isolate, Local<Value> value, std::size_t stride, std::vector<float> &values)
+{
+    if (!value->IsFloat32Array()) {
+        throwError(isolate, "Expected a Float32Array");
+        return false;
+    }
+    Local<Float32Array> array = Local<Float32Array>::Cast(value);
+    if (array->Length() % stride != 0) {
+        throwError(isolate, "Invalid array length");
+        return false;
+    }
+    values.resize(array->Length());
+    array->CopyContents(values.data(), values.size() * sizeof(float));
+    return true;
+}
+
 static bool checkNumberOfArguments(Isolate *isolate, int expected, int got)
 {
     if (got < expected) {
@@ -265,8 +287,16 @@ static void amunAddVisualization(const FunctionCallbackInfo<Value>& args)
     if (!checkNumberOfArguments(isolate, 1, args.Length())) {
         return;
     }
+    Local<Context> context = isolate->GetCurrentContext();
+    if (args[0]->IsObject()) {
+        Local<Value> name;
+        if (Local<Object>::Cast(args[0])->Get(context, v8string(isolate, "name")).ToLocal(&name) && name->IsString()
+                && !t->isVisualizationEnabled(*String::Utf8Value(isolate, name))) {
+            return;
+        }
+    }
     amun::Visualization *vis = t->addVisualization();
-    jsToProtobuf(isolate, args[0], isolate->GetCurrentContext(), *vis);
+    jsToProtobuf(isolate, args[0], context, *vis);
 }
 
 static void amunAddCircleSimple(const FunctionCallbackInfo<Value>& args)
@@ -285,6 +315,9 @@ static void amunAddCircleSimple(const FunctionCallbackInfo<Value>& args)
         return;
     }
     std::string name(*String::Utf8Value(isolate, args[0]));
+    if (!t->isVisualizationEnabled(name)) {
+        return;
+    }
     auto vis = t->addVisualization();
     vis->set_width(lineWidth);
     vis->set_name(name);
@@ -319,6 +352,9 @@ static void amunAddPathSimple(const FunctionCallbackInfo<Value>& args)
     bool background;
 
     std::string name(*String::Utf8Value(isolate, args[0]));
+    if (!t->isVisualizationEnabled(name)) {
+        return;
+    }
     auto vis = t->addVisualization();
 
     if (args.Length() == 2) { // new, more efficient version
@@ -405,6 +441,9 @@ static void amunAddPolygonSimple(const FunctionCallbackInfo<Value>& args)
         return;
     }
     std::string name(*String::Utf8Value(isolate, args[0]));
+    if (!t->isVisualizationEnabled(name)) {
+        return;
+    }
     auto vis = t->addVisualization();
     auto color = vis->mutable_pen()->mutable_color();
     color->set_red(r);
@@ -444,10 +483,43 @@ static void amunAddPolygonSimple(const FunctionCallbackInfo<Value>& args)
     }
 }
 
+// arguments: name, styles and shapes, see VisualizationBatch for the layout
+static void amunAddVisualizationBatch(const FunctionCallbackInfo<Value>& args)
+{
+    Isolate* isolate = args.GetIsolate();
+    Typescript *t = static_cast<Typescript*>(Local<External>::Cast(args.Data())->Value());
+
+    if (!checkNumberOfArguments(isolate, 3, args.Length())) {
+        return;
+    }
+    std::string name(*String::Utf8Value(isolate, args[0]));
+    if (!t->isVisualizationEnabled(name)) {
+        return;
+    }
+    std::vector<float> styles, shapes;
+    if (!floatArrayFromValue(isolate, args[1], VisualizationBatch::STYLE_STRIDE, styles)
+            || !floatArrayFromValue(isolate, args[2], 1, shapes)) {
+        return;
+    }
+
+    // the whole batch is validated first, an invalid shape must not leave the previous ones behind
+    VisualizationBatch batch;
+    if (const char *error = batch.parse(std::move(styles), std::move(shapes))) {
+        throwError(isolate, error);
+        return;
+    }
+    for (std::size_t i = 0; i < batch.size(); i++) {
+        batch.write(i, name, t->addVisualization());
+    }
+}
+
 static void amunAddDebug(const FunctionCallbackInfo<Value>& args)
 {
     Isolate* isolate = args.GetIsolate();
     Typescript *t = static_cast<Typescript*>(Local<External>::Cast(args.Data())->Value());
+    if (!t->isDebugValueEnabled()) {
+        return;
+    }
     amun::DebugValue *debugValue = t->addDebug();
     String::Utf8Value key(isolate, args[0]);
     debugValue->set_key(*key);
@@ -471,6 +543,9 @@ static void amunAddPlot(const FunctionCallbackInfo<Value>& args)
 {
     Isolate* isolate = args.GetIsolate();
     Typescript *t = static_cast<Typescript*>(Local<External>::Cast(args.Data())->Value());
+    if (!t->isPlotEnabled()) {
+        return;
+    }
     amun::PlotValue *value = t->addPlot();
     value->set_name(*String::Utf8Value(isolate, args[0]));
     double number = 0.0;
@@ -559,6 +634,28 @@ static void amunSetRobotExchangeSymbol(const FunctionCallbackInfo<Value>& args)
     value->set_exchange(set);
 }
 
+static void amunIsVisualizationEnabled(const FunctionCallbackInfo<Value>& args)
+{
+    Isolate* isolate = args.GetIsolate();
+    Typescript *t = static_cast<Typescript*>(Local<External>::Cast(args.Data())->Value());
+    if (!checkNumberOfArguments(isolate, 1, args.Length())) {
+        return;
+    }
+    args.GetReturnValue().Set(t->isVisualizationEnabled(*String::Utf8Value(isolate, args[0])));
+}
+
+static void amunIsPlotEnabled(const FunctionCallbackInfo<Value>& args)
+{
+    Typescript *t = static_cast<Typescript*>(Local<External>::Cast(args.Data())->Value());
+    args.GetReturnValue().Set(t->isPlotEnabled());
+}
+
+static void amunIsDebugValueEnabled(const FunctionCallbackInfo<Value>& args)
+{
+    Typescript *t = static_cast<Typescript*>(Local<External>::Cast(args.Data())->Value());
+    args.GetReturnValue().Set(t->isDebugValueEnabled());
+}
+
 static void amunGetPerformanceMode(const FunctionCallbackInfo<Value>& args)
 {
     Isolate* isolate = args.GetIsolate();
@@ -774,6 +871,142 @@ static void amunResolveJsToTs(const FunctionCallbackInfo<Value>& args)
     args.GetReturnValue().Set(v8string(isolate, result));
 }
 
+// arguments: ball model [fastDeceleration, slowDeceleration, switchRatio, zDamping, xyDamping] or undefined
+// to use the one from the geometry, ball [x, y, z, vx, vy, vz, shotSpeed] and robots [x, y, radius]*
+// on invalid arguments an exception is thrown and nullopt returned, callers must not throw again
+static std::optional<BallPrediction> ballPredictionFromArgs(const FunctionCallbackInfo<Value>& args)
+{
+    Isolate* isolate = args.GetIsolate();
+    Typescript *t = static_cast<Typescript*>(Local<External>::Cast(args.Data())->Value());
+
+    world::BallModel model;
+    std::vector<float> values;
+    if (args[0]->IsUndefined()) {
+        if (!t->geometry().has_ball_model()) {
+            throwError(isolate, "No ball model available");
+            return {};
+        }
+        model = t->geometry().ball_model();
+    } else {
+        // floatArrayFromValue throws on its own, only one exception may be pending
+        if (!floatArrayFromValue(isolate, args[0], 5, values)) {
+            return {};
+        }
+        if (values.size() != 5) {
+            throwError(isolate, "Invalid ball model");
+            return {};
+        }
+        model.set_fast_deceleration(values[0]);
+        model.set_slow_deceleration(values[1]);
+        model.set_switch_ratio(values[2]);
+        model.set_z_damping(values[3]);
+        model.set_xy_damping(values[4]);
+    }
+
+    if (!floatArrayFromValue(isolate, args[1], 7, values)) {
+        return {};
+    }
+    if (values.size() != 7) {
+        throwError(isolate, "Invalid ball state");
+        return {};
+    }
+    BallPrediction::State ball;
+    ball.pos = Vector(values[0], values[1]);
+    ball.z = values[2];
+    ball.speed = Vector(values[3], values[4]);
+    ball.vz = values[5];
+    const float shotSpeed = values[6];
+
+    if (!floatArrayFromValue(isolate, args[2], 3, values)) {
+        return {};
+    }
+    std::vector<BallPrediction::Circle> robots;
+    robots.reserve(values.size() / 3);
+    for (std::size_t i = 0; i < values.size(); i += 3) {
+        robots.push_back({Vector(values[i], values[i + 1]), values[i + 2]});
+    }
+    return BallPrediction(model, ball, shotSpeed, robots);
+}
+
+static Local<Float32Array> float32ArrayFromVector(Isolate *isolate, const std::vector<float> &values)
+{
+    Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, values.size() * sizeof(float));
+    std::copy(values.begin(), values.end(), static_cast<float*>(buffer->GetBackingStore()->Data()));
+    return Float32Array::New(buffer, 0, values.size());
+}
+
+static void amunPredictBall(const FunctionCallbackInfo<Value>& args)
+{
+    Isolate* isolate = args.GetIsolate();
+    unsigned int count;
+    float timeStep;
+    if (!verifyNumber(isolate, args[3], timeStep) || !toUintChecked(isolate, args[4], count)) {
+        return;
+    }
+    std::optional<BallPrediction> prediction = ballPredictionFromArgs(args);
+    if (!prediction) {
+        return;
+    }
+
+    // [x, y, z, vx, vy, vz] for every step, starting at the current time
+    std::vector<float> result;
+    result.reserve(count * 6);
+    for (unsigned int i = 0; i < count; i++) {
+        const BallPrediction::State state = prediction->stateAt(i * timeStep);
+        result.insert(result.end(), {state.pos.x, state.pos.y, state.z, state.speed.x, state.speed.y, state.vz});
+    }
+    args.GetReturnValue().Set(float32ArrayFromVector(isolate, result));
+}
+
+static void amunGetBallReachTimes(const FunctionCallbackInfo<Value>& args)
+{
+    Isolate* isolate = args.GetIsolate();
+    std::vector<float> points;
+    float tolerance;
+    if (!floatArrayFromValue(isolate, args[3], 2, points) || !verifyNumber(isolate, args[4], tolerance)) {
+        return;
+    }
+    std::optional<BallPrediction> prediction = ballPredictionFromArgs(args);
+    if (!prediction) {
+        return;
+    }
+
+    // one time per point, infinity if the ball never reaches it
+    std::vector<float> result;
+    result.reserve(points.size() / 2);
+    for (std::size_t i = 0; i < points.size(); i += 2) {
+        const float time = prediction->timeToPoint(Vector(points[i], points[i + 1]), tolerance);
+        result.push_back(time < 0 ? std::numeric_limits<float>::infinity() : time);
+    }
+    args.GetReturnValue().Set(float32ArrayFromVector(isolate, result));
+}
+
+// arguments: circles [x, y, radius]* and segments [x1, y1, x2, y2]*
+// returns [clearance, index of the closest circle] per segment
+static void amunGetSegmentClearances(const FunctionCallbackInfo<Value>& args)
+{
+    Isolate* isolate = args.GetIsolate();
+    std::vector<float> circles, segments;
+    if (!floatArrayFromValue(isolate, args[0], 3, circles) || !floatArrayFromValue(isolate, args[1], 4, segments)) {
+        return;
+    }
+
+    Obstacles::CircleBatch batch;
+    batch.reserve(circles.size() / 3);
+    for (std::size_t i = 0; i < circles.size(); i += 3) {
+        batch.add(Vector(circles[i], circles[i + 1]), circles[i + 2]);
+    }
+
+    std::vector<float> result;
+    result.reserve(segments.size() / 2);
+    for (std::size_t i = 0; i < segments.size(); i += 4) {
+        int closest;
+        result.push_back(batch.clearance(Vector(segments[i], segments[i + 1]), Vector(segments[i + 2], segments[i + 3]), closest));
+        result.push_back(closest);
+    }
+    args.GetReturnValue().Set(float32ArrayFromVector(isolate, result));
+}
+
 void registerAmunJsCallbacks(Isolate *isolate, Local<Object> global, Typescript *t)
 {
     QList<CallbackInfo> callbacks = {
@@ -791,8 +1024,12 @@ void registerAmunJsCallbacks(Isolate *isolate, Local<Object> global, Typescript
         { "addCircleSimple",    amunAddCircleSimple},
         { "addPathSimple",      amunAddPathSimple},
         { "addPolygonSimple",   amunAddPolygonSimple},
+        { "addVisualizationBatch", amunAddVisualizationBatch},
         { "addDebug",           amunAddDebug},
         { "addPlot",            amunAddPlot},
+        { "isVisualizationEnabled", amunIsVisualizationEnabled},
+        { "isPlotEnabled",      amunIsPlotEnabled},
+        { "isDebugValueEnabled", amunIsDebugValueEnabled},
         { "getPerformanceMode", amunGetPerformanceMode},
         { "setCommand",         amunSetCommand},
         { "setCommands",        amunSetCommands},
@@ -811,7 +1048,10 @@ void registerAmunJsCallbacks(Isolate *isolate, Local<Object> global, Typescript
         { "tryCatch",       amunTryCatch},
         { "isDebug",        amunIsDebug},
         { "terminateExecution", amunTerminateExecution},
-        { "resolveJsToTs",  amunResolveJsToTs}
+        { "resolveJsToTs",  amunResolveJsToTs},
+        { "predictBall",    amunPredictBall},
+        { "getBallReachTimes", amunGetBallReachTimes},
+        { "getSegmentClearances", amunGetSegmentClearances}
     };
 
     Local<Context> context = isolate->GetCurrentContext();
@@ -22,7 +22,9 @@
 
 #include <QList>
 #include <v8.h>
+#include <algorithm>
 #include "strategy/script/scriptstate.h"
+#include "path/alphatimetrajectory.h"
 #include "path/path.h"
 #include "path/trajectorypath.h"
 #include "core/vector.h"
@@ -342,6 +344,57 @@ static void trajectoryPathGet(const FunctionCallbackInfo<Value>& args)
     args.GetReturnValue().Set(result);
 }
 
+// reads consecutive [px, py, vx, vy] entries
+static bool robotStatesFromArray(Isolate *isolate, Local<Value> value, std::vector<RobotState> &states)
+{
+    if (!value->IsFloat32Array()) {
+        isolate->ThrowException(Exception::Error(v8string(isolate, "Expected a Float32Array")));
+        return false;
+    }
+    Local<Float32Array> array = Local<Float32Array>::Cast(value);
+    if (array->Length() % 4 != 0) {
+        isolate->ThrowException(Exception::Error(v8string(isolate, "Invalid array length")));
+        return false;
+    }
+    std::vector<float> values(array->Length());
+    array->CopyContents(values.data(), values.size() * sizeof(float));
+    states.clear();
+    states.reserve(values.size() / 4);
+    for (std::size_t i = 0; i < values.size(); i += 4) {
+        states.emplace_back(Vector(values[i], values[i + 1]), Vector(values[i + 2], values[i + 3]));
+    }
+    return true;
+}
+
+static void trajectoryReachTimes(const FunctionCallbackInfo<Value>& args)
+{
+    QTPath *wrapper = static_cast<QTPath*>(Local<External>::Cast(args.Data())->Value());
+    Isolate *isolate = args.GetIsolate();
+    const qint64 t = Timer::systemTime();
+
+    std::vector<RobotState> starts, targets;
+    float maxSpeed, acceleration;
+    if (!robotStatesFromArray(isolate, args[0], starts) || !robotStatesFromArray(isolate, args[1], targets) ||
+            !verifyNumber(isolate, args[2], maxSpeed) || !verifyNumber(isolate, args[3], acceleration)) {
+        return;
+    }
+    if (maxSpeed <= 0 || acceleration <= 0) {
+        isolate->ThrowException(Exception::Error(v8string(isolate, "Invalid arguments")));
+        return;
+    }
+
+    std::vector<float> times;
+    AlphaTimeTrajectory::reachTimes(starts, targets, acceleration, maxSpeed, times);
+
+    // one row per start, one column per target
+    Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, times.size() * sizeof(float));
+    std::copy(times.begin(), times.end(), static_cast<float*>(buffer->GetBackingStore()->Data()));
+    Local<Float32Array> result = Float32Array::New(buffer, 0, times.size());
+
+    wrapper->typescript()->addPathTime((Timer::systemTime() - t) / 1E9);
+    args.GetReturnValue().Set(result);
+}
+
 static void trajectoryAddMovingCircle(const FunctionCallbackInfo<Value>& args)
 {
     Isolate * isolate = args.GetIsolate();
@@ -503,6 +556,7 @@ static QList<CallbackInfo> rrtPathCallbacks = {
 
 static QList<CallbackInfo> trajectoryPathCallbacks = {
     { "calculateTrajectory", trajectoryPathGet },
+    { "calculateReachTimes", trajectoryReachTimes },
     { "addMovingCircle",    trajectoryAddMovingCircle},
     { "addMovingLine",      trajectoryAddMovingLine},
     { "setOutOfFieldPrio",  trajectorySetOutOfFieldObstaclePriority},
@@ -312,6 +312,9 @@ void Typescript::evaluateStackFrame(const Local<Context>& c, QString& errorMsg,
 
 void Typescript::handleDebug(const amun::DebugValue &debug)
 {
+    if (!isDebugValueEnabled()) {
+        return;
+    }
     addDebug()->CopyFrom(debug);
 }
 
@@ -322,6 +325,9 @@ void Typescript::handleLog(const QString &text)
 
 void Typescript::handleVisualization(const amun::Visualization &vis)
 {
+    if (!isVisualizationEnabled(vis.name())) {
+        return;
+    }
     addVisualization()->CopyFrom(vis);
 }
 
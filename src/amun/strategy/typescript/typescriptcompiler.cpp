@@ -42,23 +42,11 @@ TypescriptCompiler::TypescriptCompiler(const QFileInfo &tsconfig)
 void TypescriptCompiler::init() {
 	m_watcher = std::unique_ptr<FileWatcher>(new FileWatcher(this));
 
-    indexFiles(m_tsconfig.dir().absolutePath());
+    // the compile output must not trigger another compilation
+    m_watcher->addDirectory(m_tsconfig.dir().absolutePath(), {m_tsconfig.dir().absoluteFilePath("built")});
 
-    connect(m_watcher.get(), &FileWatcher::fileChanged, this, &TypescriptCompiler::compile);
-    connect(m_watcher.get(), &FileWatcher::directoryChanged, this, &TypescriptCompiler::indexFiles);
-}
-
-void TypescriptCompiler::indexFiles(const QString &path)
-{
-    int baseDirLength = m_tsconfig.dir().absolutePath().length();
-    // also watch directories so that additional files can be properly watched
-    QDirIterator it(path, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
-    while (it.hasNext()) {
-        it.next();
-        if (it.filePath().mid(baseDirLength).startsWith("/built"))
-            continue;
-        m_watcher->addFile(it.filePath());
-    }
+    // a burst of changes is reported at once, thus it only causes a single compilation
+    connect(m_watcher.get(), &FileWatcher::filesChanged, this, &TypescriptCompiler::compile);
 }
 
 QFileInfo TypescriptCompiler::mapToResult(const QFileInfo& src) {
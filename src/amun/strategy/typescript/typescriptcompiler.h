@@ -48,9 +48,6 @@ public slots:
     void init() override;
     void compile() override;
 
-private slots:
-    void indexFiles(const QString &path);
-
 protected:
     enum class CompileResult {
         Success, Warning, Error
@@ -0,0 +1,210 @@
+/***************************************************************************
+ *   Copyright 2015 Michael Eischer                                        *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "threadmonitor.h"
+#include "core/timer.h"
+#include <QThread>
+#include <QTimer>
+#include <QtDebug>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// the thread should wake up every 10 ms
+static const int TICK_INTERVAL = 10;
+// report the jitter once per second
+static const int TICKS_PER_REPORT = 100;
+
+TimerJitter::TimerJitter(qint64 interval) :
+    m_interval(interval),
+    m_lastTick(0),
+    m_delaySum(0),
+    m_maxDelay(0),
+    m_tickCount(0)
+{ }
+
+void TimerJitter::start(qint64 time)
+{
+    m_lastTick = time;
+}
+
+void TimerJitter::tick(qint64 time)
+{
+    // firing early is not counted as jitter
+    const qint64 delay = std::max(qint64(0), time - m_lastTick - m_interval);
+    m_lastTick = time;
+    m_delaySum += delay;
+    m_maxDelay = std::max(m_maxDelay, delay);
+    m_tickCount++;
+}
+
+void TimerJitter::report(amun::ThreadJitter &jitter)
+{
+    if (m_tickCount > 0) {
+        jitter.set_mean(m_delaySum / m_tickCount * 1E-9f);
+        jitter.set_max(m_maxDelay * 1E-9f);
+    }
+    m_delaySum = 0;
+    m_maxDelay = 0;
+    m_tickCount = 0;
+}
+
+/*!
+ * \class ThreadMonitor
+ * \ingroup amun
+ * \brief Applies a \ref amun::ThreadPolicy and reports the timer jitter of a thread
+ *
+ * Parts of the policy which could not be applied are reported in every jitter
+ * status of the thread, the thread then keeps running with the default settings.
+ */
+
+ThreadMonitor::ThreadMonitor(const QString &name, QThread *thread, const amun::ThreadPlacement &placement) :
+    m_name(name),
+    m_timer(nullptr),
+    m_jitter(qint64(TICK_INTERVAL) * 1000 * 1000)
+{
+    m_hasPolicy = findPolicy(name, placement, m_policy);
+
+    moveToThread(thread);
+    connect(thread, &QThread::started, this, &ThreadMonitor::start);
+    connect(thread, &QThread::finished, this, &ThreadMonitor::deleteLater);
+}
+
+bool ThreadMonitor::findPolicy(const QString &name, const amun::ThreadPlacement &placement, amun::ThreadPolicy &policy)
+{
+    bool found = false;
+    for (const amun::ThreadPolicy &p : placement.policy()) {
+        for (const std::string &threadName : p.thread()) {
+            if (QString::fromStdString(threadName) == name) {
+                policy.CopyFrom(p);
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+QString ThreadMonitor::validatePolicy(const amun::ThreadPolicy &policy)
+{
+    QStringList errors;
+#ifdef Q_OS_LINUX
+    for (uint32_t cpu : policy.cpu()) {
+        if (cpu >= CPU_SETSIZE) {
+            errors << QString("cpu %1 does not exist").arg(cpu);
+        }
+    }
+#endif
+    if (policy.has_realtime_priority() && (policy.realtime_priority() < 1 || policy.realtime_priority() > 99)) {
+        errors << QString("realtime priority %1 is not in [1, 99]").arg(policy.realtime_priority());
+    }
+    if (policy.has_nice() && (policy.nice() < -20 || policy.nice() > 19)) {
+        errors << QString("nice level %1 is not in [-20, 19]").arg(policy.nice());
+    }
+    if (policy.has_realtime_priority() && policy.has_nice()) {
+        errors << "the nice level is ignored for realtime threads";
+    }
+    return errors.join(", ");
+}
+
+void ThreadMonitor::start()
+{
+    if (m_hasPolicy) {
+        m_placementError = applyPolicy();
+        if (!m_placementError.isEmpty()) {
+            qWarning() << "Thread placement of" << m_name << "failed:" << m_placementError;
+        }
+    }
+
+    m_timer = new QTimer(this);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, &ThreadMonitor::tick);
+    m_timer->start(TICK_INTERVAL);
+    m_jitter.start(Timer::systemTime());
+}
+
+QString ThreadMonitor::applyPolicy()
+{
+    const QString invalid = validatePolicy(m_policy);
+    if (!invalid.isEmpty()) {
+        // rather run with the default settings than with half of a policy
+        return "invalid policy: " + invalid;
+    }
+
+#ifdef Q_OS_LINUX
+    QStringList errors;
+    // must be called from the monitored thread, the calls only affect the calling thread
+    if (m_policy.cpu_size() > 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (uint32_t cpu : m_policy.cpu()) {
+            CPU_SET(cpu, &cpus);
+        }
+        const int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (error != 0) {
+            errors << QString("could not set cpu affinity: %1").arg(std::strerror(error));
+        }
+    }
+
+    if (m_policy.has_realtime_priority()) {
+        sched_param param;
+        param.sched_priority = m_policy.realtime_priority();
+        const int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (error == EPERM) {
+            errors << "realtime scheduling requires CAP_SYS_NICE or an rtprio limit, the thread keeps the default scheduler";
+        } else if (error != 0) {
+            errors << QString("could not enable realtime scheduling: %1").arg(std::strerror(error));
+        }
+    } else if (m_policy.has_nice()) {
+        // on linux the nice level is a per thread attribute
+        const pid_t tid = syscall(SYS_gettid);
+        if (setpriority(PRIO_PROCESS, tid, m_policy.nice()) != 0) {
+            errors << QString("could not set nice level: %1").arg(std::strerror(errno));
+        }
+    }
+    return errors.join(", ");
+#else
+    return "thread placement is only supported on linux";
+#endif
+}
+
+void ThreadMonitor::tick()
+{
+    m_jitter.tick(Timer::systemTime());
+    if (m_jitter.ticks() < TICKS_PER_REPORT) {
+        return;
+    }
+
+    Status status(new amun::Status);
+    amun::ThreadJitter *jitter = status->mutable_timing()->add_thread_jitter();
+    jitter->set_thread(m_name.toStdString());
+    m_jitter.report(*jitter);
+    if (!m_placementError.isEmpty()) {
+        jitter->set_placement_error(m_placementError.toStdString());
+    }
+    emit sendStatus(status);
+}
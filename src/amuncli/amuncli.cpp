@@ -43,6 +43,7 @@ int main(int argc, char* argv[])
     QCommandLineOption strategyColorConfig({"c", "strategy-color"}, "Color(s) of the strategy to run, either yellow, blue or both, defaults to yellow", "color", "yellow");
     QCommandLineOption debugOption({"v", "verbose"}, "Dump raw strategy output");
     QCommandLineOption simulatorConfig({"s", "simulator-config"}, "Which simulator config to use (field size etc.), loaded from the config directory", "file");
+    QCommandLineOption kinematicSimulation("kinematic", "Use the faster kinematic simulator backend instead of the bullet physics simulation");
     QCommandLineOption simulationTime({"t", "simulation-time"}, "Number of seconds to simulator, infinite running if missing", "seconds", "-1");
     QCommandLineOption numberOfRobots({"n", "num-robots"}, "Number of robots to load per team. Defaults to zero", "num-robots", "0");
     QCommandLineOption robotGenerationFile("robot-generation", "Robot generation to create the robots of", "generation");
@@ -59,6 +60,7 @@ int main(int argc, char* argv[])
     parser.addOption(strategyColorConfig);
     parser.addOption(debugOption);
     parser.addOption(simulatorConfig);
+    parser.addOption(kinematicSimulation);
     parser.addOption(simulationTime);
     parser.addOption(numberOfRobots);
     parser.addOption(robotGenerationFile);
@@ -121,7 +123,10 @@ int main(int argc, char* argv[])
         }
     }
     if (parser.isSet(simulatorConfig)) {
-        connector.setSimulatorConfigFile(parser.value(simulatorConfig));
+        connector.setSimulatorConfigFile(parser.value(simulatorConfig), parser.isSet(kinematicSimulation));
+    } else if (parser.isSet(kinematicSimulation)) {
+        std::cerr <<"Option kinematic must be specified together with a simulator-config"<<std::endl;
+        exit(1);
     }
     if (parser.isSet(robotGenerationFile)) {
         connector.setRobotConfiguration(numRobots, parser.value(robotGenerationFile));
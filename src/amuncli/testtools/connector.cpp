@@ -139,12 +139,15 @@ void Connector::setMaxBacklog(size_t newMax)
     m_maxBacklogFiles = newMax;
 }
 
-void Connector::setSimulatorConfigFile(const QString &shortFile)
+void Connector::setSimulatorConfigFile(const QString &shortFile, bool kinematic)
 {
     Command command(new amun::Command);
     if (!loadConfiguration("simulator/" + shortFile, command->mutable_simulator()->mutable_simulator_setup(), false)) {
         delayedExit(1);
     }
+    if (kinematic) {
+        command->mutable_simulator()->mutable_simulator_setup()->set_backend(amun::SimulatorSetup::Kinematic);
+    }
 
     emit sendCommand(command);
 }
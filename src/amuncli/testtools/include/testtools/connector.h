@@ -51,7 +51,7 @@ public:
     void setEntryPoint(const QString &entryPoint);
     void setStrategyColors(bool runBlue, bool runYellow);
     void setDebug(bool debug);
-    void setSimulatorConfigFile(const QString &shortFile);
+    void setSimulatorConfigFile(const QString &shortFile, bool kinematic = false);
     void setSimulationRunningTime(int seconds);
     void setRobotConfiguration(int numRobots, const QString &generation);
     void setRecordLogfile(const QString &filename);
@@ -0,0 +1,183 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "ballprediction.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static const float GRAVITY = 9.81f;
+// the ball is considered to be rolling once a bounce is slower than this
+static const float MIN_BOUNCE_SPEED = 0.1f;
+static const int MAX_BOUNCES = 10;
+static const float MIN_SPEED = 0.001f;
+// fraction of the speed that remains after hitting a robot
+static const float REFLECTION_DAMPING = 0.5f;
+static const int MAX_REFLECTIONS = 4;
+// avoid predicting forever without a slow deceleration
+static const float MAX_ROLL_TIME = 30.0f;
+
+BallPrediction::BallPrediction(const world::BallModel &model, const State &ball, float shotSpeed, const std::vector<Circle> &robots)
+{
+    State state = ball;
+    float time = 0;
+    addFlight(model, state, time);
+    addGround(model, state, time, shotSpeed, robots);
+    m_segments.push_back({time, std::numeric_limits<float>::infinity(), state.pos, Vector(0, 0), 0, 0, false, 0, 0});
+}
+
+void BallPrediction::addFlight(const world::BallModel &model, State &ball, float &time)
+{
+    for (int i = 0; i < MAX_BOUNCES; i++) {
+        if (ball.z <= 0 && ball.vz < MIN_BOUNCE_SPEED) {
+            break;
+        }
+        const float duration = (ball.vz + std::sqrt(ball.vz * ball.vz + 2 * GRAVITY * std::max(ball.z, 0.0f))) / GRAVITY;
+        const float speed = ball.speed.length();
+        const Vector dir = speed > 0 ? ball.speed / speed : Vector(0, 0);
+        m_segments.push_back({time, duration, ball.pos, dir, speed, 0, true, ball.z, ball.vz});
+
+        ball.pos += ball.speed * duration;
+        ball.speed *= model.xy_damping();
+        ball.vz = (GRAVITY * duration - ball.vz) * model.z_damping();
+        ball.z = 0;
+        time += duration;
+    }
+    ball.z = 0;
+    ball.vz = 0;
+}
+
+void BallPrediction::addGround(const world::BallModel &model, State &ball, float &time, float shotSpeed, const std::vector<Circle> &robots)
+{
+    const float switchSpeed = shotSpeed > 0 ? shotSpeed * model.switch_ratio() : 0;
+    // the phase is tracked explicitly, the speed after sliding may be slightly above switchSpeed
+    bool sliding = shotSpeed > 0 && ball.speed.length() > switchSpeed && model.fast_deceleration() > 0;
+    // every segment ends with a reflection, the end of sliding or the stop of the ball
+    for (int i = 0; i < MAX_REFLECTIONS + 2; i++) {
+        const float speed = ball.speed.length();
+        if (speed <= MIN_SPEED) {
+            break;
+        }
+        sliding = sliding && speed > switchSpeed;
+        const float deceleration = sliding ? model.fast_deceleration() : std::max(model.slow_deceleration(), 0.0f);
+        const float endSpeed = sliding ? switchSpeed : 0;
+        const float duration = deceleration > 0 ? (speed - endSpeed) / deceleration : MAX_ROLL_TIME;
+        Segment segment{time, duration, ball.pos, ball.speed / speed, speed, deceleration, false, 0, 0};
+
+        float hitDistance = distanceAfter(segment, duration);
+        const Circle *hit = nullptr;
+        if (m_reflections < MAX_REFLECTIONS) {
+            for (const Circle &robot : robots) {
+                const float radius = robot.radius + BALL_RADIUS;
+                const Vector toRobot = robot.center - ball.pos;
+                const float along = toRobot.dot(segment.dir);
+                const float perpendicularSq = toRobot.lengthSquared() - along * along;
+                if (perpendicularSq >= radius * radius || toRobot.lengthSquared() <= radius * radius) {
+                    continue;
+                }
+                const float entry = along - std::sqrt(radius * radius - perpendicularSq);
+                if (entry >= 0 && entry < hitDistance) {
+                    hitDistance = entry;
+                    hit = &robot;
+                }
+            }
+        }
+
+        if (!hit) {
+            m_segments.push_back(segment);
+            ball.pos += segment.dir * hitDistance;
+            ball.speed = segment.dir * endSpeed;
+            time += duration;
+            if (!sliding) {
+                break;
+            }
+            sliding = false;
+            continue;
+        }
+
+        segment.duration = timeForDistance(segment, hitDistance);
+        m_segments.push_back(segment);
+        ball.pos += segment.dir * hitDistance;
+        const Vector speedAtHit = segment.dir * std::max(speed - deceleration * segment.duration, 0.0f);
+        const Vector normal = (ball.pos - hit->center).normalized();
+        ball.speed = (speedAtHit - normal * (2 * speedAtHit.dot(normal))) * REFLECTION_DAMPING;
+        time += segment.duration;
+        m_reflections++;
+    }
+    ball.speed = Vector(0, 0);
+}
+
+float BallPrediction::distanceAfter(const Segment &s, float time)
+{
+    return s.speed * time - 0.5f * s.deceleration * time * time;
+}
+
+float BallPrediction::timeForDistance(const Segment &s, float distance)
+{
+    if (s.deceleration <= 0) {
+        return distance / s.speed;
+    }
+    const float discriminant = std::max(s.speed * s.speed - 2 * s.deceleration * distance, 0.0f);
+    return (s.speed - std::sqrt(discriminant)) / s.deceleration;
+}
+
+BallPrediction::State BallPrediction::stateAt(float time) const
+{
+    auto it = std::upper_bound(m_segments.begin(), m_segments.end(), time, [](float t, const Segment &s) {
+        return t < s.startTime;
+    });
+    const Segment &s = it == m_segments.begin() ? *it : *(it - 1);
+    const float t = std::min(std::max(time - s.startTime, 0.0f), s.duration);
+
+    State state;
+    state.pos = s.pos + s.dir * distanceAfter(s, t);
+    state.speed = s.dir * (s.speed - s.deceleration * t);
+    if (s.flying) {
+        state.z = std::max(s.z + s.vz * t - 0.5f * GRAVITY * t * t, 0.0f);
+        state.vz = s.vz - GRAVITY * t;
+    }
+    return state;
+}
+
+float BallPrediction::timeToPoint(const Vector &point, float tolerance) const
+{
+    const float toleranceSq = tolerance * tolerance;
+    for (const Segment &s : m_segments) {
+        if (s.speed <= 0) {
+            if (s.pos.distanceSq(point) <= toleranceSq) {
+                return s.startTime;
+            }
+            continue;
+        }
+        const Vector toPoint = point - s.pos;
+        const float along = toPoint.dot(s.dir);
+        const float perpendicularSq = toPoint.lengthSquared() - along * along;
+        if (perpendicularSq > toleranceSq) {
+            continue;
+        }
+        const float offset = std::sqrt(toleranceSq - perpendicularSq);
+        const float entry = std::max(along - offset, 0.0f);
+        if (along + offset < 0 || entry > distanceAfter(s, s.duration)) {
+            continue;
+        }
+        return s.startTime + timeForDistance(s, entry);
+    }
+    return -1;
+}
@@ -0,0 +1,81 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef BALLPREDICTION_H
+#define BALLPREDICTION_H
+
+#include "vector.h"
+#include "protobuf/world.pb.h"
+#include <vector>
+
+// Piecewise prediction of the ball movement using the same world::BallModel as the tracking.
+// The ball flies until it stops bouncing, then slides with the fast and rolls with the slow
+// deceleration. Rolling balls are reflected at circular robot obstacles.
+class BallPrediction
+{
+public:
+    struct State {
+        Vector pos = Vector(0, 0);
+        Vector speed = Vector(0, 0);
+        float z = 0;
+        float vz = 0;
+    };
+
+    struct Circle {
+        Vector center;
+        float radius;
+    };
+
+    // shotSpeed is the initial speed of the last shot, the ball only rolls if it is not positive
+    BallPrediction(const world::BallModel &model, const State &ball, float shotSpeed, const std::vector<Circle> &robots);
+
+    State stateAt(float time) const;
+    // earliest time at which the ball is within tolerance of point (only using the ground position),
+    // negative if the ball never gets there
+    float timeToPoint(const Vector &point, float tolerance) const;
+    float stopTime() const { return m_segments.back().startTime; }
+    int reflections() const { return m_reflections; }
+
+    static constexpr float BALL_RADIUS = 0.0215f;
+
+private:
+    struct Segment {
+        float startTime;
+        float duration;
+        Vector pos;
+        // unit vector of the ground movement direction, zero if the ball does not move on the ground
+        Vector dir;
+        float speed;
+        float deceleration;
+        bool flying;
+        float z;
+        float vz;
+    };
+
+    void addFlight(const world::BallModel &model, State &ball, float &time);
+    void addGround(const world::BallModel &model, State &ball, float &time, float shotSpeed, const std::vector<Circle> &robots);
+    static float distanceAfter(const Segment &s, float time);
+    static float timeForDistance(const Segment &s, float distance);
+
+    std::vector<Segment> m_segments;
+    int m_reflections = 0;
+};
+
+#endif // BALLPREDICTION_H
@@ -62,6 +62,7 @@ int main(int argc, char* argv[])
     QCommandLineOption cutPlot("cut-plot", "Remove plotted values");
     QCommandLineOption removeDebugValues("remove-debug-values", "Remove all debug values. This is equivalent to setting cut-debug-tree, cut-visualizations, cut-plot and cut-log-output");
     QCommandLineOption cutGit("cut-git", "Remove the git information");
+    QCommandLineOption compactTracking("compact-tracking", "Store the tracking output quantized to 0.1mm and delta coded");
 
     parser.addOption(flags);
     parser.addOption(cutHalt);
@@ -75,6 +76,7 @@ int main(int argc, char* argv[])
     parser.addOption(cutPlot);
     parser.addOption(removeDebugValues);
     parser.addOption(cutGit);
+    parser.addOption(compactTracking);
 
     // parse command line
     parser.process(app);
@@ -111,6 +113,8 @@ int main(int argc, char* argv[])
             options |= O::CutDebugTree | O::CutLogOutput | O::CutVisualizations | O::CutPlot;
         if (parser.isSet(cutGit))
             options |= O::CutGit;
+        if (parser.isSet(compactTracking))
+            options |= O::CompactTracking;
     }
 
     std::cout << "[ DEBUG] " << parser.value(outputLog).toStdString() << std::endl;
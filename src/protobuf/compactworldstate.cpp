@@ -0,0 +1,246 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "compactworldstate.h"
+#include <cmath>
+#include <string>
+#include <vector>
+
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
+
+// fixed point scale of float values
+static const double VALUE_SCALE = 10000;
+// larger values are not encoded to avoid overflows
+static const double MAX_VALUE = 1e6;
+
+// fields of world::State containing the tracking output
+static const int ENCODED_FIELDS[] = {
+    world::State::kBallFieldNumber,
+    world::State::kYellowFieldNumber,
+    world::State::kBlueFieldNumber,
+    world::State::kSimpleTrackingYellowFieldNumber,
+    world::State::kSimpleTrackingBlueFieldNumber,
+    world::State::kSimpleTrackingBallFieldNumber,
+    world::State::kRealityFieldNumber
+};
+
+static quint64 combineKey(quint64 key, quint64 value)
+{
+    // collisions only make the encoding less efficient
+    return (key ^ value) * 1099511628211ULL;
+}
+
+static const quint64 ROOT_KEY = 14695981039346656037ULL;
+
+// elements of repeated fields are matched by their id if they have one
+static quint64 elementKey(const Message &element, int index)
+{
+    const FieldDescriptor *id = element.GetDescriptor()->FindFieldByName("id");
+    if (id && id->cpp_type() == FieldDescriptor::CPPTYPE_UINT32 && !id->is_repeated()
+            && element.GetReflection()->HasField(element, id)) {
+        return 0x100000000ULL | element.GetReflection()->GetUInt32(element, id);
+    }
+    return index;
+}
+
+static bool isEncoded(const FieldDescriptor *field)
+{
+    return !field->is_repeated() && (field->cpp_type() == FieldDescriptor::CPPTYPE_FLOAT
+            || field->cpp_type() == FieldDescriptor::CPPTYPE_INT64);
+}
+
+// calls visit for every encoded field, in the same order for the encoder and the decoder
+template<typename Visitor>
+static bool walkMessage(Message *message, quint64 key, Visitor &visit);
+
+template<typename Visitor>
+static bool walkField(Message *message, const FieldDescriptor *field, quint64 key, Visitor &visit)
+{
+    const Reflection *reflection = message->GetReflection();
+    const quint64 fieldKey = combineKey(key, field->number());
+    if (field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+        if (field->is_repeated()) {
+            for (int i = 0; i < reflection->FieldSize(*message, field); i++) {
+                Message *element = reflection->MutableRepeatedMessage(message, field, i);
+                if (!walkMessage(element, combineKey(fieldKey, elementKey(*element, i)), visit)) {
+                    return false;
+                }
+            }
+        } else if (reflection->HasField(*message, field)) {
+            return walkMessage(reflection->MutableMessage(message, field), fieldKey, visit);
+        }
+        return true;
+    }
+    if (isEncoded(field)) {
+        return visit(message, field, fieldKey);
+    }
+    return true;
+}
+
+template<typename Visitor>
+static bool walkMessage(Message *message, quint64 key, Visitor &visit)
+{
+    const google::protobuf::Descriptor *descriptor = message->GetDescriptor();
+    for (int i = 0; i < descriptor->field_count(); i++) {
+        if (!walkField(message, descriptor->field(i), key, visit)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Visitor>
+static bool walkState(world::State *state, Visitor &visit)
+{
+    const google::protobuf::Descriptor *descriptor = state->GetDescriptor();
+    for (int number : ENCODED_FIELDS) {
+        if (!walkField(state, descriptor->FindFieldByNumber(number), ROOT_KEY, visit)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bool CompactWorldStateEncoder::encode(amun::Status *status)
+{
+    if (!status->has_world_state()) {
+        return false;
+    }
+    world::State skeleton(status->world_state());
+
+    std::vector<std::pair<quint64, qint64>> values;
+    std::vector<bool> presence;
+    auto extract = [&values, &presence](Message *message, const FieldDescriptor *field, quint64 key) {
+        const Reflection *reflection = message->GetReflection();
+        const bool present = reflection->HasField(*message, field);
+        if (field->is_required() && !present) {
+            return false;
+        } else if (!field->is_required()) {
+            presence.push_back(present);
+        }
+        if (!present) {
+            return true;
+        }
+        qint64 value;
+        if (field->cpp_type() == FieldDescriptor::CPPTYPE_FLOAT) {
+            const float f = reflection->GetFloat(*message, field);
+            if (!std::isfinite(f) || std::abs(f) > MAX_VALUE) {
+                return false;
+            }
+            value = std::llround(f * VALUE_SCALE);
+        } else {
+            value = reflection->GetInt64(*message, field);
+        }
+        values.emplace_back(key, value);
+        reflection->ClearField(message, field);
+        return true;
+    };
+    if (!walkState(&skeleton, extract)) {
+        return false;
+    }
+
+    world::CompactState *compact = status->mutable_compact_world_state();
+    compact->set_delta(m_hasPrevious);
+    skeleton.SerializePartialToString(compact->mutable_skeleton());
+    std::string *presenceBits = compact->mutable_presence();
+    presenceBits->assign((presence.size() + 7) / 8, 0);
+    for (std::size_t i = 0; i < presence.size(); i++) {
+        if (presence[i]) {
+            (*presenceBits)[i / 8] |= 1 << (i % 8);
+        }
+    }
+    compact->mutable_values()->Reserve(values.size());
+    for (const auto &value : values) {
+        qint64 &last = m_previous[value.first];
+        compact->add_values(value.second - last);
+        last = value.second;
+    }
+    m_hasPrevious = true;
+    status->clear_world_state();
+    return true;
+}
+
+void CompactWorldStateEncoder::reset()
+{
+    m_previous.clear();
+    m_hasPrevious = false;
+}
+
+
+bool CompactWorldStateDecoder::decode(amun::Status *status)
+{
+    if (!status->has_compact_world_state()) {
+        return false;
+    }
+    const world::CompactState &compact = status->compact_world_state();
+    if (!compact.delta()) {
+        reset();
+    } else if (!m_hasPrevious) {
+        status->clear_compact_world_state();
+        return false;
+    }
+
+    world::State state;
+    int presenceIndex = 0;
+    int valueIndex = 0;
+    auto restore = [this, &compact, &presenceIndex, &valueIndex](Message *message, const FieldDescriptor *field, quint64 key) {
+        if (!field->is_required()) {
+            const int index = presenceIndex++;
+            if (index / 8 >= int(compact.presence().size())) {
+                return false;
+            }
+            if ((compact.presence()[index / 8] & (1 << (index % 8))) == 0) {
+                return true;
+            }
+        }
+        if (valueIndex >= compact.values_size()) {
+            return false;
+        }
+        qint64 &value = m_previous[key];
+        value += compact.values(valueIndex++);
+        const Reflection *reflection = message->GetReflection();
+        if (field->cpp_type() == FieldDescriptor::CPPTYPE_FLOAT) {
+            reflection->SetFloat(message, field, float(value / VALUE_SCALE));
+        } else {
+            reflection->SetInt64(message, field, value);
+        }
+        return true;
+    };
+    if (!state.ParsePartialFromString(compact.skeleton()) || !walkState(&state, restore)
+            || valueIndex != compact.values_size()) {
+        // the following delta coded states can't be decoded anymore
+        reset();
+        status->clear_compact_world_state();
+        return false;
+    }
+    m_hasPrevious = true;
+    status->clear_compact_world_state();
+    status->mutable_world_state()->Swap(&state);
+    return true;
+}
+
+void CompactWorldStateDecoder::reset()
+{
+    m_previous.clear();
+    m_hasPrevious = false;
+}
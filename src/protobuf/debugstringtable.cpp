@@ -0,0 +1,174 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "debugstringtable.h"
+
+bool DebugStringInterner::intern(const std::string &str, quint32 &id)
+{
+    auto it = m_ids.find(str);
+    if (it != m_ids.end()) {
+        id = it->second;
+        return true;
+    }
+    if (m_strings.size() >= MAX_ENTRIES) {
+        return false;
+    }
+    id = m_strings.size();
+    m_ids.emplace(str, id);
+    m_strings.push_back(str);
+    return true;
+}
+
+void DebugStringInterner::compact(amun::DebugValues *debug)
+{
+    quint32 id;
+    for (amun::Visualization &vis : *debug->mutable_visualization()) {
+        if (vis.has_name() && intern(vis.name(), id)) {
+            vis.clear_name();
+            vis.set_name_id(id);
+        }
+    }
+    for (amun::DebugValue &value : *debug->mutable_value()) {
+        if (value.has_key() && intern(value.key(), id)) {
+            value.clear_key();
+            value.set_key_id(id);
+        }
+    }
+    for (amun::PlotValue &value : *debug->mutable_plot()) {
+        if (value.has_name() && intern(value.name(), id)) {
+            value.clear_name();
+            value.set_name_id(id);
+        }
+    }
+}
+
+void DebugStringInterner::flush(amun::DebugSource source, amun::Status *status)
+{
+    if (!m_resetPending && m_flushed == m_strings.size()) {
+        return;
+    }
+    amun::StringTable *table = status->add_string_table();
+    table->set_source(source);
+    if (m_resetPending) {
+        table->set_reset(true);
+        m_resetPending = false;
+    }
+    for (std::size_t i = m_flushed; i < m_strings.size(); i++) {
+        amun::StringTableEntry *entry = table->add_entry();
+        entry->set_id(i);
+        entry->set_value(m_strings[i]);
+    }
+    m_flushed = m_strings.size();
+}
+
+void DebugStringInterner::reset()
+{
+    m_ids.clear();
+    m_strings.clear();
+    m_flushed = 0;
+    m_resetPending = true;
+}
+
+
+QList<amun::DebugSource> DebugStringTable::update(const amun::Status &status)
+{
+    QList<amun::DebugSource> resetSources;
+    for (const amun::StringTable &table : status.string_table()) {
+        QHash<quint32, std::string> &strings = m_tables[table.source()];
+        if (table.reset()) {
+            if (!strings.isEmpty()) {
+                resetSources.append(table.source());
+            }
+            strings.clear();
+        }
+        for (const amun::StringTableEntry &entry : table.entry()) {
+            strings.insert(entry.id(), entry.value());
+        }
+    }
+    return resetSources;
+}
+
+void DebugStringTable::clear()
+{
+    m_tables.clear();
+}
+
+const std::string &DebugStringTable::string(amun::DebugSource source, quint32 id) const
+{
+    static const std::string unknown;
+    auto table = m_tables.constFind(source);
+    if (table == m_tables.constEnd()) {
+        return unknown;
+    }
+    auto it = table->constFind(id);
+    return it == table->constEnd() ? unknown : *it;
+}
+
+const std::string &DebugStringTable::name(amun::DebugSource source, const amun::Visualization &vis) const
+{
+    return vis.has_name_id() ? string(source, vis.name_id()) : vis.name();
+}
+
+const std::string &DebugStringTable::key(amun::DebugSource source, const amun::DebugValue &value) const
+{
+    return value.has_key_id() ? string(source, value.key_id()) : value.key();
+}
+
+const std::string &DebugStringTable::name(amun::DebugSource source, const amun::PlotValue &value) const
+{
+    return value.has_name_id() ? string(source, value.name_id()) : value.name();
+}
+
+void DebugStringTable::resolve(amun::DebugValues *debug) const
+{
+    const amun::DebugSource source = debug->source();
+    for (amun::Visualization &vis : *debug->mutable_visualization()) {
+        if (vis.has_name_id()) {
+            vis.set_name(string(source, vis.name_id()));
+            vis.clear_name_id();
+        }
+    }
+    for (amun::DebugValue &value : *debug->mutable_value()) {
+        if (value.has_key_id()) {
+            value.set_key(string(source, value.key_id()));
+            value.clear_key_id();
+        }
+    }
+    for (amun::PlotValue &value : *debug->mutable_plot()) {
+        if (value.has_name_id()) {
+            value.set_name(string(source, value.name_id()));
+            value.clear_name_id();
+        }
+    }
+}
+
+void DebugStringTable::writeTo(amun::Status *status) const
+{
+    for (auto it = m_tables.constBegin(); it != m_tables.constEnd(); ++it) {
+        amun::StringTable *table = status->add_string_table();
+        table->set_source(static_cast<amun::DebugSource>(it.key()));
+        table->set_reset(true);
+        for (auto entry = it->constBegin(); entry != it->constEnd(); ++entry) {
+            amun::StringTableEntry *e = table->add_entry();
+            e->set_id(entry.key());
+            e->set_value(entry.value());
+        }
+    }
+}
@@ -0,0 +1,49 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "debugsubscription.h"
+
+void DebugSubscription::update(const amun::CommandDebugSubscription &subscription)
+{
+    m_all = subscription.all();
+    m_debugValues = subscription.debug_values();
+    m_plots = subscription.plots();
+    m_truth = subscription.truth();
+    m_visualizations.clear();
+    m_visualizations.insert(subscription.visualization().begin(), subscription.visualization().end());
+    // the consumer might have forgotten unsubscribed names
+    m_announced.clear();
+}
+
+bool DebugSubscription::isVisualizationEnabled(const std::string &name) const
+{
+    return m_all || m_visualizations.count(name) > 0;
+}
+
+bool DebugSubscription::requestVisualization(amun::DebugValues *debug, const std::string &name)
+{
+    if (isVisualizationEnabled(name)) {
+        return true;
+    }
+    if (m_announced.insert(name).second) {
+        debug->add_visualization()->set_name(name);
+    }
+    return false;
+}
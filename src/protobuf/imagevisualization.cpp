@@ -0,0 +1,345 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "imagevisualization.h"
+#include <cstring>
+
+static const std::size_t PIXEL_SIZE = 4;
+static const std::size_t MAX_PALETTE_SIZE = 256;
+
+static bool findChangedRegion(const std::string &last, const std::string &current, int width, int height, QRect &region)
+{
+    const std::size_t rowSize = width * PIXEL_SIZE;
+    int top = -1;
+    int bottom = -1;
+    int left = width;
+    int right = -1;
+    for (int y = 0; y < height; y++) {
+        const char *a = last.data() + y * rowSize;
+        const char *b = current.data() + y * rowSize;
+        if (std::memcmp(a, b, rowSize) == 0) {
+            continue;
+        }
+        if (top < 0) {
+            top = y;
+        }
+        bottom = y;
+        for (int x = 0; x < left; x++) {
+            if (std::memcmp(a + x * PIXEL_SIZE, b + x * PIXEL_SIZE, PIXEL_SIZE) != 0) {
+                left = x;
+                break;
+            }
+        }
+        for (int x = width - 1; x > right; x--) {
+            if (std::memcmp(a + x * PIXEL_SIZE, b + x * PIXEL_SIZE, PIXEL_SIZE) != 0) {
+                right = x;
+                break;
+            }
+        }
+    }
+    if (top < 0) {
+        return false;
+    }
+    region = QRect(left, top, right - left + 1, bottom - top + 1);
+    return true;
+}
+
+static std::string extractRegion(const std::string &pixels, int width, const QRect &region)
+{
+    const std::size_t rowSize = region.width() * PIXEL_SIZE;
+    std::string result;
+    result.reserve(rowSize * region.height());
+    for (int y = region.top(); y <= region.bottom(); y++) {
+        result.append(pixels, (y * width + region.left()) * PIXEL_SIZE, rowSize);
+    }
+    return result;
+}
+
+static std::string runLengthEncode(const std::string &data, std::size_t unitSize)
+{
+    std::string result;
+    for (std::size_t i = 0; i < data.size();) {
+        std::size_t run = 1;
+        while (run < 256 && i + (run + 1) * unitSize <= data.size()
+               && std::memcmp(data.data() + i, data.data() + i + run * unitSize, unitSize) == 0) {
+            run++;
+        }
+        result.push_back(char(run - 1));
+        result.append(data, i, unitSize);
+        i += run * unitSize;
+        // give up early if the data does not compress
+        if (result.size() >= data.size()) {
+            break;
+        }
+    }
+    return result;
+}
+
+static bool runLengthDecode(const std::string &data, std::size_t unitSize, std::size_t size, std::string &result)
+{
+    result.clear();
+    result.reserve(size);
+    for (std::size_t i = 0; i < data.size(); i += unitSize + 1) {
+        const std::size_t run = static_cast<unsigned char>(data[i]) + 1;
+        if (i + 1 + unitSize > data.size() || result.size() + run * unitSize > size) {
+            return false;
+        }
+        for (std::size_t r = 0; r < run; r++) {
+            result.append(data, i + 1, unitSize);
+        }
+    }
+    return result.size() == size;
+}
+
+static void packPixels(amun::ImageVisualization *image, const std::string &pixels)
+{
+    const std::size_t pixelCount = pixels.size() / PIXEL_SIZE;
+
+    // images with few colors are stored using a palette
+    std::unordered_map<quint32, unsigned char> indices;
+    std::string palette;
+    std::string indexed(pixelCount, 0);
+    bool usePalette = true;
+    for (std::size_t i = 0; i < pixelCount; i++) {
+        quint32 color;
+        std::memcpy(&color, pixels.data() + i * PIXEL_SIZE, PIXEL_SIZE);
+        auto it = indices.find(color);
+        if (it == indices.end()) {
+            if (indices.size() == MAX_PALETTE_SIZE) {
+                usePalette = false;
+                break;
+            }
+            it = indices.emplace(color, indices.size()).first;
+            palette.append(pixels, i * PIXEL_SIZE, PIXEL_SIZE);
+        }
+        indexed[i] = it->second;
+    }
+
+    const std::string &data = usePalette ? indexed : pixels;
+    const std::size_t unitSize = usePalette ? 1 : PIXEL_SIZE;
+    std::string compressed = runLengthEncode(data, unitSize);
+    const bool useCompression = compressed.size() < data.size();
+
+    if (usePalette) {
+        image->set_format(amun::ImageVisualization::INDEXED);
+        image->set_palette(palette);
+    } else {
+        image->clear_format();
+        image->clear_palette();
+    }
+    if (useCompression) {
+        image->set_compression(amun::ImageVisualization::RUN_LENGTH);
+        image->set_data(std::move(compressed));
+    } else {
+        image->clear_compression();
+        image->set_data(data);
+    }
+}
+
+static bool unpackPixels(const amun::ImageVisualization &image, std::size_t pixelCount, std::string &pixels)
+{
+    const bool isIndexed = image.format() == amun::ImageVisualization::INDEXED;
+    const std::size_t unitSize = isIndexed ? 1 : PIXEL_SIZE;
+
+    const std::string *data = &image.data();
+    std::string decompressed;
+    if (image.compression() == amun::ImageVisualization::RUN_LENGTH) {
+        if (!runLengthDecode(image.data(), unitSize, pixelCount * unitSize, decompressed)) {
+            return false;
+        }
+        data = &decompressed;
+    }
+    if (data->size() != pixelCount * unitSize) {
+        return false;
+    }
+
+    if (!isIndexed) {
+        pixels = *data;
+        return true;
+    }
+    const std::string &palette = image.palette();
+    pixels.resize(pixelCount * PIXEL_SIZE);
+    for (std::size_t i = 0; i < pixelCount; i++) {
+        const std::size_t index = static_cast<unsigned char>((*data)[i]);
+        if ((index + 1) * PIXEL_SIZE > palette.size()) {
+            return false;
+        }
+        std::memcpy(&pixels[i * PIXEL_SIZE], palette.data() + index * PIXEL_SIZE, PIXEL_SIZE);
+    }
+    return true;
+}
+
+void ImageVisualizationEncoder::encode(amun::DebugValues *debug)
+{
+    for (amun::Visualization &vis : *debug->mutable_visualization()) {
+        if (!vis.has_image() || vis.name().empty()) {
+            continue;
+        }
+        amun::ImageVisualization *image = vis.mutable_image();
+        // images that are already encoded by the producer are passed on
+        if (image->has_id() || image->format() != amun::ImageVisualization::BGRA
+                || image->compression() != amun::ImageVisualization::NONE
+                || image->data().size() != std::size_t(image->width()) * image->height() * PIXEL_SIZE) {
+            continue;
+        }
+        encode(image, m_images[vis.name()]);
+    }
+}
+
+void ImageVisualizationEncoder::encode(amun::ImageVisualization *image, Image &last)
+{
+    const int width = image->width();
+    const int height = image->height();
+    const std::string drawArea = image->has_draw_area() ? image->draw_area().SerializeAsString() : std::string();
+
+    const bool canUseDelta = last.id != 0 && last.width == image->width() && last.height == image->height()
+            && last.drawArea == drawArea && last.framesSinceKeyframe < KEYFRAME_INTERVAL;
+    QRect region(0, 0, width, height);
+    if (canUseDelta && !findChangedRegion(last.pixels, image->data(), width, height, region)) {
+        image->set_data(std::string());
+        image->set_id(last.id);
+        image->set_base_id(last.id);
+        last.framesSinceKeyframe++;
+        return;
+    }
+    // large changes are sent as full image
+    const bool isDelta = canUseDelta && region.width() * region.height() * 2 <= width * height;
+
+    const quint32 baseId = last.id;
+    last.pixels.swap(*image->mutable_data());
+    last.id = m_nextId++;
+    if (m_nextId == 0) {
+        m_nextId = 1;
+    }
+    last.width = image->width();
+    last.height = image->height();
+    last.drawArea = drawArea;
+    last.framesSinceKeyframe = isDelta ? last.framesSinceKeyframe + 1 : 0;
+
+    image->set_id(last.id);
+    if (isDelta) {
+        image->set_base_id(baseId);
+        amun::ImageRegion *area = image->mutable_update_area();
+        area->set_x(region.x());
+        area->set_y(region.y());
+        area->set_width(region.width());
+        area->set_height(region.height());
+        packPixels(image, extractRegion(last.pixels, width, region));
+    } else {
+        packPixels(image, last.pixels);
+    }
+}
+
+void ImageVisualizationEncoder::reset()
+{
+    m_images.clear();
+}
+
+bool ImageVisualizationKeyframes::update(const amun::Status &status, const DebugStringTable &strings)
+{
+    bool needsKeyframe = false;
+    for (const amun::DebugValues &debug : status.debug()) {
+        for (const amun::Visualization &vis : debug.visualization()) {
+            if (!vis.has_image() || !vis.image().has_id()) {
+                continue;
+            }
+            const amun::ImageVisualization &image = vis.image();
+            Image &last = m_images[debug.source()][strings.name(debug.source(), vis)];
+            QRect updated;
+            if (!decodeImageVisualization(image, last.valid ? last.id : 0, last.pixels, updated)) {
+                last.valid = false;
+                continue;
+            }
+            last.id = image.id();
+            last.valid = true;
+            if (!image.has_base_id()) {
+                last.needsKeyframe = false;
+            } else if (last.needsKeyframe) {
+                needsKeyframe = true;
+            }
+        }
+    }
+    return needsKeyframe;
+}
+
+void ImageVisualizationKeyframes::makeKeyframes(amun::Status *status, const DebugStringTable &strings)
+{
+    for (amun::DebugValues &debug : *status->mutable_debug()) {
+        for (amun::Visualization &vis : *debug.mutable_visualization()) {
+            if (!vis.has_image() || !vis.image().has_base_id()) {
+                continue;
+            }
+            Image &last = m_images[debug.source()][strings.name(debug.source(), vis)];
+            amun::ImageVisualization *image = vis.mutable_image();
+            if (!last.valid || !last.needsKeyframe || last.id != image->id()) {
+                continue;
+            }
+            image->clear_base_id();
+            image->clear_update_area();
+            packPixels(image, last.pixels);
+            last.needsKeyframe = false;
+        }
+    }
+}
+
+void ImageVisualizationKeyframes::requestKeyframes()
+{
+    for (auto &source : m_images) {
+        for (auto &image : source.second) {
+            image.second.needsKeyframe = true;
+        }
+    }
+}
+
+bool decodeImageVisualization(const amun::ImageVisualization &image, quint32 baseId, std::string &pixels, QRect &updated)
+{
+    const std::size_t width = image.width();
+    const std::size_t height = image.height();
+    if (!image.has_base_id()) {
+        if (!unpackPixels(image, width * height, pixels)) {
+            return false;
+        }
+        updated = QRect(0, 0, width, height);
+        return true;
+    }
+
+    if (image.base_id() != baseId || pixels.size() != width * height * PIXEL_SIZE) {
+        return false;
+    }
+    if (!image.has_update_area()) {
+        updated = QRect();
+        return true;
+    }
+
+    const amun::ImageRegion &area = image.update_area();
+    if (std::size_t(area.x()) + area.width() > width || std::size_t(area.y()) + area.height() > height) {
+        return false;
+    }
+    std::string region;
+    if (!unpackPixels(image, std::size_t(area.width()) * area.height(), region)) {
+        return false;
+    }
+    const std::size_t rowSize = area.width() * PIXEL_SIZE;
+    for (std::size_t y = 0; y < area.height(); y++) {
+        std::memcpy(&pixels[((area.y() + y) * width + area.x()) * PIXEL_SIZE], region.data() + y * rowSize, rowSize);
+    }
+    updated = QRect(area.x(), area.y(), area.width(), area.height());
+    return true;
+}
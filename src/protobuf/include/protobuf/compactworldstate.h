@@ -0,0 +1,67 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef COMPACTWORLDSTATE_H
+#define COMPACTWORLDSTATE_H
+
+#include "protobuf/status.pb.h"
+#include <QtGlobal>
+#include <unordered_map>
+
+//! @file compactworldstate.h
+//! @addtogroup protobuf
+//! @{
+
+// Compact encoding of the tracking output for archived logs.
+// The balls, robots and simulator states of a world state are stored as integer columns,
+// which are delta coded against the previous state that was encoded.
+// Float values are stored in fixed point with a precision of 1e-4, which is 0.1mm for
+// positions and 0.1mrad for angles. Time stamps are stored exactly, all other fields
+// are kept unchanged. The encoder and decoder have to process the same sequence of states,
+// a keyframe is created after every reset of the encoder.
+class CompactWorldStateEncoder
+{
+public:
+    // replaces world_state by compact_world_state, returns false and leaves the status
+    // unchanged if the world state contains values that can't be represented
+    bool encode(amun::Status *status);
+    void reset();
+
+private:
+    std::unordered_map<quint64, qint64> m_previous;
+    bool m_hasPrevious = false;
+};
+
+class CompactWorldStateDecoder
+{
+public:
+    // replaces compact_world_state by world_state, returns false if the state is invalid
+    // or depends on a state that was not decoded
+    bool decode(amun::Status *status);
+    void reset();
+
+private:
+    std::unordered_map<quint64, qint64> m_previous;
+    bool m_hasPrevious = false;
+};
+
+//! @}
+
+#endif // COMPACTWORLDSTATE_H
@@ -0,0 +1,85 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef DEBUGSTRINGTABLE_H
+#define DEBUGSTRINGTABLE_H
+
+#include "protobuf/status.pb.h"
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//! @file debugstringtable.h
+//! @addtogroup protobuf
+//! @{
+
+// Replaces the visualization names, debug keys and plot names of one debug source
+// by integer ids, every debug source needs its own interner.
+// The string for an id is only sent once using amun::StringTable.
+class DebugStringInterner
+{
+public:
+    void compact(amun::DebugValues *debug);
+    // appends the entries created since the last flush, the first flush resets the table
+    void flush(amun::DebugSource source, amun::Status *status);
+    // forget all ids, the next flush tells the receivers to drop their table
+    void reset();
+
+private:
+    bool intern(const std::string &str, quint32 &id);
+
+    // strings beyond this limit are kept inline to avoid unbounded growth
+    static const std::size_t MAX_ENTRIES = 20000;
+
+    std::unordered_map<std::string, quint32> m_ids;
+    std::vector<std::string> m_strings;
+    std::size_t m_flushed = 0;
+    bool m_resetPending = true;
+};
+
+// Collects the string tables of all debug sources and resolves the ids
+class DebugStringTable
+{
+public:
+    // returns the sources whose previously known ids were invalidated
+    QList<amun::DebugSource> update(const amun::Status &status);
+    void clear();
+    bool isEmpty() const { return m_tables.isEmpty(); }
+
+    const std::string &string(amun::DebugSource source, quint32 id) const;
+    const std::string &name(amun::DebugSource source, const amun::Visualization &vis) const;
+    const std::string &key(amun::DebugSource source, const amun::DebugValue &value) const;
+    const std::string &name(amun::DebugSource source, const amun::PlotValue &value) const;
+
+    // replaces all ids by their strings
+    void resolve(amun::DebugValues *debug) const;
+    // adds the complete tables of all sources
+    void writeTo(amun::Status *status) const;
+
+private:
+    QHash<int, QHash<quint32, std::string>> m_tables;
+};
+
+//! @}
+
+#endif // DEBUGSTRINGTABLE_H
@@ -0,0 +1,64 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef DEBUGSUBSCRIPTION_H
+#define DEBUGSUBSCRIPTION_H
+
+#include "protobuf/command.pb.h"
+#include "protobuf/status.pb.h"
+#include <string>
+#include <unordered_set>
+
+//! @file debugsubscription.h
+//! @addtogroup protobuf
+//! @{
+
+// Tracks which debug output is observed by a consumer.
+// Everything is enabled until the first subscription is received.
+class DebugSubscription
+{
+public:
+    void update(const amun::CommandDebugSubscription &subscription);
+
+    bool isAll() const { return m_all; }
+    bool isVisualizationEnabled(const std::string &name) const;
+    bool isAnyVisualizationEnabled() const { return m_all || !m_visualizations.empty(); }
+    bool isPlotEnabled() const { return m_all || m_plots; }
+    bool isDebugValueEnabled() const { return m_all || m_debugValues; }
+    bool isTruthEnabled() const { return m_all || m_truth; }
+
+    // returns whether the visualization should be drawn, otherwise an empty visualization
+    // is added once after each subscription update to make the name known to consumers
+    bool requestVisualization(amun::DebugValues *debug, const std::string &name);
+    // announces the names again, e.g. after the announcing visualizations were dropped
+    void clearAnnouncements() { m_announced.clear(); }
+
+private:
+    bool m_all = true;
+    bool m_debugValues = true;
+    bool m_plots = true;
+    bool m_truth = true;
+    std::unordered_set<std::string> m_visualizations;
+    std::unordered_set<std::string> m_announced;
+};
+
+//! @}
+
+#endif // DEBUGSUBSCRIPTION_H
@@ -0,0 +1,99 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef IMAGEVISUALIZATION_H
+#define IMAGEVISUALIZATION_H
+
+#include "protobuf/debug.pb.h"
+#include "protobuf/debugstringtable.h"
+#include <QRect>
+#include <QtGlobal>
+#include <string>
+#include <unordered_map>
+
+//! @file imagevisualization.h
+//! @addtogroup protobuf
+//! @{
+
+// Replaces the full BGRA images of one debug source by compact images.
+// Images are compared to the last image with the same name and only the
+// changed region is sent. The pixels are stored with a palette and run length
+// encoded if this reduces the size. A full image is sent periodically,
+// so that receivers starting in between can decode the images.
+class ImageVisualizationEncoder
+{
+public:
+    // has to be called before the visualization names are interned
+    void encode(amun::DebugValues *debug);
+    void reset();
+
+private:
+    struct Image {
+        quint32 id = 0;
+        quint32 width = 0;
+        quint32 height = 0;
+        std::string drawArea;
+        std::string pixels;
+        int framesSinceKeyframe = 0;
+    };
+
+    void encode(amun::ImageVisualization *image, Image &last);
+
+    // number of delta coded frames between full images
+    static const int KEYFRAME_INTERVAL = 50;
+
+    std::unordered_map<std::string, Image> m_images;
+    quint32 m_nextId = 1;
+};
+
+// Follows the images of a status stream and replaces delta coded images by full images.
+// Log writers use this to start every group with full images and log readers
+// to resolve the images of the packet they seek to.
+class ImageVisualizationKeyframes
+{
+public:
+    // decodes the images, returns whether delta coded images should be replaced by makeKeyframes
+    bool update(const amun::Status &status, const DebugStringTable &strings);
+    // replaces the delta coded images passed to the last update, if a keyframe was requested for them
+    void makeKeyframes(amun::Status *status, const DebugStringTable &strings);
+    // the next delta coded image of every name is replaced by a full image
+    void requestKeyframes();
+    void reset() { m_images.clear(); }
+
+private:
+    struct Image {
+        quint32 id = 0;
+        bool valid = false;
+        bool needsKeyframe = true;
+        std::string pixels;
+    };
+
+    // source -> visualization name -> last image
+    std::unordered_map<int, std::unordered_map<std::string, Image>> m_images;
+};
+
+// Decodes image into pixels, which are blue, green, red and alpha bytes.
+// For delta coded images, pixels has to contain the image with id baseId.
+// Returns false if the image is invalid or the base image is not available.
+bool decodeImageVisualization(const amun::ImageVisualization &image, quint32 baseId, std::string &pixels, QRect &updated);
+
+//! @}
+
+#endif // IMAGEVISUALIZATION_H
@@ -69,11 +69,18 @@ public:
     }
 
 private:
+    friend class StatusArenaPool;
+
     Status(amun::Status *status, google::protobuf::Arena* arena) {
         m_arenaStatus = status;
         m_arena = QSharedPointer<google::protobuf::Arena>(arena);
     }
 
+    Status(amun::Status *status, const QSharedPointer<google::protobuf::Arena> &arena) {
+        m_arenaStatus = status;
+        m_arena = arena;
+    }
+
     QSharedPointer<amun::Status> m_status;
     amun::Status *m_arenaStatus = nullptr;
     QSharedPointer<google::protobuf::Arena> m_arena;
@@ -0,0 +1,56 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef STATUSARENAPOOL_H
+#define STATUSARENAPOOL_H
+
+#include "protobuf/status.h"
+#include <QtGlobal>
+#include <memory>
+
+//! @file statusarenapool.h
+//! @addtogroup protobuf
+//! @{
+
+// Creates arena backed statuses for producers which assemble a status every frame.
+// The arena is returned to the pool as soon as the last copy of its status is destroyed,
+// which may happen in any thread, and is reset once it is reused. Every arena owns a preallocated block, thus a frame
+// that fits into the block does not allocate memory.
+class StatusArenaPool
+{
+public:
+    static const std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+    // more unused arenas than this are freed
+    static const std::size_t MAX_UNUSED = 8;
+
+    explicit StatusArenaPool(std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+    Status createStatus();
+
+    // number of memory blocks allocated by pooled arenas in the calling thread since the last call
+    static quint32 takeBlockAllocations();
+
+private:
+    struct Arenas;
+    std::shared_ptr<Arenas> m_arenas;
+};
+
+//! @}
+
+#endif // STATUSARENAPOOL_H
@@ -0,0 +1,51 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef VISIONFRAMES_H
+#define VISIONFRAMES_H
+
+#include "protobuf/ssl_wrapper.pb.h"
+#include "protobuf/world.pb.h"
+#include <QByteArray>
+#include <QtGlobal>
+
+//! @file visionframes.h
+//! @addtogroup protobuf
+//! @{
+
+// Access to the vision packets attached to a world state.
+// Current states carry the packets as received, old logs contain parsed packets.
+// Indices of both kinds are concatenated, starting with the parsed packets.
+
+// stores the packet without parsing it
+void addVisionFrame(world::State *state, const QByteArray &data, qint64 receiveTime);
+
+int visionFrameCount(const world::State &state);
+qint64 visionFrameTime(const world::State &state, int index);
+// parses the packet, returns false if it is invalid
+bool parseVisionFrame(const world::State &state, int index, SSL_WrapperPacket &packet);
+// returns the serialized packet
+QByteArray visionFrameData(const world::State &state, int index);
+// checks for a geometry packet without parsing the detection
+bool visionFrameHasGeometry(const world::State &state, int index);
+
+//! @}
+
+#endif // VISIONFRAMES_H
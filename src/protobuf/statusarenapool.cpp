@@ -0,0 +1,105 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "statusarenapool.h"
+#include <mutex>
+#include <vector>
+
+// only arenas of the pool use these functions, count per thread to attribute them to the producer
+static thread_local quint32 blockAllocations = 0;
+
+static void *allocateBlock(std::size_t size)
+{
+    blockAllocations++;
+    return ::operator new(size);
+}
+
+static void deallocateBlock(void *block, std::size_t)
+{
+    ::operator delete(block);
+}
+
+struct StatusArenaPool::Arenas
+{
+    struct Entry {
+        // the arena must be destroyed before its initial block
+        std::unique_ptr<char[]> block;
+        std::unique_ptr<google::protobuf::Arena> arena;
+    };
+
+    std::size_t blockSize;
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Entry>> unused;
+};
+
+StatusArenaPool::StatusArenaPool(std::size_t blockSize) :
+    m_arenas(std::make_shared<Arenas>())
+{
+    m_arenas->blockSize = blockSize;
+}
+
+Status StatusArenaPool::createStatus()
+{
+    std::unique_ptr<Arenas::Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(m_arenas->mutex);
+        if (!m_arenas->unused.empty()) {
+            entry = std::move(m_arenas->unused.back());
+            m_arenas->unused.pop_back();
+        }
+    }
+    if (entry) {
+        // keeps the initial block and frees everything else. The initial block belongs
+        // to the thread which resets the arena, thus this must happen in the producer thread
+        entry->arena->Reset();
+    } else {
+        entry.reset(new Arenas::Entry);
+        entry->block.reset(new char[m_arenas->blockSize]);
+        blockAllocations++;
+
+        google::protobuf::ArenaOptions options;
+        options.initial_block = entry->block.get();
+        options.initial_block_size = m_arenas->blockSize;
+        options.max_block_size = m_arenas->blockSize;
+        options.block_alloc = &allocateBlock;
+        options.block_dealloc = &deallocateBlock;
+        entry->arena.reset(new google::protobuf::Arena(options));
+    }
+
+    google::protobuf::Arena *arena = entry->arena.get();
+    // the pool may be destroyed before the status
+    std::shared_ptr<Arenas> arenas = m_arenas;
+    Arenas::Entry *released = entry.release();
+    QSharedPointer<google::protobuf::Arena> sharedArena(arena, [arenas, released](google::protobuf::Arena *) {
+        std::unique_ptr<Arenas::Entry> entry(released);
+        std::lock_guard<std::mutex> lock(arenas->mutex);
+        if (arenas->unused.size() < MAX_UNUSED) {
+            arenas->unused.push_back(std::move(entry));
+        }
+    });
+    return Status(google::protobuf::Arena::CreateMessage<amun::Status>(arena), sharedArena);
+}
+
+quint32 StatusArenaPool::takeBlockAllocations()
+{
+    const quint32 count = blockAllocations;
+    blockAllocations = 0;
+    return count;
+}
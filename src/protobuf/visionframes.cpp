@@ -0,0 +1,91 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "visionframes.h"
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
+using google::protobuf::internal::WireFormatLite;
+
+void addVisionFrame(world::State *state, const QByteArray &data, qint64 receiveTime)
+{
+    world::VisionFrame *frame = state->add_raw_vision_frames();
+    frame->set_data(data.constData(), data.size());
+    frame->set_receive_time(receiveTime);
+}
+
+int visionFrameCount(const world::State &state)
+{
+    return state.vision_frames_size() + state.raw_vision_frames_size();
+}
+
+qint64 visionFrameTime(const world::State &state, int index)
+{
+    if (index >= state.vision_frames_size()) {
+        return state.raw_vision_frames(index - state.vision_frames_size()).receive_time();
+    }
+    if (index < state.vision_frame_times_size()) {
+        return state.vision_frame_times(index);
+    }
+    return state.time();
+}
+
+bool parseVisionFrame(const world::State &state, int index, SSL_WrapperPacket &packet)
+{
+    if (index >= state.vision_frames_size()) {
+        const std::string &data = state.raw_vision_frames(index - state.vision_frames_size()).data();
+        return packet.ParseFromString(data);
+    }
+    packet.CopyFrom(state.vision_frames(index));
+    return true;
+}
+
+QByteArray visionFrameData(const world::State &state, int index)
+{
+    if (index >= state.vision_frames_size()) {
+        const std::string &data = state.raw_vision_frames(index - state.vision_frames_size()).data();
+        return QByteArray(data.data(), data.size());
+    }
+    const SSL_WrapperPacket &packet = state.vision_frames(index);
+    QByteArray data(packet.ByteSize(), 0);
+    if (!packet.SerializeToArray(data.data(), data.size())) {
+        return QByteArray();
+    }
+    return data;
+}
+
+bool visionFrameHasGeometry(const world::State &state, int index)
+{
+    if (index < state.vision_frames_size()) {
+        return state.vision_frames(index).has_geometry();
+    }
+    const std::string &data = state.raw_vision_frames(index - state.vision_frames_size()).data();
+    google::protobuf::io::CodedInputStream input(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+    // only walk the top level fields, the detection is skipped as a whole
+    while (const uint32_t tag = input.ReadTag()) {
+        if (WireFormatLite::GetTagFieldNumber(tag) == SSL_WrapperPacket::kGeometryFieldNumber) {
+            return true;
+        }
+        if (!WireFormatLite::SkipField(&input, tag)) {
+            return false;
+        }
+    }
+    return false;
+}
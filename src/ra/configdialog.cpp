@@ -29,9 +29,13 @@
 #include <QDebug>
 
 const uint DEFAULT_SYSTEM_DELAY = 30; // in ms
+const bool DEFAULT_SYSTEM_DELAY_AUTO = false;
 const uint DEFAULT_TRANSCEIVER_CHANNEL = 11;
+const uint DEFAULT_RESPONSE_INTERVAL = 0; // in ms
 const uint DEFAULT_VISION_PORT = SSL_VISION_PORT;
 const uint DEFAULT_REFEREE_PORT = SSL_GAME_CONTROLLER_PORT;
+const uint DEFAULT_BACKLOG_LENGTH = 20; // in s
+const uint DEFAULT_BACKLOG_DECIMATED_MEMORY = 32; // in MiB
 
 const bool DEFAULT_NETWORK_ENABLE = false;
 const QString DEFAULT_NETWORK_HOST = QStringLiteral("");
@@ -139,13 +143,18 @@ void ConfigDialog::sendConfiguration()
     Command command(new amun::Command);
     amun::TransceiverConfiguration *c = command->mutable_transceiver()->mutable_configuration();
     c->set_channel(ui->comboChannel->currentIndex());
+    command->mutable_transceiver()->set_response_interval_ms(ui->responseInterval->value());
 
     // from ms to ns
     command->mutable_tracking()->set_system_delay(ui->systemDelayBox->value() * 1000 * 1000);
+    command->mutable_tracking()->set_system_delay_auto(ui->systemDelayAuto->isChecked());
 
     command->mutable_amun()->set_vision_port(ui->visionPort->value());
     command->mutable_amun()->set_referee_port(ui->refPort->value());
 
+    command->mutable_record()->set_backlog_length(ui->backlogLength->value());
+    command->mutable_record()->set_backlog_decimated_memory(ui->backlogDecimatedMemory->value());
+
     command->mutable_transceiver()->set_use_network(ui->networkUse->isChecked());
     amun::HostAddress *nc = command->mutable_transceiver()->mutable_network_configuration();
     nc->set_host(ui->networkHost->text().toStdString());
@@ -172,6 +181,7 @@ void ConfigDialog::sendConfiguration()
                                  ui->ctrlClickSearch->text());
 
     emit setScrollSensitivity(ui->scrollSensitivitySpinBox->value());
+    emit setBacklogLength(ui->backlogLength->value());
 
     const auto style = QStyleFactory::create(ui->qStyle->currentText());
     const auto colorSchemeSetting = ui->colorScheme->currentText();
@@ -222,11 +232,16 @@ void ConfigDialog::load()
 {
     QSettings s;
     ui->comboChannel->setCurrentIndex(s.value("Transceiver/Channel", DEFAULT_TRANSCEIVER_CHANNEL).toUInt());
+    ui->responseInterval->setValue(s.value("Transceiver/ResponseInterval", DEFAULT_RESPONSE_INTERVAL).toUInt());
     ui->systemDelayBox->setValue(s.value("Tracking/SystemDelay", DEFAULT_SYSTEM_DELAY).toUInt()); // in ms
+    ui->systemDelayAuto->setChecked(s.value("Tracking/SystemDelayAuto", DEFAULT_SYSTEM_DELAY_AUTO).toBool());
 
     ui->visionPort->setValue(s.value("Amun/VisionPort2018", DEFAULT_VISION_PORT).toUInt());
     ui->refPort->setValue(s.value("Amun/RefereePort", DEFAULT_REFEREE_PORT).toUInt());
 
+    ui->backlogLength->setValue(s.value("Backlog/Length", DEFAULT_BACKLOG_LENGTH).toUInt());
+    ui->backlogDecimatedMemory->setValue(s.value("Backlog/DecimatedMemory", DEFAULT_BACKLOG_DECIMATED_MEMORY).toUInt());
+
     ui->networkUse->setChecked(s.value("Network/Use", DEFAULT_NETWORK_ENABLE).toBool());
     ui->networkHost->setText(s.value("Network/Host", DEFAULT_NETWORK_HOST).toString());
 
@@ -280,8 +295,11 @@ void ConfigDialog::reset()
 {
     ui->comboChannel->setCurrentIndex(DEFAULT_TRANSCEIVER_CHANNEL);
     ui->systemDelayBox->setValue(DEFAULT_SYSTEM_DELAY);
+    ui->systemDelayAuto->setChecked(DEFAULT_SYSTEM_DELAY_AUTO);
     ui->visionPort->setValue(DEFAULT_VISION_PORT);
     ui->refPort->setValue(DEFAULT_REFEREE_PORT);
+    ui->backlogLength->setValue(DEFAULT_BACKLOG_LENGTH);
+    ui->backlogDecimatedMemory->setValue(DEFAULT_BACKLOG_DECIMATED_MEMORY);
     ui->networkUse->setChecked(DEFAULT_NETWORK_ENABLE);
     ui->networkHost->setText(DEFAULT_NETWORK_HOST);
     ui->controlSimulator->setChecked(DEFAULT_CONTROL_SIMULATOR);
@@ -306,11 +324,16 @@ void ConfigDialog::apply()
 {
     QSettings s;
     s.setValue("Transceiver/Channel", ui->comboChannel->currentIndex());
+    s.setValue("Transceiver/ResponseInterval", ui->responseInterval->value());
     s.setValue("Tracking/SystemDelay", ui->systemDelayBox->value());
+    s.setValue("Tracking/SystemDelayAuto", ui->systemDelayAuto->isChecked());
 
     s.setValue("Amun/VisionPort2018", ui->visionPort->value());
     s.setValue("Amun/RefereePort", ui->refPort->value());
 
+    s.setValue("Backlog/Length", ui->backlogLength->value());
+    s.setValue("Backlog/DecimatedMemory", ui->backlogDecimatedMemory->value());
+
     s.setValue("Network/Use", ui->networkUse->isChecked());
     s.setValue("Network/Host", ui->networkHost->text());
     s.setValue("Network/ControlSimulator", ui->controlSimulator->isChecked());
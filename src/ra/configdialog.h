@@ -49,6 +49,7 @@ signals:
     void setRobotCtrlClickAction(FieldWidgetAction action, QString searchString);
 	void setPalette(QPalette palette);
     void setScrollSensitivity(float sensitivity);
+    void setBacklogLength(uint seconds); // a length of zero disables the full rate backlog
 
 public slots:
     void load();
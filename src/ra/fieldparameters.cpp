@@ -20,6 +20,7 @@
 
 #include "fieldparameters.h"
 #include "ui_fieldparameters.h"
+#include "protobuf/visionframes.h"
 
 #include <QSettings>
 
@@ -92,8 +93,13 @@ void FieldParameters::handleStatus(const Status &status)
         ui->fieldTypeText->setText(text);
     }
     if (status->has_world_state()) {
-        for (const auto &frame : status->world_state().vision_frames()) {
-            if (frame.has_geometry() && frame.geometry().has_models()) {
+        const world::State &worldState = status->world_state();
+        for (int i = 0; i < visionFrameCount(worldState); i++) {
+            SSL_WrapperPacket frame;
+            if (!visionFrameHasGeometry(worldState, i) || !parseVisionFrame(worldState, i, frame)) {
+                continue;
+            }
+            if (frame.geometry().has_models()) {
                 if (frame.geometry().models().has_straight_two_phase()) {
                     const auto &model = frame.geometry().models().straight_two_phase();
                     m_visionBallModel.set_fast_deceleration(-model.acc_slide());
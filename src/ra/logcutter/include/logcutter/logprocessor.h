@@ -52,7 +52,8 @@ public:
         CutLogOutput = 0x40,
         CutVisualizations = 0x80,
         CutPlot = 0x100,
-        CutGit = 0x200
+        CutGit = 0x200,
+        CompactTracking = 0x400
     };
     Q_DECLARE_FLAGS(Options, Option)
 
@@ -98,6 +98,9 @@ void LogCutter::startProcess()
     if (ui->cutGit->isChecked()) {
         options |= LogProcessor::CutGit;
     }
+    if (ui->compactTracking->isChecked()) {
+        options |= LogProcessor::CompactTracking;
+    }
 
     m_processor = new LogProcessor(inputFiles, outputFile, options, this);
     connect(m_processor, &LogProcessor::progressUpdate, this, &LogCutter::updateProgress);
@@ -22,6 +22,7 @@
 #include "seshat/seqlogfilereader.h"
 #include "seshat/logfilewriter.h"
 #include "seshat/logfilehasher.h"
+#include "protobuf/compactworldstate.h"
 #include "protobuf/gamestate.pb.h"
 #include "protobuf/status.pb.h"
 #include <QSemaphore>
@@ -148,6 +149,9 @@ void LogProcessor::run()
         qDeleteAll(logreaders);
         return;
     }
+    if (m_options & CompactTracking) {
+        writer.setEncodingProfile(LogFileWriter::EncodingProfile::CompactTracking);
+    }
 
     // setup pipeline
     Exchanger writerExchanger;
@@ -300,6 +304,7 @@ qint64 LogProcessor::filterLog(SeqLogFileReader &reader, Exchanger *writer, Exch
     Status modStatus;
     bool isSimulated = false;
     int currentFrame = 0;
+    CompactWorldStateDecoder worldStateDecoder;
     while(!reader.atEnd()){
         if ((currentFrame % 1000) == 0) {
             signalFrames("Processed", currentFrame, reader.percent());
@@ -311,6 +316,9 @@ qint64 LogProcessor::filterLog(SeqLogFileReader &reader, Exchanger *writer, Exch
         if (status.isNull()) {
             continue;
         }
+        if (status->has_compact_world_state()) {
+            worldStateDecoder.decode(&*status);
+        }
 
         if (status->has_log_id()) {
             status->clear_log_id();
@@ -333,15 +341,19 @@ qint64 LogProcessor::filterLog(SeqLogFileReader &reader, Exchanger *writer, Exch
         }
 
         if (skipStatus(lastGameState, isSimulated)) {
-            // the frame contains team settings, these MUST be retained
-            if (status->has_team_yellow() || status->has_team_blue()) {
-                modStatus = Status(new amun::Status);
+            // the frame contains team settings or debug string tables, these MUST be retained
+            if (status->has_team_yellow() || status->has_team_blue() || status->string_table_size() > 0) {
+                if (modStatus.isNull()) {
+                    modStatus = Status(new amun::Status);
+                }
                 if (status->has_team_yellow()) {
                     modStatus->mutable_team_yellow()->CopyFrom(status->team_yellow());
                 }
                 if (status->has_team_blue()) {
                     modStatus->mutable_team_blue()->CopyFrom(status->team_blue());
                 }
+                // keep the order of the string tables, they might reset each other
+                modStatus->mutable_string_table()->MergeFrom(status->string_table());
                 insertHashInfo(modStatus, loguid, currentFrame - 1);
             }
 
@@ -439,11 +451,15 @@ void LogProcessor::collectHashes(QList<SeqLogFileReader*> readers, Exchanger* wr
 void LogProcessor::reencode(SeqLogFileReader* reader, Exchanger* writer)
 {
     SeqLogFileReader::Memento mem = reader->createMemento();
+    CompactWorldStateDecoder worldStateDecoder;
     Status current = reader->readStatus();
     if (current->has_log_id()) qFatal("Reencode a logfile that already contains a logfile:uid");
     writer->transfer(current);
     for (int i = 1; !reader->atEnd(); ++i) {
         current = reader->readStatus();
+        if (!current.isNull() && current->has_compact_world_state()) {
+            worldStateDecoder.decode(&*current);
+        }
         writer->transfer(current);
         if (i % 1000 == 0) signalFrames("Rehash", i, reader->percent());
     }
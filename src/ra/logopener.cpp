@@ -52,6 +52,7 @@ LogOpener::LogOpener(Ui::MainWindow *ui, QObject *parent) :
         m_lastFilePositions[name] = index;
     }
     s.endArray();
+    ui->actionFollowLogfile->setChecked(s.value("follow logfile", false).toBool());
 
     makeRecentFileMenu();
 
@@ -66,6 +67,7 @@ LogOpener::LogOpener(Ui::MainWindow *ui, QObject *parent) :
     connect(ui->btnOpen, SIGNAL(clicked()), SLOT(openFile()));
     connect(ui->goToLastPosition, SIGNAL(clicked(bool)), SLOT(goToLastFilePosition()));
     connect(ui->actionOpen_Logfile, SIGNAL(triggered()), SLOT(openFile()));
+    connect(ui->actionFollowLogfile, SIGNAL(toggled(bool)), SLOT(followLogfile(bool)));
 }
 
 void LogOpener::close()
@@ -92,6 +94,8 @@ void LogOpener::saveConfig()
         s.setValue("position", m_lastFilePositions[filename]);
     }
     s.endArray();
+
+    s.setValue("follow logfile", ui->actionFollowLogfile->isChecked());
 }
 
 void LogOpener::showLastPosition(bool show)
@@ -118,7 +122,7 @@ void LogOpener::handleStatus(const Status& status)
             }
             makeRecentFileMenu();
         }
-        if (response.has_log_info()) {
+        if (response.has_log_info() && !response.log_info().appended()) {
             activateLastPosition(response.log_info().packet_count());
         }
     }
@@ -189,10 +193,21 @@ void LogOpener::openFile(const QString &filename)
         m_prelimFileName = filename; // Also FIXME: this is a relative path, an absolte path, an absolute mess, ...
         Command command(new amun::Command);
         command->mutable_playback()->mutable_log_path()->set_path(filename.toStdString());
+        if (ui->actionFollowLogfile->isChecked()) {
+            command->mutable_playback()->mutable_log_path()->set_follow(true);
+        }
         emit sendCommand(command);
     }
 }
 
+void LogOpener::followLogfile(bool follow)
+{
+    // also applies to the log which is currently open
+    Command command(new amun::Command);
+    command->mutable_playback()->set_follow_log(follow);
+    emit sendCommand(command);
+}
+
 void LogOpener::makeRecentFileMenu()
 {
     if (m_recentFiles.size() > 0) {
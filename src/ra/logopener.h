@@ -58,6 +58,7 @@ public slots:
     void openFile();
     void goToLastFilePosition();
     void useLogfileLocation(bool enabled);
+    void followLogfile(bool follow);
 
 private:
     void makeRecentFileMenu();
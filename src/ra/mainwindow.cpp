@@ -174,16 +174,27 @@ MainWindow::MainWindow(bool tournamentMode, bool isRa, bool broadcastUiCommands,
     connect(m_robotCtrlClickAction, SIGNAL(setDebugFilterString(QString)), ui->debugTree, SLOT(setFilter(QString)));
     connect(m_robotCtrlClickAction, SIGNAL(toggleVisualization(QString)), ui->visualization, SLOT(toggleVisualization(QString)));
 
+    connect(m_configDialog, &ConfigDialog::setBacklogLength, this, [this](uint seconds) {
+        if (m_isBacklogging != (seconds > 0)) {
+            m_isBacklogging = seconds > 0;
+            sendDebugSubscription();
+        }
+    });
     connect(m_configDialog, &ConfigDialog::setScrollSensitivity,
             ui->field, &FieldWidget::setScrollSensitivity);
 
     // setup visualization only parts of the ui
     connect(ui->visualization, SIGNAL(itemsChanged(QStringList)), ui->field, SLOT(visualizationsChanged(QStringList)));
+    connect(ui->visualization, SIGNAL(itemsChanged(QStringList)), SLOT(setSubscribedVisualizations(QStringList)));
 
     m_plotter = new Plotter();
     connect(m_plotter, SIGNAL(spacePressed()), this, SLOT(togglePause()));
+    connect(m_plotter, &Plotter::visibilityChanged, this, &MainWindow::setPlotterVisible);
+    connect(ui->field, &FieldWidget::showTruthChanged, this, &MainWindow::setShowTruth);
 
     connect(ui->debugTree, SIGNAL(triggerBreakpoint()), SLOT(pauseAll()));
+    // debug values are only requested while the debug tree is not collapsed
+    connect(ui->splitterH, &QSplitter::splitterMoved, this, &MainWindow::updateDebugTreeVisible);
 
     // connect the menu actions
     connect(ui->actionEnableTransceiver, SIGNAL(toggled(bool)), SLOT(setTransceiver(bool)));
@@ -202,6 +213,7 @@ MainWindow::MainWindow(bool tournamentMode, bool isRa, bool broadcastUiCommands,
     connect(ui->actionAutoPause, SIGNAL(toggled(bool)), ui->simulator, SLOT(setEnableAutoPause(bool)));
     connect(ui->actionUseLocation, SIGNAL(toggled(bool)), this, SLOT(useLogfileLocation(bool)));
     connect(ui->actionUseLocation, SIGNAL(toggled(bool)), m_logOpener, SLOT(useLogfileLocation(bool)));
+    connect(ui->actionUseArchive, SIGNAL(toggled(bool)), this, SLOT(useLogArchive(bool)));
     connect(ui->actionChangeLocation, SIGNAL(triggered()), SLOT(showDirectoryDialog()));
     connect(ui->exportVision, &QAction::triggered, this, &MainWindow::exportVisionLog);
     connect(ui->getLogUid, &QAction::triggered, this, &MainWindow::requestLogUid);
@@ -243,6 +255,20 @@ MainWindow::MainWindow(bool tournamentMode, bool isRa, bool broadcastUiCommands,
     createLogWriterConnections(m_loggingUiRa);
     createLogWriterConnections(m_loggingUiHorus);
 
+    // request all debug output while a log is recorded
+    connect(m_loggingUiRa, &Logsuite::isLogging, this, [this](bool logging) {
+        if (m_isLoggingRa != logging) {
+            m_isLoggingRa = logging;
+            sendDebugSubscription();
+        }
+    });
+    connect(m_loggingUiHorus, &Logsuite::isLogging, this, [this](bool logging) {
+        if (m_isLoggingHorus != logging) {
+            m_isLoggingHorus = logging;
+            sendDebugSubscription();
+        }
+    });
+
     // disable all possibilities of skipping / going back packets when recording
     connect(m_loggingUiHorus, SIGNAL(isLogging(bool)), ui->logManager, SIGNAL(disableSkipping(bool)));
 
@@ -277,9 +303,11 @@ MainWindow::MainWindow(bool tournamentMode, bool isRa, bool broadcastUiCommands,
         }
     }
     connect(m_simulatorSetupGroup, SIGNAL(triggered(QAction*)), this, SLOT(simulatorSetupChanged(QAction*)));
-    connect(ui->actionSimulateWithBoundaries, &QAction::triggered, this, &MainWindow::simulateWithBoundariesChanged);
-    // restore actionSimulateWithBoundaries state, because it is needed in simulatorSetupChanged
+    connect(ui->actionSimulateWithBoundaries, &QAction::triggered, this, &MainWindow::simulatorOptionsChanged);
+    connect(ui->actionKinematicSimulation, &QAction::triggered, this, &MainWindow::simulatorOptionsChanged);
+    // restore the simulator options, because they are needed in simulatorSetupChanged
     ui->actionSimulateWithBoundaries->setChecked(s.value("Simulator/WithBoundaries").toBool());
+    ui->actionKinematicSimulation->setChecked(s.value("Simulator/Kinematic").toBool());
     if (selectedAction) {
         selectedAction->setChecked(true);
         simulatorSetupChanged(selectedAction);
@@ -308,6 +336,7 @@ MainWindow::MainWindow(bool tournamentMode, bool isRa, bool broadcastUiCommands,
     ui->actionInputDevices->setChecked(s.value("InputDevices/Enabled").toBool());
     ui->actionAutoPause->setChecked(s.value("Simulator/AutoPause", true).toBool());
     ui->actionUseLocation->setChecked(s.value("LogWriter/UseLocation", true).toBool());
+    ui->actionUseArchive->setChecked(s.value("LogWriter/UseArchive", false).toBool());
 
     ui->actionEnableTransceiver->setChecked(ui->actionSimulator->isChecked() ? m_transceiverSimulator : m_transceiverRealWorld);
     ui->actionChargeKicker->setChecked(ui->actionSimulator->isChecked() ? m_chargeSimulator : m_chargeRealWorld);
@@ -548,9 +577,11 @@ void MainWindow::saveConfig()
     s.setValue("Simulator/AutoPause", ui->actionAutoPause->isChecked());
     s.setValue("Simulator/Enabled", ui->actionSimulator->isChecked());
     s.setValue("Simulator/WithBoundaries", ui->actionSimulateWithBoundaries->isChecked());
+    s.setValue("Simulator/Kinematic", ui->actionKinematicSimulation->isChecked());
     s.setValue("Referee/Internal", ui->actionInternalReferee->isChecked());
     s.setValue("InputDevices/Enabled", ui->actionInputDevices->isChecked());
     s.setValue("LogWriter/UseLocation", ui->actionUseLocation->isChecked());
+    s.setValue("LogWriter/UseArchive", ui->actionUseArchive->isChecked());
 
     m_logOpener->saveConfig();
 }
@@ -628,6 +659,7 @@ void MainWindow::loadConfig(bool doRestoreGeometry, uint configId)
     ui->splitterV->restoreState(s.value("SplitterV").toByteArray());
     ui->splitterH->restoreState(s.value("SplitterH").toByteArray());
     s.endGroup();
+    updateDebugTreeVisible();
 }
 
 void MainWindow::switchToWidgetConfiguration(int configId, bool forceUpdate)
@@ -668,6 +700,11 @@ void MainWindow::simulatorSetupChanged(QAction * action)
         mutableSimulatorSetupGeometry->set_boundary_width(0.0);
     }
 
+    // the kinematic backend trades physical accuracy for speed
+    if (ui->actionKinematicSimulation->isChecked()) {
+        command->mutable_simulator()->mutable_simulator_setup()->set_backend(amun::SimulatorSetup::Kinematic);
+    }
+
     // reload the strategies / autoref
     sendCommand(command);
 
@@ -810,6 +847,13 @@ void MainWindow::useLogfileLocation(bool enable)
     sendCommand(command);
 }
 
+void MainWindow::useLogArchive(bool enable)
+{
+    Command command(new amun::Command);
+    command->mutable_record()->set_use_archive(enable);
+    sendCommand(command);
+}
+
 void MainWindow::exportVisionLog()
 {
     QString filename = QFileDialog::getSaveFileName(this, "Save file location", "", "Vision log files (*.log)");
@@ -845,6 +889,49 @@ void MainWindow::requestUidInsertWindow()
     input->show();
 }
 
+void MainWindow::setSubscribedVisualizations(const QStringList &visualizations)
+{
+    m_subscribedVisualizations = visualizations;
+    sendDebugSubscription();
+}
+
+void MainWindow::setPlotterVisible(bool visible)
+{
+    m_plotterVisible = visible;
+    sendDebugSubscription();
+}
+
+void MainWindow::setShowTruth(bool show)
+{
+    m_showTruth = show;
+    sendDebugSubscription();
+}
+
+void MainWindow::updateDebugTreeVisible()
+{
+    const bool visible = ui->splitterH->sizes().value(0) > 0;
+    if (visible != m_debugTreeVisible) {
+        m_debugTreeVisible = visible;
+        sendDebugSubscription();
+    }
+}
+
+void MainWindow::sendDebugSubscription()
+{
+    Command command(new amun::Command);
+    amun::CommandDebugSubscription *subscription = command->mutable_debug_subscription();
+    // everything that is recorded has to be generated
+    subscription->set_all(m_isLoggingRa || m_isLoggingHorus || m_isBacklogging);
+    subscription->set_debug_values(m_debugTreeVisible);
+    subscription->set_plots(m_plotterVisible);
+    // the plotter and the field widget show the ground truth of the simulator
+    subscription->set_truth(m_plotterVisible || m_showTruth);
+    for (const QString &name : m_subscribedVisualizations) {
+        subscription->add_visualization(name.toStdString());
+    }
+    sendCommand(command);
+}
+
 void MainWindow::sendCommand(const Command &command)
 {
     if (m_uiCommandServer) {
@@ -1153,6 +1240,6 @@ void MainWindow::broadcastCommandsChanged(const bool state)
     }
 }
 
-void MainWindow::simulateWithBoundariesChanged() {
+void MainWindow::simulatorOptionsChanged() {
     simulatorSetupChanged(m_simulatorSetupGroup->checkedAction());
 }
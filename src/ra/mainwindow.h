@@ -87,7 +87,7 @@ private slots:
     void liveMode();
     void showBacklogMode();
     void simulatorSetupChanged(QAction * action);
-    void simulateWithBoundariesChanged();
+    void simulatorOptionsChanged();
     void saveConfig();
     void switchToWidgetConfiguration(int configId, bool forceUpdate = false);
     void showDirectoryDialog();
@@ -97,6 +97,7 @@ private slots:
     void setSpeed(int speed);
     void udpateSpeedActionsEnabled();
     void useLogfileLocation(bool enable);
+    void useLogArchive(bool enable);
     void exportVisionLog();
     void requestLogUid();
     void searchUid(QString uid);
@@ -105,6 +106,9 @@ private slots:
     void updatePalette(QPalette palette);
     void pauseAll();
     void broadcastCommandsChanged(const bool);
+    void setSubscribedVisualizations(const QStringList &visualizations);
+    void setPlotterVisible(bool visible);
+    void setShowTruth(bool show);
 
 private:
     void toggleHorusModeWidgets(bool enable);
@@ -112,6 +116,8 @@ private:
     void raMode();
     void horusMode();
     void createLogWriterConnections(Logsuite *suite);
+    void sendDebugSubscription();
+    void updateDebugTreeVisible();
 
 private:
     Ui::MainWindow *ui;
@@ -128,6 +134,14 @@ private:
     qint32 m_lastStageTime;
     LogLabel *m_logTimeLabel;
     Logsuite *m_loggingUiRa, *m_loggingUiHorus;
+    QStringList m_subscribedVisualizations;
+    bool m_plotterVisible = false;
+    bool m_showTruth = false;
+    bool m_debugTreeVisible = true;
+    // the full rate backlog can be saved as a log at any time, thus it must contain all debug output
+    bool m_isBacklogging = true;
+    bool m_isLoggingRa = false;
+    bool m_isLoggingHorus = false;
     amun::GameState::State m_lastRefState;
     DebuggerConsole *m_console;
     bool m_isTournamentMode;
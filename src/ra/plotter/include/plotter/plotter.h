@@ -21,6 +21,7 @@
 #ifndef PLOTTER_H
 #define PLOTTER_H
 
+#include "protobuf/debugstringtable.h"
 #include "protobuf/status.h"
 #include "protobuf/world.pb.h"
 #include <QDialog>
@@ -58,6 +59,7 @@ signals:
     void addPlot(const Plot *plot);
     void removePlot(const Plot *plot);
     void spacePressed();
+    void visibilityChanged(bool visible);
 
 protected:
     void closeEvent(QCloseEvent *event) override;
@@ -95,6 +97,9 @@ private:
     GuiTimer *m_guiTimer;
     QHash<QString, QStandardItem*> m_items;
     QHash<QString, QVector<QStandardItem *>> m_itemLookup;
+    DebugStringTable m_debugStrings;
+    // source -> plot name id -> item
+    QHash<int, QVector<QStandardItem *>> m_debugPlotLookup;
     QHash<QStandardItem*, Plot*> m_plots;
     QHash<QStandardItem*, Plot*> m_frozenPlots;
     QSet<QString> m_selection;
@@ -135,6 +135,7 @@ void Plotter::closeEvent(QCloseEvent *event)
     // just accepting and closing leads to segfaults when re-opening the widget
     this->hide();
     event->ignore();
+    emit visibilityChanged(false);
 }
 
 void Plotter::setScaling(float min, float max, float timespan)
@@ -266,10 +267,18 @@ void Plotter::showPlotter()
     // all incoming data has to wait until the backlog-status are consumed
     m_playingBacklog = true;
     show();
+    emit visibilityChanged(true);
 }
 
 void Plotter::handleStatus(const Status &status, bool backlogStatus)
 {
+    // the string tables are only sent once, thus track them even while closed
+    if (status->string_table_size() > 0) {
+        for (amun::DebugSource source : m_debugStrings.update(*status)) {
+            m_debugPlotLookup.remove(source);
+        }
+    }
+
     // don't consume cpu while closed
     if (!isVisible()) {
         return;
@@ -372,11 +381,20 @@ void Plotter::handleStatus(const Status &status, bool backlogStatus)
         parseMessage(cmd.output0(), QString(QStringLiteral("RadioCommand.%1.output0")).arg(name), time);
         parseMessage(cmd.output1(), QString(QStringLiteral("RadioCommand.%1.output1")).arg(name), time);
         parseMessage(cmd.output2(), QString(QStringLiteral("RadioCommand.%1.output2")).arg(name), time);
+        if (command.has_tracking_error()) {
+            parseMessage(command.tracking_error(), QString(QStringLiteral("RadioCommand.%1.trackingError")).arg(name), time);
+        }
     }
 
     if (status->has_timing()) {
         const amun::Timing &timing = status->timing();
         parseMessage(timing, QStringLiteral("Timing"), time);
+        for (const amun::ThreadJitter &jitter : timing.thread_jitter()) {
+            parseMessage(jitter, QString(QStringLiteral("Timing.jitter.%1")).arg(QString::fromStdString(jitter.thread())), time);
+        }
+        for (const robot::RadioLinkQuality &link : timing.radio_link()) {
+            parseMessage(link, QString(QStringLiteral("Timing.radioLink.%1-%2")).arg(link.generation()).arg(link.id()), time);
+        }
     }
 
     for (int j=0; j < status->debug_size(); ++j) {
@@ -411,7 +429,20 @@ void Plotter::handleStatus(const Status &status, bool backlogStatus)
             // strategies can add plots with arbitrary names
             for (int i = 0; i < debug.plot_size(); ++i) {
                 const amun::PlotValue &value = debug.plot(i);
-                addPoint(value.name(), parent, debugTime, value.value(), emptyLookup, 0);
+                if (!value.has_name_id()) {
+                    addPoint(value.name(), parent, debugTime, value.value(), emptyLookup, 0);
+                    continue;
+                }
+                const std::string &name = m_debugStrings.string(debug.source(), value.name_id());
+                if (name.empty()) {
+                    // the string table for this id is not known (yet)
+                    continue;
+                }
+                QVector<QStandardItem *> &lookup = m_debugPlotLookup[debug.source()];
+                if (lookup.size() <= int(value.name_id())) {
+                    lookup.resize(value.name_id() + 1);
+                }
+                addPoint(name, parent, debugTime, value.value(), lookup, value.name_id());
             }
         }
     }
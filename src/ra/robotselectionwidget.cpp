@@ -79,6 +79,7 @@ QWidget *ItemDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem
         connect(m_widget, SIGNAL(setTeam(uint,uint,RobotWidget::Team)), widget, SLOT(setTeam(uint,uint,RobotWidget::Team)));
         // the response includes generation and robot id, thus just broadcast it to everyone
         connect(m_widget, SIGNAL(sendRadioResponse(robot::RadioResponse)), widget, SLOT(handleResponse(robot::RadioResponse)));
+        connect(m_widget, SIGNAL(sendRadioLinkQuality(robot::RadioLinkQuality)), widget, SLOT(handleLinkQuality(robot::RadioLinkQuality)));
         connect(widget, SIGNAL(teamSelected(uint,uint,RobotWidget::Team)), m_widget, SLOT(selectTeam(uint,uint,RobotWidget::Team)));
         connect(m_widget, SIGNAL(setInputDevice(uint,uint,QString)), widget, SLOT(setInputDevice(uint,uint,QString)));
         connect(m_widget, SIGNAL(setRobotExchangeIcon(uint,uint,bool)), widget, SLOT(exchangeRobot(uint,uint,bool)));
@@ -480,6 +481,10 @@ void RobotSelectionWidget::handleStatus(const Status &status)
         }
     }
 
+    for (const robot::RadioLinkQuality &link : status->timing().radio_link()) {
+        emit sendRadioLinkQuality(link);
+    }
+
     for (const auto& debug : status->debug()) {
         for (int i = 0;i<debug.robot_size();i++) {
             const amun::RobotValue &value = debug.robot(i);
@@ -64,6 +64,7 @@ signals:
     void setInputDevice(uint generation, uint id, const QString &inputDevice);
     void sendCommand(const Command &command);
     void sendRadioResponse(const robot::RadioResponse &response);
+    void sendRadioLinkQuality(const robot::RadioLinkQuality &link);
     void generationChanged(uint generation, RobotWidget::Team team);
     void setRobotExchangeIcon(uint generation, uint id, bool exchange);
     void sendIsSimulator(bool simulator);
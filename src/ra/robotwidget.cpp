@@ -401,6 +401,20 @@ void RobotWidget::handleResponse(const robot::RadioResponse &response)
     m_guiUpdateTimer->requestTriggering();
 }
 
+void RobotWidget::handleLinkQuality(const robot::RadioLinkQuality &link)
+{
+    if (link.generation() != m_specs.generation() || link.id() != m_specs.id()) {
+        return;
+    }
+
+    m_linkQuality = link;
+    // only refresh the tooltip, the icons are driven by the robot responses
+    if (!m_isGeneration && m_lastResponse.has_packet_loss_rx() && m_lastResponse.has_packet_loss_tx()) {
+        updateRadioStatus(std::ceil(m_lastResponse.packet_loss_rx() * 100),
+                          std::ceil(m_lastResponse.packet_loss_tx() * 100));
+    }
+}
+
 void RobotWidget::updateBatteryStatus(int percentage)
 {
     const int percentageLow = 25;
@@ -476,7 +490,17 @@ void RobotWidget::updateRadioStatus(int packetLossRx, int packetLossTx)
 
     const QString rxStr = QString::number(packetLossRx);
     const QString txStr = QString::number(packetLossTx);
-    const QString toolTip = QString("Robot commands lost(RX): %1%, Replies lost(TX): %2%").arg(rxStr, txStr);
+    QString toolTip = QString("Robot commands lost(RX): %1%, Replies lost(TX): %2%").arg(rxStr, txStr);
+    if (m_linkQuality.IsInitialized() && m_linkQuality.has_response_rate()) {
+        toolTip += QString("\nResponses: %1%, sent: %2%").arg(qRound(m_linkQuality.response_rate() * 100))
+                .arg(qRound(m_linkQuality.delivery_rate() * 100));
+        if (m_linkQuality.has_latency_median()) {
+            toolTip += QString("\nLatency median: %1 ms, 95%: %2 ms, max: %3 ms")
+                    .arg(m_linkQuality.latency_median() * 1000, 0, 'f', 1)
+                    .arg(m_linkQuality.latency_p95() * 1000, 0, 'f', 1)
+                    .arg(m_linkQuality.latency_max() * 1000, 0, 'f', 1);
+        }
+    }
     m_rfBad->setToolTip(toolTip);
     m_rfOkay->setToolTip(toolTip);
     m_rfGood->setToolTip(toolTip);
@@ -581,6 +605,7 @@ void RobotWidget::hideRobotStatus()
 
     m_mergedResponse.Clear();
     m_lastResponse.Clear();
+    m_linkQuality.Clear();
 }
 
 void RobotWidget::generationChanged(uint generation, RobotWidget::Team team)
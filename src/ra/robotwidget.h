@@ -59,6 +59,7 @@ public slots:
     void setTeam(uint generation, uint id, RobotWidget::Team team);
     void setInputDevice(uint generation, uint id, const QString &inputDevice);
     void handleResponse(const robot::RadioResponse &response);
+    void handleLinkQuality(const robot::RadioLinkQuality &link);
     void generationChanged(uint generation, RobotWidget::Team team);
     void exchangeRobot(uint generation, uint id, bool exchange);
     void setIsSimulator(bool simulator);
@@ -99,6 +100,7 @@ private:
     robot::RadioResponse m_mergedResponse;
     GuiTimer *m_guiUpdateTimer;
     robot::RadioResponse m_lastResponse;
+    robot::RadioLinkQuality m_linkQuality;
     GuiTimer *m_guiResponseTimer;
     int m_statusCtr;
 
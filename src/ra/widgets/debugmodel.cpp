@@ -137,7 +137,7 @@ void DebugModel::setDebug(const amun::DebugValues &debug, const QSet<QString> &d
         }
 
         // strategy specific key
-        const QString keys = parentItem->text() % "/" % QString::fromStdString(value.key());
+        const QString keys = fullKey(parentItem, debug.source(), value);
         Entry *entry = m_entryMap.value(keys, NULL);
         // key not cached yet
         if (entry == NULL) {
@@ -179,6 +179,30 @@ void DebugModel::setDebug(const amun::DebugValues &debug, const QSet<QString> &d
     testMap(map, entries, false);
 }
 
+void DebugModel::updateStringTable(const amun::Status &status)
+{
+    for (amun::DebugSource source : m_debugStrings.update(status)) {
+        m_internedKeys.remove(source);
+    }
+}
+
+QString DebugModel::fullKey(QStandardItem *parentItem, amun::DebugSource source, const amun::DebugValue &value)
+{
+    if (!value.has_key_id()) {
+        return parentItem->text() % "/" % QString::fromStdString(value.key());
+    }
+    QString &key = m_internedKeys[source][value.key_id()];
+    if (key.isEmpty()) {
+        const std::string &name = m_debugStrings.string(source, value.key_id());
+        if (name.empty()) {
+            // the string table for this id is not known (yet)
+            return parentItem->text() % "/";
+        }
+        key = parentItem->text() % "/" % QString::fromStdString(name);
+    }
+    return key;
+}
+
 void DebugModel::testMap(DebugModel::Map &map, const QSet<Entry*> &entries, bool parentMatched)
 {
     QMutableHashIterator<QString, Entry*> it(map);
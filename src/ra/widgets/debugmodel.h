@@ -21,6 +21,7 @@
 #ifndef DEBUGMODEL_H
 #define DEBUGMODEL_H
 
+#include "protobuf/debugstringtable.h"
 #include "protobuf/status.pb.h"
 #include <QStandardItemModel>
 #include <QRegularExpression>
@@ -42,6 +43,7 @@ public:
     void clearData();
     void setDebugIfCurrent(const amun::DebugValues &debug, const QSet<QString> &debug_expanded);
     void setDebug(const amun::DebugValues &debug, const QSet<QString> &debug_expanded, bool content = true);
+    void updateStringTable(const amun::Status &status);
     void setFilterRegEx(const QString &filterKey, const QString &filterValue);
     bool hasItems() const;
 
@@ -50,12 +52,16 @@ private:
     class Entry;
     typedef QHash<QString, Entry*> Map;
     void testMap(Map &map, const QSet<Entry*> &entries, bool parentMatched);
+    QString fullKey(QStandardItem *parentItem, amun::DebugSource source, const amun::DebugValue &value);
 
 private:
     QHash<int, QStandardItem*> m_itemRoots;
     QHash<int, int> m_debugSourceCounter;
     Map m_entryMap;
     QHash<int, Map> m_debug;
+    DebugStringTable m_debugStrings;
+    // source -> key id -> full key
+    QHash<int, QHash<quint32, QString>> m_internedKeys;
     bool m_filterKey, m_filterValue;
     QRegularExpression m_filterKeyExpression;
     QRegularExpression m_filterValueExpression;
@@ -90,6 +90,9 @@ void DebugTreeWidget::setFilterRegEx(const QString &keyFilter, const QString &va
 
 void DebugTreeWidget::handleStatus(const Status &status)
 {
+    if (status->string_table_size() > 0) {
+        m_modelTree->updateStringTable(*status);
+    }
     for (const auto& debug : status->debug()) {
         // save data for delayed update
         m_status[debug.source()] = status;
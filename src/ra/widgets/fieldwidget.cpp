@@ -22,12 +22,15 @@
 #include "guihelper/guitimer.h"
 #include "protobuf/command.pb.h"
 #include "protobuf/geometry.h"
+#include "protobuf/imagevisualization.h"
+#include "protobuf/visionframes.h"
 #include "savesituation.h"
 #include <QContextMenuEvent>
 #include <QMenu>
 #include <cmath>
 #include <QGraphicsRectItem>
 #include <QOpenGLWidget>
+#include <QPainter>
 #include <QSettings>
 #include <QLabel>
 #include <QFileDialog>
@@ -498,6 +501,12 @@ void FieldWidget::handleStatus(const Status &status)
         m_guiTimer->requestTriggering();
     }
 
+    if (status->string_table_size() > 0) {
+        for (amun::DebugSource source : m_debugStrings.update(*status)) {
+            m_internedVisibility.remove(source);
+        }
+    }
+
     for (auto it = m_debugSourceCounter.begin(); it != m_debugSourceCounter.end(); it++) {
         // don't try to clear multiple times
         if (it.value() >= 0) {
@@ -510,6 +519,8 @@ void FieldWidget::handleStatus(const Status &status)
         }
     }
     for (const auto& debug: status->debug()) {
+        // delta coded images have to be decoded in order
+        decodeImages(debug);
         // just save status to avoid copying the visualizations
         m_drawScenes[m_currentScene].visualizations[debug.source()] = status;
         m_debugSourceCounter[debug.source()] = 0;
@@ -541,6 +552,7 @@ void FieldWidget::clearData()
     m_drawScenes[m_currentScene].lastWorldState.clear();
 
     m_drawScenes[m_currentScene].visualizations.clear();
+    m_drawScenes[m_currentScene].images.clear();
     m_visualizationsUpdated = true;
 
     geometrySetDefault(&m_drawScenes[m_currentScene].geometry);
@@ -572,6 +584,7 @@ void FieldWidget::visualizationsChanged(const QStringList &items)
 {
     // list of visible visualizations was changed
     m_visibleVisualizations = items;
+    m_internedVisibility.clear();
     m_visualizationsUpdated = true; // force redraw
     m_guiTimer->requestTriggering();
 }
@@ -656,6 +669,25 @@ void FieldWidget::updateVisualizations()
     }
 }
 
+bool FieldWidget::isVisualizationVisible(amun::DebugSource source, const amun::Visualization &vis)
+{
+    if (!vis.has_name_id()) {
+        return m_visibleVisualizations.contains(QString::fromStdString(vis.name()));
+    }
+    // avoid the string lookup for every visualization on every redraw
+    QHash<quint32, bool> &visibility = m_internedVisibility[source];
+    auto it = visibility.constFind(vis.name_id());
+    if (it != visibility.constEnd()) {
+        return it.value();
+    }
+    const std::string &name = m_debugStrings.string(source, vis.name_id());
+    const bool visible = m_visibleVisualizations.contains(QString::fromStdString(name));
+    if (!name.empty()) {
+        visibility.insert(vis.name_id(), visible);
+    }
+    return visible;
+}
+
 void FieldWidget::updateVisualizations(const amun::DebugValues &v, const bool grey)
 {
     // use introspection to iterate through the visualizations
@@ -663,7 +695,7 @@ void FieldWidget::updateVisualizations(const amun::DebugValues &v, const bool gr
     for (google::protobuf::RepeatedPtrField<amun::Visualization>::const_iterator it = viss.begin(); it != viss.end(); it++) {
         const amun::Visualization &vis = *it;
         // only draw visible visualizations
-        if (!m_visibleVisualizations.contains(QString::fromStdString(vis.name()))) {
+        if (!isVisualizationVisible(v.source(), vis)) {
             continue;
         }
 
@@ -739,18 +771,74 @@ void FieldWidget::updateVisualizations(const amun::DebugValues &v, const bool gr
         }
 
         if (vis.has_image()) {
-            m_visualizationItems << createFieldFunction(vis);
+            m_visualizationItems << createFieldFunction(vis, v.source());
         }
     }
 }
 
-QGraphicsItem* FieldWidget::createFieldFunction(const amun::Visualization &vis)
+void FieldWidget::decodeImages(const amun::DebugValues &debug)
+{
+    for (const amun::Visualization &vis : debug.visualization()) {
+        if (!vis.has_image() || !vis.image().has_id()) {
+            continue;
+        }
+        const amun::ImageVisualization &image = vis.image();
+        CachedImage &cached = m_drawScenes[m_currentScene].images[debug.source()][QString::fromStdString(m_debugStrings.name(debug.source(), vis))];
+        // hidden images are not decoded, they are shown again starting with the next full image
+        if (!m_visibleVisSources.value(debug.source()) || !isVisualizationVisible(debug.source(), vis)) {
+            cached.valid = false;
+            cached.pixmap = QPixmap();
+            continue;
+        }
+        if (cached.valid && cached.id == image.id()) {
+            continue;
+        }
+
+        QRect updated;
+        if (!decodeImageVisualization(image, cached.valid ? cached.id : 0, cached.pixels, updated)) {
+            cached.valid = false;
+            cached.pixmap = QPixmap();
+            continue;
+        }
+        const QRect imageRect(0, 0, image.width(), image.height());
+        if (updated != imageRect && !cached.pixmap.isNull()) {
+            // only update the changed region of the cached pixmap
+            const QImage pixels((const uchar*)cached.pixels.data(), image.width(), image.height(), image.width() * 4, QImage::Format_ARGB32);
+            QPainter painter(&cached.pixmap);
+            painter.setCompositionMode(QPainter::CompositionMode_Source);
+            painter.drawImage(updated.topLeft(), pixels, updated);
+        } else {
+            cached.pixmap = QPixmap();
+        }
+        cached.id = image.id();
+        cached.valid = true;
+    }
+}
+
+QGraphicsItem* FieldWidget::createFieldFunction(const amun::Visualization &vis, amun::DebugSource source)
 {
     QGraphicsPixmapItem *item = new QGraphicsPixmapItem;
 
-    if (vis.image().data().size() != vis.image().width() * vis.image().height() * 4) {
-        std::cerr <<"Error: image visualization data size does not match width * height"<<std::endl;
-        return item;
+    QPixmap pixmap;
+    if (vis.image().has_id()) {
+        CachedImage &cached = m_drawScenes[m_currentScene].images[source][QString::fromStdString(m_debugStrings.name(source, vis))];
+        if (!cached.valid || cached.id != vis.image().id()) {
+            return item;
+        }
+        if (cached.pixmap.isNull()) {
+            const QImage image((const uchar*)cached.pixels.data(), vis.image().width(), vis.image().height(),
+                               vis.image().width() * 4, QImage::Format_ARGB32);
+            cached.pixmap = QPixmap::fromImage(image);
+        }
+        pixmap = cached.pixmap;
+    } else {
+        if (vis.image().data().size() != vis.image().width() * vis.image().height() * 4) {
+            std::cerr <<"Error: image visualization data size does not match width * height"<<std::endl;
+            return item;
+        }
+        const uint8_t* data = (uint8_t*)(vis.image().data().data());
+        const QImage image(data, vis.image().width(), vis.image().height(), vis.image().width() * 4, QImage::Format_ARGB32);
+        pixmap = QPixmap::fromImage(image);
     }
 
     QRectF drawRect = m_fieldRect;
@@ -765,11 +853,7 @@ QGraphicsItem* FieldWidget::createFieldFunction(const amun::Visualization &vis)
     transform.scale(drawRect.width() / vis.image().width(), drawRect.height() / vis.image().height());
     item->setTransform(transform);
 
-    const uint8_t* data = (uint8_t*)(vis.image().data().data());
-    const QImage image(data, vis.image().width(), vis.image().height(), vis.image().width() * 4, QImage::Format_ARGB32);
-    const QPixmap p = QPixmap::fromImage(image);
-
-    item->setPixmap(p);
+    item->setPixmap(pixmap);
     item->setZValue(vis.background() ? 1.0f : 10.0f);
     m_scene->addItem(item);
     return item;
@@ -995,9 +1079,11 @@ void FieldWidget::updateDetection()
 
         if (m_showVision) {
             m_visionCurrentlyDisplayed = true;
-            for (int i = 0; i < worldState.vision_frames_size(); ++i) {
-                if (worldState.vision_frames(i).has_detection()) {
-                    const SSL_DetectionFrame &detection = worldState.vision_frames(i).detection();
+            // vision packets are only parsed while they are shown
+            SSL_WrapperPacket frame;
+            for (int i = 0; i < visionFrameCount(worldState); ++i) {
+                if (parseVisionFrame(worldState, i, frame) && frame.has_detection()) {
+                    const SSL_DetectionFrame &detection = frame.detection();
                     uint cameraID = detection.camera_id();
                     cameraIDs.insert(cameraID);
                     for (int j = 0; j < detection.balls_size(); ++j) {
@@ -2378,6 +2464,7 @@ void FieldWidget::setShowVision(bool enable)
 void FieldWidget::setShowTruth(bool enable)
 {
     m_showTruth = enable;
+    emit showTruthChanged(enable);
     m_worldState.append(m_drawScenes[m_currentScene].lastWorldState[m_trackingFrom]);
     updateDetection();
 }
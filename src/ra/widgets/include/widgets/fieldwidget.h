@@ -23,9 +23,11 @@
 
 #include "core/fieldtransform.h"
 #include "protobuf/command.h"
+#include "protobuf/debugstringtable.h"
 #include "protobuf/status.h"
 #include "protobuf/ssl_referee.h"
 #include <QGraphicsView>
+#include <QPixmap>
 #include <QMap>
 #include <QHash>
 #include <QQueue>
@@ -63,6 +65,16 @@ private:
     };
 
     typedef QMultiMap<qint64, QGraphicsEllipseItem *> TraceMap;
+    struct CachedImage
+    {
+        quint32 id = 0;
+        bool valid = false;
+        // blue, green, red and alpha bytes
+        std::string pixels;
+        // created on demand
+        QPixmap pixmap;
+    };
+
     struct Trace
     {
         TraceMap traces;
@@ -93,6 +105,8 @@ private:
         world::Geometry geometry;
         // save status to avoid copying the debug values
         QMap<amun::DebugSource, Status> visualizations;
+        // source -> visualization name -> last decoded image
+        QHash<int, QHash<QString, CachedImage>> images;
     };
 
 public:
@@ -110,6 +124,7 @@ signals:
     void robotCtrlClicked(bool teamIsBlue, int robotId);
     void selectRobots(const QList<int> &yellow, const QList<int> &blue);
     void sendPlaceBall(bool blue, float x, float y);
+    void showTruthChanged(bool enable);
 
 public slots:
     void handleStatus(const Status &status);
@@ -175,6 +190,8 @@ private:
     void updateInfoText();
     void updateVisualizations();
     void updateVisualizations(const amun::DebugValues &v, const bool grey = false);
+    bool isVisualizationVisible(amun::DebugSource source, const amun::Visualization &vis);
+    void decodeImages(const amun::DebugValues &debug);
     void clearTeamData(RobotMap &team);
     void updateTeam(RobotMap &team, QHash<uint, robot::Specs> &specsMap, const robot::Team &specs);
     void setBall(const world::Ball &ball);
@@ -193,7 +210,7 @@ private:
     void drawLines(QPainter *painter, QRectF rect, bool cosmetic);
     void drawGoal(QPainter *painter, float side, bool cosmetic);
     QGraphicsItem* createCircle(const QPen &pen, const QBrush &brush, const amun::Visualization &vis);
-    QGraphicsItem* createFieldFunction(const amun::Visualization &vis);
+    QGraphicsItem* createFieldFunction(const amun::Visualization &vis, amun::DebugSource source);
     QGraphicsItem* createPolygon(const QPen &pen, const QBrush &brush, const amun::Visualization &vis);
     QGraphicsItem* createPath(const QPen &pen, const QBrush &brush, const amun::Visualization &vis);
     void switchScene(int scene);
@@ -258,6 +275,9 @@ private:
     QGraphicsEllipseItem *m_flyingBall;
     QGraphicsEllipseItem *m_realBall = nullptr;
     QStringList m_visibleVisualizations;
+    DebugStringTable m_debugStrings;
+    // source -> name id -> visible
+    QHash<int, QHash<quint32, bool>> m_internedVisibility;
     typedef QList<QGraphicsItem*> Items;
     Items m_visualizationItems;
     RobotMap m_robotsBlue;
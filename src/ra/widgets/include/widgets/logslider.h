@@ -76,6 +76,8 @@ private:
     QString formatTime(qint64 time);
     void resetVariables();
     void initializeLabels(int64_t packetCount = 0, bool enable = false);
+    // the log has grown while being followed
+    void extendLabels(int64_t packetCount);
     void connectStatusSource();
 
 private:
@@ -22,6 +22,7 @@
 #define TIMINGWIDGET_H
 
 #include "protobuf/status.h"
+#include <QHash>
 #include <QStandardItemModel>
 #include <QWidget>
 
@@ -46,17 +47,25 @@ public slots:
 private slots:
     void updateModel();
 
+private:
+    int addRow(const QString &name);
+    int dynamicRow(const QString &name);
+
 private:
     struct Value
     {
-        Value() : time(0.0f), iterations(0) {}
+        Value() : time(0.0f), iterations(0), isTime(true) {}
         float time;
         int iterations;
+        bool isTime;
     };
 
     Ui::TimingWidget *ui;
     QStandardItemModel *m_model;
     QMap<int, Value> m_values;
+    // row of each field of amun::Timing, -1 for repeated fields
+    QList<int> m_fieldRows;
+    QHash<QString, int> m_dynamicRows;
 };
 
 #endif // TIMINGWIDGET_H
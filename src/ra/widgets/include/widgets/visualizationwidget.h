@@ -21,6 +21,7 @@
 #ifndef VISUALIZATIONWIDGET_H
 #define VISUALIZATIONWIDGET_H
 
+#include "protobuf/debugstringtable.h"
 #include "protobuf/status.h"
 #include <QHash>
 #include <QSet>
@@ -77,6 +78,7 @@ private:
     VisualizationProxyModel *m_proxy;
     QSet<QString> m_selection;
     HashMap m_items;
+    DebugStringTable m_debugStrings;
     qint64 m_time;
     QMenu *m_contextMenu;
     GuiTimer *m_guiTimer;
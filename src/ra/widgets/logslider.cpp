@@ -154,7 +154,10 @@ void LogSlider::handleStatus(const Status& status)
             setPaused(response.playback_paused());
             return;
         }
-        if (response.has_log_info()) {
+        if (response.has_log_info() && response.log_info().appended()) {
+            m_duration = response.log_info().duration();
+            extendLabels(response.log_info().packet_count());
+        } else if (response.has_log_info()) {
             m_startTime = response.log_info().start_time();
             m_duration = response.log_info().duration();
             initializeLabels(response.log_info().packet_count(), true);
@@ -292,6 +295,22 @@ void LogSlider::initializeLabels(int64_t packetCount, bool enable)
     m_scroll = true;
 }
 
+void LogSlider::extendLabels(int64_t packetCount)
+{
+    m_scroll = false;
+    // a limit at the end of the log moves along
+    const bool limitAtEnd = ui->spinLimit->value() == ui->spinLimit->maximum();
+    ui->spinPacketCurrent->setMaximum(packetCount - 1);
+    ui->spinLimit->setMaximum(packetCount - 1);
+    if (limitAtEnd) {
+        ui->spinLimit->setValue(packetCount - 1);
+    }
+    ui->lblPacketMax->setText(QString::number(packetCount - 1));
+    ui->lblTimeMax->setText(formatTime(m_duration));
+    ui->horizontalSlider->setMaximum(m_duration / 1E8);
+    m_scroll = true;
+}
+
 uint LogSlider::getFrame()
 {
     return ui->spinPacketCurrent->value();
@@ -70,6 +70,7 @@ void saveSituationTypescript(TrackingFrom useTrackingFrom, world::State worldSta
     // get rid of some unwanted fields that will only pollute the file and are not necessary for the strategy
     // this is the same as in js_amun getWorldState
     worldState.clear_vision_frames();
+    worldState.clear_raw_vision_frames();
     worldState.clear_simple_tracking_blue();
     worldState.clear_simple_tracking_yellow();
     worldState.clear_radio_response();
@@ -35,17 +35,15 @@ TimingWidget::TimingWidget(QWidget *parent) :
     ui->treeView->setUniformRowHeights(true); // speedup
     ui->treeView->setModel(m_model);
 
-    // create entries by introspection
+    // create entries by introspection, repeated fields get their own rows once they are received
     const google::protobuf::Descriptor *desc = amun::Timing::descriptor();
     for (int i = 0; i < desc->field_count(); i++) {
         const google::protobuf::FieldDescriptor *field = desc->field(i);
-        QStandardItem *key = new QStandardItem(QString::fromStdString(field->name()));
-        QStandardItem *time = new QStandardItem;
-        time->setTextAlignment(Qt::AlignRight);
-        QStandardItem *frequency = new QStandardItem;
-        frequency->setTextAlignment(Qt::AlignRight);
-        // add row
-        m_model->appendRow(QList<QStandardItem*>() << key << time << frequency);
+        if (field->is_repeated() || field->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+            m_fieldRows.append(-1);
+            continue;
+        }
+        m_fieldRows.append(addRow(QString::fromStdString(field->name())));
     }
 
     QTimer *timer = new QTimer(this); // update view once every second
@@ -73,6 +71,29 @@ void TimingWidget::saveConfig()
     s.endGroup();
 }
 
+int TimingWidget::addRow(const QString &name)
+{
+    QStandardItem *key = new QStandardItem(name);
+    QStandardItem *time = new QStandardItem;
+    time->setTextAlignment(Qt::AlignRight);
+    QStandardItem *frequency = new QStandardItem;
+    frequency->setTextAlignment(Qt::AlignRight);
+    // add row
+    m_model->appendRow(QList<QStandardItem*>() << key << time << frequency);
+    return m_model->rowCount() - 1;
+}
+
+int TimingWidget::dynamicRow(const QString &name)
+{
+    auto it = m_dynamicRows.constFind(name);
+    if (it != m_dynamicRows.constEnd()) {
+        return *it;
+    }
+    const int row = addRow(name);
+    m_dynamicRows.insert(name, row);
+    return row;
+}
+
 void TimingWidget::handleStatus(const Status &status)
 {
     if (status->has_timing()) {
@@ -82,10 +103,54 @@ void TimingWidget::handleStatus(const Status &status)
         // extract fields using reflection
         for (int i = 0; i < desc->field_count(); i++) {
             const google::protobuf::FieldDescriptor *field = desc->field(i);
-            if (refl->HasField(t, field)) {
-                Value &value = m_values[i];
-                value.iterations++;
+            // HasField must not be used on repeated fields
+            if (m_fieldRows.value(i, -1) < 0 || !refl->HasField(t, field)) {
+                continue;
+            }
+            Value &value = m_values[m_fieldRows[i]];
+            value.iterations++;
+            switch (field->cpp_type()) {
+            case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
                 value.time = qMax(value.time, refl->GetFloat(t, field));
+                break;
+            case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
+                value.time = qMax(value.time, float(refl->GetDouble(t, field)));
+                break;
+            // counters are shown as they are
+            case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+                value.isTime = false;
+                value.time = qMax(value.time, float(refl->GetUInt32(t, field)));
+                break;
+            case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+                value.isTime = false;
+                value.time = qMax(value.time, float(refl->GetInt32(t, field)));
+                break;
+            default:
+                break;
+            }
+        }
+
+        for (const amun::ThreadJitter &jitter : t.thread_jitter()) {
+            const int row = dynamicRow("jitter " + QString::fromStdString(jitter.thread()));
+            if (jitter.has_max()) {
+                Value &value = m_values[row];
+                value.iterations++;
+                value.time = qMax(value.time, jitter.max());
+            }
+            if (jitter.has_placement_error()) {
+                // the thread runs without its configured placement
+                QStandardItem *key = m_model->item(row, 0);
+                key->setForeground(Qt::red);
+                key->setToolTip(QString::fromStdString(jitter.placement_error()));
+            }
+        }
+
+        for (const robot::RadioLinkQuality &link : t.radio_link()) {
+            if (link.has_latency_p95()) {
+                const QString name = QString("radio link %1-%2 p95").arg(link.generation()).arg(link.id());
+                Value &value = m_values[dynamicRow(name)];
+                value.iterations++;
+                value.time = qMax(value.time, link.latency_p95());
             }
         }
     }
@@ -97,7 +162,11 @@ void TimingWidget::updateModel()
         const Value value = m_values.take(i); // remove value
         QString text;
 
-        text = QString::number(value.time * 1E3, 'f', 3); // time in ms
+        if (value.isTime) {
+            text = QString::number(value.time * 1E3, 'f', 3); // time in ms
+        } else {
+            text = QString::number(value.time, 'f', 0);
+        }
         m_model->item(i, 1)->setText(text);
 
         text = QString::number(value.iterations);
@@ -134,14 +134,19 @@ void VisualizationWidget::addItem(const std::string &stdName, bool checked)
 
 void VisualizationWidget::handleStatus(const Status &status)
 {
+    if (status->string_table_size() > 0) {
+        m_debugStrings.update(*status);
+    }
     for (const auto& values : status->debug()) {
         m_time = status->time();
 
         for (int i = 0; i < values.visualization_size(); i++) {
             const amun::Visualization &vis = values.visualization(i);
             // avoid conversion to QString if not really neccessary
-            const std::string &stdName = vis.name();
-            addItem(stdName, false);
+            const std::string &stdName = m_debugStrings.name(values.source(), vis);
+            if (!stdName.empty()) {
+                addItem(stdName, false);
+            }
         }
         m_guiTimer->requestTriggering();
     }
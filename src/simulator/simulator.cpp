@@ -673,9 +673,11 @@ int main(int argc, char* argv[])
     QCommandLineOption geometryConfig({"g", "geometry"}, "The geometry file to load as default", "file", "2020");
     QCommandLineOption realismConfig("realism", "Simulator realism configuration (short file name without the .txt)", "realism", "Realistic");
     QCommandLineOption localhostConfig("localhost", "Use localhost as the output address for the simulator");
+    QCommandLineOption kinematicConfig("kinematic", "Use the kinematic backend instead of the bullet physics simulation");
     parser.addOption(geometryConfig);
     parser.addOption(realismConfig);
     parser.addOption(localhostConfig);
+    parser.addOption(kinematicConfig);
 
     parser.process(app);
 
@@ -735,6 +737,9 @@ int main(int argc, char* argv[])
     if (!loadConfiguration("simulator/" + parser.value(geometryConfig), c->mutable_simulator()->mutable_simulator_setup(), false)) {
         exit(EXIT_FAILURE);
     }
+    if (parser.isSet(kinematicConfig)) {
+        c->mutable_simulator()->mutable_simulator_setup()->set_backend(amun::SimulatorSetup::Kinematic);
+    }
     if (!loadConfiguration("simulator-realism/" + parser.value(realismConfig), c->mutable_simulator()->mutable_realism_config(), true)) {
         exit(EXIT_FAILURE);
     }
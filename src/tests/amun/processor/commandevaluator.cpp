@@ -0,0 +1,107 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "processor/commandevaluator.h"
+#include "protobuf/debug.pb.h"
+#include "protobuf/debugsubscription.h"
+#include "protobuf/world.pb.h"
+
+static const qint64 START_TIME = 1000 * 1000 * 1000;
+// one control step
+static const qint64 STEP = 10 * 1000 * 1000;
+
+static robot::Specs testSpecs()
+{
+    robot::Specs specs;
+    specs.set_generation(4);
+    specs.set_year(2020);
+    specs.set_id(0);
+    robot::LimitParameters *limits = specs.mutable_acceleration();
+    limits->set_a_speedup_f_max(3);
+    limits->set_a_speedup_s_max(3);
+    limits->set_a_speedup_phi_max(30);
+    limits->set_a_brake_f_max(3);
+    limits->set_a_brake_s_max(3);
+    limits->set_a_brake_phi_max(30);
+    return specs;
+}
+
+static void setPolynomial(robot::Polynomial *p, float a0, float a1)
+{
+    p->set_a0(a0);
+    p->set_a1(a1);
+    p->set_a2(0);
+    p->set_a3(0);
+}
+
+TEST(CommandEvaluator, TrackingError) {
+    CommandEvaluator evaluator(testSpecs());
+
+    // drive with 1 m/s along the x axis at a constant orientation
+    robot::ControllerInput input;
+    robot::Spline *spline = input.add_spline();
+    spline->set_t_start(0);
+    spline->set_t_end(10);
+    setPolynomial(spline->mutable_x(), 0, 1);
+    setPolynomial(spline->mutable_y(), 0, 0);
+    setPolynomial(spline->mutable_phi(), 0.2f, 0);
+    evaluator.setInput(input, START_TIME);
+
+    robot::TrackingError error;
+    // starts the reporting interval
+    ASSERT_FALSE(evaluator.takeTrackingError(START_TIME, error));
+
+    DebugSubscription subscription;
+    const int SAMPLES = 100;
+    for (int i = 0; i < SAMPLES; i++) {
+        const qint64 time = START_TIME + i * STEP;
+        // the robot is offset to the side and rotated, but follows the spline speed
+        // except for a quarter of the time in which it stands still
+        const bool standing = i >= 50 && i < 75;
+        world::Robot robot;
+        robot.set_id(0);
+        robot.set_p_x(i * CONTROL_STEP);
+        robot.set_p_y(0.1f);
+        robot.set_phi(0.25f);
+        robot.set_v_x(standing ? 0 : 1);
+        robot.set_v_y(0);
+        robot.set_omega(0);
+
+        robot::Command command;
+        amun::DebugValues debug;
+        evaluator.calculateCommand(&robot, time, command, &debug, subscription);
+        if (i < SAMPLES - 1) {
+            ASSERT_FALSE(evaluator.takeTrackingError(time, error));
+        }
+    }
+
+    ASSERT_TRUE(evaluator.takeTrackingError(START_TIME + 1000 * 1000 * 1000, error));
+    ASSERT_EQ(error.samples(), (uint)SAMPLES);
+    ASSERT_NEAR(error.position_rms(), 0.1f, 1e-4f);
+    ASSERT_NEAR(error.position_max(), 0.1f, 1e-4f);
+    ASSERT_NEAR(error.phi_rms(), 0.05f, 1e-4f);
+    // the speed error is 1 m/s for a quarter of the samples
+    ASSERT_NEAR(error.velocity_rms(), 0.5f, 1e-4f);
+    // reaching the spline speed from standstill within one step exceeds the limits
+    ASSERT_NEAR(error.acceleration_limited(), 0.25f, 1e-4f);
+
+    // the statistics are reset after reporting
+    ASSERT_FALSE(evaluator.takeTrackingError(START_TIME + 2000 * 1000 * 1000LL, error));
+}
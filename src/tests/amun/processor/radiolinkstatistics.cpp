@@ -0,0 +1,140 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "processor/radiolinkstatistics.h"
+
+using Radio::Generation;
+
+static const qint64 MS = 1000 * 1000;
+
+static QList<robot::RadioLinkQuality> evaluate(const RadioLinkStatistics &statistics, qint64 time)
+{
+    QList<robot::RadioLinkQuality> links;
+    statistics.evaluate(time, links);
+    return links;
+}
+
+TEST(RadioLinkStatistics, LatencyPercentiles) {
+    RadioLinkStatistics statistics;
+    // latencies of 1 to 20ms in shuffled order
+    for (int i = 0; i < 20; i++) {
+        const qint64 time = i * 10 * MS;
+        statistics.commandSent(Generation::Gen2018, 4, i, time);
+        statistics.responseReceived(Generation::Gen2018, 4, i, time + ((i * 7) % 20 + 1) * MS);
+    }
+
+    const QList<robot::RadioLinkQuality> links = evaluate(statistics, 300 * MS);
+    ASSERT_EQ(links.size(), 1);
+    const robot::RadioLinkQuality &link = links[0];
+    ASSERT_EQ(link.generation(), (uint)Generation::Gen2018);
+    ASSERT_EQ(link.id(), 4u);
+    ASSERT_EQ(link.commands(), 20u);
+    ASSERT_EQ(link.sent(), 20u);
+    ASSERT_EQ(link.responses(), 20u);
+    ASSERT_FLOAT_EQ(link.delivery_rate(), 1);
+    ASSERT_FLOAT_EQ(link.response_rate(), 1);
+    ASSERT_NEAR(link.latency_mean(), 0.0105f, 1e-6f);
+    ASSERT_NEAR(link.latency_median(), 0.011f, 1e-6f);
+    ASSERT_NEAR(link.latency_p95(), 0.020f, 1e-6f);
+    ASSERT_NEAR(link.latency_max(), 0.020f, 1e-6f);
+}
+
+TEST(RadioLinkStatistics, WrappingCounters) {
+    RadioLinkStatistics statistics;
+    const int count = 300;
+    for (int i = 0; i < count; i++) {
+        const qint64 time = i * 5 * MS;
+        statistics.commandSent(Generation::Gen2014, 0, quint8(i), time);
+        // every response is delayed by two commands
+        if (i >= 2) {
+            statistics.responseReceived(Generation::Gen2014, 0, quint8(i - 2), time);
+        }
+    }
+    const qint64 end = count * 5 * MS;
+    statistics.responseReceived(Generation::Gen2014, 0, quint8(count - 2), end);
+    statistics.responseReceived(Generation::Gen2014, 0, quint8(count - 1), end + 5 * MS);
+
+    // responses for commands which were evicted from the window are ignored
+    statistics.responseReceived(Generation::Gen2014, 0, quint8(count - RadioLinkStatistics::WINDOW_SIZE - 1), end);
+
+    const QList<robot::RadioLinkQuality> links = evaluate(statistics, end + RadioLinkStatistics::RESPONSE_TIMEOUT);
+    ASSERT_EQ(links.size(), 1);
+    const robot::RadioLinkQuality &link = links[0];
+    ASSERT_EQ(link.commands(), (uint)RadioLinkStatistics::WINDOW_SIZE);
+    ASSERT_EQ(link.responses(), (uint)RadioLinkStatistics::WINDOW_SIZE);
+    ASSERT_NEAR(link.latency_median(), 0.010f, 1e-6f);
+    ASSERT_NEAR(link.latency_max(), 0.010f, 1e-6f);
+}
+
+TEST(RadioLinkStatistics, DroppedCommands) {
+    RadioLinkStatistics statistics;
+    for (int i = 0; i < 10; i++) {
+        const qint64 time = i * 10 * MS;
+        if (i % 5 == 0) {
+            statistics.commandDropped(Generation::Gen2018, 1, time);
+            continue;
+        }
+        statistics.commandSent(Generation::Gen2018, 1, i, time);
+        statistics.responseReceived(Generation::Gen2018, 1, i, time + 2 * MS);
+    }
+    // responses for dropped commands can not be matched
+    statistics.responseReceived(Generation::Gen2018, 1, 0, 3 * MS);
+
+    const QList<robot::RadioLinkQuality> links = evaluate(statistics, 200 * MS);
+    ASSERT_EQ(links.size(), 1);
+    ASSERT_EQ(links[0].commands(), 10u);
+    ASSERT_EQ(links[0].sent(), 8u);
+    ASSERT_EQ(links[0].responses(), 8u);
+    ASSERT_FLOAT_EQ(links[0].delivery_rate(), 0.8f);
+    ASSERT_FLOAT_EQ(links[0].response_rate(), 1);
+}
+
+TEST(RadioLinkStatistics, LateAndUnansweredCommands) {
+    RadioLinkStatistics statistics;
+    statistics.commandSent(Generation::Gen2014, 2, 0, 0);
+    statistics.responseReceived(Generation::Gen2014, 2, 0, 5 * MS);
+    // answered after the response timeout
+    statistics.commandSent(Generation::Gen2014, 2, 1, 10 * MS);
+    statistics.responseReceived(Generation::Gen2014, 2, 1, 10 * MS + RadioLinkStatistics::RESPONSE_TIMEOUT + MS);
+    // never answered
+    statistics.commandSent(Generation::Gen2014, 2, 2, 20 * MS);
+    // may still be answered
+    const qint64 recent = 300 * MS;
+    statistics.commandSent(Generation::Gen2014, 2, 3, recent);
+
+    const QList<robot::RadioLinkQuality> links = evaluate(statistics, recent + RadioLinkStatistics::RESPONSE_TIMEOUT / 2);
+    ASSERT_EQ(links.size(), 1);
+    const robot::RadioLinkQuality &link = links[0];
+    ASSERT_EQ(link.commands(), 3u);
+    ASSERT_EQ(link.sent(), 3u);
+    ASSERT_EQ(link.responses(), 1u);
+    ASSERT_FLOAT_EQ(link.response_rate(), 1 / 3.f);
+    ASSERT_NEAR(link.latency_max(), 0.005f, 1e-6f);
+
+    // an answered recent command is evaluated right away
+    statistics.responseReceived(Generation::Gen2014, 2, 3, recent + 4 * MS);
+    const QList<robot::RadioLinkQuality> answered = evaluate(statistics, recent + RadioLinkStatistics::RESPONSE_TIMEOUT / 2);
+    ASSERT_EQ(answered.size(), 1);
+    ASSERT_EQ(answered[0].commands(), 4u);
+    ASSERT_EQ(answered[0].responses(), 2u);
+
+    // commands older than the window age are forgotten
+    ASSERT_TRUE(evaluate(statistics, recent + RadioLinkStatistics::MAX_AGE + MS).isEmpty());
+}
@@ -0,0 +1,203 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "processor/radiotelemetry.h"
+
+using Radio::Generation;
+
+static const qint64 MS = 1000 * 1000;
+
+static RadioTelemetry::Sample powered(qint64 time, float vF, quint8 flags = 0)
+{
+    RadioTelemetry::Sample s;
+    s.time = time;
+    s.vF = vF;
+    s.flags = RadioTelemetry::PowerEnabled | flags;
+    return s;
+}
+
+static RadioTelemetry::Sample basicStatus(qint64 time, float battery)
+{
+    RadioTelemetry::Sample s = powered(time, 0, RadioTelemetry::HasBasicStatus);
+    s.battery = battery;
+    s.packetLossRx = 0.25f;
+    s.packetLossTx = 0.5f;
+    return s;
+}
+
+static RadioTelemetry::Sample extendedError(qint64 time, quint16 errors)
+{
+    RadioTelemetry::Sample s = powered(time, 0, RadioTelemetry::HasExtendedError | RadioTelemetry::ErrorPresent);
+    s.errors = errors;
+    s.temperature = 42;
+    return s;
+}
+
+TEST(RadioTelemetry, AppendFillsColumns) {
+    RadioTelemetry telemetry;
+    ASSERT_EQ(telemetry.columns(Generation::Gen2018, 3), nullptr);
+    ASSERT_FALSE(telemetry.append(Generation::Gen2018, RadioTelemetry::ROBOTS_PER_GENERATION, powered(0, 1)));
+
+    ASSERT_TRUE(telemetry.append(Generation::Gen2018, 3, basicStatus(10 * MS, 7.5f)));
+    ASSERT_TRUE(telemetry.append(Generation::Gen2018, 3, powered(20 * MS, 1.5f)));
+    // generations are stored separately
+    ASSERT_EQ(telemetry.columns(Generation::Gen2014, 3), nullptr);
+
+    const RadioTelemetry::Columns *c = telemetry.columns(Generation::Gen2018, 3);
+    ASSERT_NE(c, nullptr);
+    ASSERT_EQ(c->size, 2);
+    ASSERT_EQ(c->sample(0).time, 20 * MS);
+    ASSERT_FLOAT_EQ(c->sample(0).vF, 1.5f);
+    ASSERT_EQ(c->sample(1).time, 10 * MS);
+    ASSERT_FLOAT_EQ(c->sample(1).battery, 7.5f);
+    ASSERT_EQ(c->sample(1).flags, RadioTelemetry::PowerEnabled | RadioTelemetry::HasBasicStatus);
+}
+
+TEST(RadioTelemetry, HistoryWrapsAround) {
+    RadioTelemetry telemetry;
+    const int count = RadioTelemetry::HISTORY_SIZE + 5;
+    for (int i = 0; i < count; i++) {
+        telemetry.append(Generation::Gen2014, 0, powered(i * MS, i));
+    }
+    const RadioTelemetry::Columns *c = telemetry.columns(Generation::Gen2014, 0);
+    ASSERT_NE(c, nullptr);
+    ASSERT_EQ(c->size, RadioTelemetry::HISTORY_SIZE);
+    ASSERT_EQ(c->sample(0).time, (count - 1) * MS);
+    ASSERT_EQ(c->sample(RadioTelemetry::HISTORY_SIZE - 1).time, 5 * MS);
+
+    // only the samples which are still stored are forwarded
+    QList<robot::RadioResponse> responses;
+    telemetry.takeResponses(count * MS, responses);
+    ASSERT_EQ(responses.size(), RadioTelemetry::HISTORY_SIZE);
+    ASSERT_EQ(responses.first().time(), 5 * MS);
+    ASSERT_EQ(responses.last().time(), (count - 1) * MS);
+
+    telemetry.clear();
+    ASSERT_EQ(telemetry.columns(Generation::Gen2014, 0), nullptr);
+}
+
+TEST(RadioTelemetry, ForwardsEveryResponseWithoutInterval) {
+    RadioTelemetry telemetry;
+    telemetry.append(Generation::Gen2014, 1, powered(1 * MS, 0.5f, RadioTelemetry::BallDetected));
+    telemetry.append(Generation::Gen2014, 1, basicStatus(2 * MS, 8));
+    telemetry.append(Generation::Gen2018, 2, extendedError(3 * MS, RadioTelemetry::KickerError));
+
+    QList<robot::RadioResponse> responses;
+    telemetry.takeResponses(4 * MS, responses);
+    ASSERT_EQ(responses.size(), 3);
+
+    const robot::RadioResponse &first = responses[0];
+    ASSERT_EQ(first.generation(), (uint)Generation::Gen2014);
+    ASSERT_EQ(first.id(), 1u);
+    ASSERT_EQ(first.time(), 1 * MS);
+    ASSERT_FLOAT_EQ(first.estimated_speed().v_f(), 0.5f);
+    ASSERT_TRUE(first.ball_detected());
+    ASSERT_FALSE(first.has_battery());
+
+    const robot::RadioResponse &second = responses[1];
+    ASSERT_EQ(second.time(), 2 * MS);
+    ASSERT_FLOAT_EQ(second.battery(), 8);
+    ASSERT_FLOAT_EQ(second.packet_loss_tx(), 0.5f);
+    ASSERT_FALSE(second.ball_detected());
+
+    const robot::RadioResponse &third = responses[2];
+    ASSERT_EQ(third.generation(), (uint)Generation::Gen2018);
+    ASSERT_EQ(third.id(), 2u);
+    ASSERT_TRUE(third.error_present());
+    ASSERT_TRUE(third.extended_error().kicker_error());
+    ASSERT_FALSE(third.extended_error().motor_1_error());
+    ASSERT_EQ(third.extended_error().temperature(), 42);
+
+    // forwarded samples are not sent again
+    responses.clear();
+    telemetry.takeResponses(5 * MS, responses);
+    ASSERT_TRUE(responses.isEmpty());
+}
+
+TEST(RadioTelemetry, IntervalMergesPendingSamples) {
+    RadioTelemetry telemetry;
+    telemetry.setResponseInterval(100 * MS);
+
+    // the first response of a robot is always forwarded
+    QList<robot::RadioResponse> responses;
+    telemetry.append(Generation::Gen2018, 0, powered(0, 1));
+    telemetry.takeResponses(0, responses);
+    ASSERT_EQ(responses.size(), 1);
+
+    responses.clear();
+    telemetry.append(Generation::Gen2018, 0, basicStatus(10 * MS, 7));
+    telemetry.append(Generation::Gen2018, 0, powered(20 * MS, 2));
+    telemetry.takeResponses(50 * MS, responses);
+    ASSERT_TRUE(responses.isEmpty());
+
+    telemetry.append(Generation::Gen2018, 0, powered(90 * MS, 3));
+    telemetry.takeResponses(100 * MS, responses);
+    ASSERT_EQ(responses.size(), 1);
+    // the state is from the latest sample, the battery from the older pending sample
+    const robot::RadioResponse &merged = responses[0];
+    ASSERT_EQ(merged.time(), 90 * MS);
+    ASSERT_FLOAT_EQ(merged.estimated_speed().v_f(), 3);
+    ASSERT_FLOAT_EQ(merged.battery(), 7);
+    ASSERT_FLOAT_EQ(merged.packet_loss_rx(), 0.25f);
+    ASSERT_FALSE(merged.has_extended_error());
+    ASSERT_FALSE(merged.has_radio_rtt());
+
+    // the battery was already forwarded and is not merged again
+    responses.clear();
+    telemetry.append(Generation::Gen2018, 0, powered(150 * MS, 4));
+    telemetry.takeResponses(200 * MS, responses);
+    ASSERT_EQ(responses.size(), 1);
+    ASSERT_FALSE(responses[0].has_battery());
+}
+
+TEST(RadioTelemetry, ChangesAreForwardedImmediately) {
+    RadioTelemetry telemetry;
+    telemetry.setResponseInterval(100 * MS);
+
+    QList<robot::RadioResponse> responses;
+    telemetry.append(Generation::Gen2014, 5, powered(0, 1));
+    telemetry.takeResponses(0, responses);
+    ASSERT_EQ(responses.size(), 1);
+
+    // a state flag change skips the interval
+    responses.clear();
+    telemetry.append(Generation::Gen2014, 5, powered(10 * MS, 1, RadioTelemetry::BallDetected));
+    telemetry.takeResponses(10 * MS, responses);
+    ASSERT_EQ(responses.size(), 1);
+    ASSERT_TRUE(responses[0].ball_detected());
+
+    // as does a new error
+    responses.clear();
+    telemetry.append(Generation::Gen2014, 5, extendedError(20 * MS, RadioTelemetry::Motor2Error));
+    telemetry.takeResponses(20 * MS, responses);
+    ASSERT_EQ(responses.size(), 1);
+    ASSERT_TRUE(responses[0].extended_error().motor_2_error());
+
+    // repeating the same error is not a change
+    responses.clear();
+    telemetry.append(Generation::Gen2014, 5, extendedError(30 * MS, RadioTelemetry::Motor2Error));
+    telemetry.takeResponses(30 * MS, responses);
+    ASSERT_TRUE(responses.isEmpty());
+
+    telemetry.append(Generation::Gen2014, 5, extendedError(40 * MS, RadioTelemetry::Motor2Error | RadioTelemetry::DribblerError));
+    telemetry.takeResponses(40 * MS, responses);
+    ASSERT_EQ(responses.size(), 1);
+    ASSERT_TRUE(responses[0].extended_error().dribbler_error());
+}
@@ -78,7 +78,7 @@ private:
     std::map<std::pair<bool, int>, SSLSimRobotControl> m_robotCommands;
     Tracker m_tracker;
     qint64 m_lastTrackingTime = 0;
-    QList<QByteArray> m_simulatorTruth;
+    QList<SimulatorTruth> m_simulatorTruth;
     std::vector<TestFunction> m_testFunctions;
     std::optional<Vector> m_lastTrueBallPos;
     std::optional<Vector> m_lastTrueBallSpeed;
@@ -148,8 +148,8 @@ SimulationController::SimulationController(int predictTimeOffsetMs, RealismConfi
             status->set_time(time);
 
             // TODO: this currently has an offset of one simulator output frame
-            for(const QByteArray& data : m_simulatorTruth) {
-                status->mutable_world_state()->add_reality()->ParseFromArray(data.data(), data.size());
+            for(const SimulatorTruth& truth : m_simulatorTruth) {
+                status->mutable_world_state()->add_reality()->CopyFrom(*truth);
             }
             m_simulatorTruth.clear();
 
@@ -180,16 +180,12 @@ SimulationController::SimulationController(int predictTimeOffsetMs, RealismConfi
         }
     });
 
-    m_simulator.connect(&m_simulator, &camun::simulator::Simulator::sendRealData, [this](const QByteArray &data) {
-        m_simulatorTruth.append(data);
+    m_simulator.connect(&m_simulator, &camun::simulator::Simulator::sendRealData, [this](const SimulatorTruth &truth) {
+        m_simulatorTruth.append(truth);
 
-        world::SimulatorState state;
-        bool result = state.ParseFromArray(data.data(), data.size());
-        ASSERT_TRUE(result && "wrapper.ParseFromArray");
-
-        if (state.has_ball()) {
-            m_lastTrueBallPos = Vector(state.ball().p_x(), state.ball().p_y());
-            m_lastTrueBallSpeed = Vector(state.ball().v_x(), state.ball().v_y());
+        if (truth->has_ball()) {
+            m_lastTrueBallPos = Vector(truth->ball().p_x(), truth->ball().p_y());
+            m_lastTrueBallSpeed = Vector(truth->ball().v_x(), truth->ball().v_y());
         }
     });
 }
@@ -0,0 +1,491 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "protobuf/robot.pb.h"
+#include "protobuf/ssl_wrapper.pb.h"
+#include "tracking/tracker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+// a single robot detection as seen by one camera
+struct Detection {
+    int camera;
+    // capture time and the time at which the tracker receives the frame
+    qint64 capture;
+    qint64 arrival;
+    // in ssl vision coordinates
+    float x;
+    float y;
+    float phi;
+};
+
+static const qint64 START_TIME = 1000 * 1000 * 1000;
+static const qint64 FRAME_INTERVAL = 10 * 1000 * 1000;
+
+static QByteArray serializeDetection(const Detection &d)
+{
+    SSL_WrapperPacket wrapper;
+    SSL_DetectionFrame *frame = wrapper.mutable_detection();
+    frame->set_frame_number(0);
+    frame->set_camera_id(d.camera);
+    // the tracker computes the capture time from the vision processing time
+    frame->set_t_capture(d.capture * 1E-9);
+    frame->set_t_sent(d.arrival * 1E-9);
+    SSL_DetectionRobot *robot = frame->add_robots_blue();
+    robot->set_confidence(1);
+    robot->set_robot_id(0);
+    robot->set_x(d.x);
+    robot->set_y(d.y);
+    robot->set_orientation(d.phi);
+    robot->set_pixel_x(0);
+    robot->set_pixel_y(0);
+
+    QByteArray data(wrapper.ByteSizeLong(), 0);
+    wrapper.SerializeToArray(data.data(), data.size());
+    return data;
+}
+
+// robot driving an arc, both cameras see it with a small camera specific offset
+static std::vector<Detection> createDetections(int frames, qint64 camera1Delay)
+{
+    std::vector<Detection> detections;
+    for (int i = 0; i < frames; i++) {
+        for (int camera : {0, 1}) {
+            const qint64 capture = START_TIME + i * FRAME_INTERVAL + camera * FRAME_INTERVAL / 2;
+            const float t = (capture - START_TIME) * 1E-9f;
+            const float offset = (camera == 0 ? 1.f : -1.f) * ((i % 3) - 1) * 3.f;
+            detections.push_back({camera, capture, capture + (camera == 1 ? camera1Delay : 0),
+                                  1000 + 800 * t + offset, -500 + 300 * t * t - offset, 0.2f + 1.5f * t});
+        }
+    }
+    return detections;
+}
+
+static void feedDetection(Tracker &tracker, const Detection &d)
+{
+    tracker.queuePacket(serializeDetection(d), d.arrival, "test");
+    tracker.process(d.arrival);
+}
+
+// distance in m between the tracked robot and a position in ssl vision coordinates
+static float distanceTo(const world::Robot &robot, float x, float y)
+{
+    return std::hypot(robot.p_x() + y / 1000.f, robot.p_y() - x / 1000.f);
+}
+
+static world::Robot runTracker(std::vector<Detection> detections, qint64 endTime, int *rawCount = nullptr)
+{
+    std::stable_sort(detections.begin(), detections.end(), [](const Detection &a, const Detection &b) {
+        return a.arrival < b.arrival;
+    });
+    Tracker tracker(false, false);
+    for (const Detection &d : detections) {
+        feedDetection(tracker, d);
+    }
+    tracker.process(endTime);
+    Status status = tracker.worldState(endTime, true);
+    tracker.finishProcessing();
+    EXPECT_EQ(status->world_state().blue_size(), 1);
+    if (status->world_state().blue_size() == 0) {
+        return world::Robot();
+    }
+    if (rawCount) {
+        *rawCount = status->world_state().blue(0).raw_size();
+    }
+    return status->world_state().blue(0);
+}
+
+static void expectSameState(const world::Robot &a, const world::Robot &b)
+{
+    EXPECT_NEAR(a.p_x(), b.p_x(), 1e-4);
+    EXPECT_NEAR(a.p_y(), b.p_y(), 1e-4);
+    EXPECT_NEAR(a.phi(), b.phi(), 1e-4);
+    EXPECT_NEAR(a.v_x(), b.v_x(), 1e-3);
+    EXPECT_NEAR(a.v_y(), b.v_y(), 1e-3);
+    EXPECT_NEAR(a.omega(), b.omega(), 1e-3);
+}
+
+TEST(Tracker, LateFramesEqualInOrderFusion) {
+    const int FRAMES = 100;
+    // after the arrival of the last frame
+    const qint64 endTime = START_TIME + (FRAMES + 5) * FRAME_INTERVAL;
+    int inOrderRaw = 0;
+    int lateRaw = 0;
+    const world::Robot inOrder = runTracker(createDetections(FRAMES, 0), endTime, &inOrderRaw);
+    // each frame of the slower camera arrives after three frames of the faster one
+    const world::Robot late = runTracker(createDetections(FRAMES, 3 * FRAME_INTERVAL), endTime, &lateRaw);
+    expectSameState(inOrder, late);
+
+    // replayed frames are not reported twice
+    EXPECT_EQ(inOrderRaw, 2 * FRAMES);
+    EXPECT_EQ(lateRaw, 2 * FRAMES);
+}
+
+TEST(Tracker, LateFrameHistoryIsBounded) {
+    const int FRAMES = 100;
+    // after the arrival of the last frame
+    const qint64 endTime = START_TIME + (FRAMES + 5) * FRAME_INTERVAL;
+    std::vector<Detection> detections;
+    for (const Detection &d : createDetections(FRAMES, 0)) {
+        if (d.camera == 0) {
+            detections.push_back(d);
+        }
+    }
+    const world::Robot reference = runTracker(detections, endTime);
+
+    // a single detection of another camera, which is clearly off
+    const qint64 capture = START_TIME + 80 * FRAME_INTERVAL + FRAME_INTERVAL / 2;
+    Detection outlier{1, capture, capture, 0, 0, 0};
+    for (const Detection &d : detections) {
+        if (d.capture > capture) {
+            outlier.x = d.x + 150;
+            outlier.y = d.y;
+            outlier.phi = d.phi;
+            break;
+        }
+    }
+
+    // a frame within the reorder window is fused at its capture time
+    auto withOutlier = detections;
+    outlier.arrival = capture + 50 * 1000 * 1000;
+    withOutlier.push_back(outlier);
+    const world::Robot fused = runTracker(withOutlier, endTime);
+    EXPECT_GT(std::abs(fused.p_x() - reference.p_x()) + std::abs(fused.p_y() - reference.p_y())
+              + std::abs(fused.v_x() - reference.v_x()) + std::abs(fused.v_y() - reference.v_y()), 1e-3);
+
+    // the history only covers 100 ms, older frames are dropped
+    withOutlier.back().arrival = capture + 150 * 1000 * 1000;
+    const world::Robot dropped = runTracker(withOutlier, endTime);
+    expectSameState(reference, dropped);
+}
+
+TEST(Tracker, CameraHandover) {
+    // the second camera is calibrated slightly differently
+    const float X = 1000, Y = 500, OFFSET = 50;
+    Tracker tracker(false, false);
+    world::Robot last;
+    for (int i = 0; i < 120; i++) {
+        const qint64 time = START_TIME + i * FRAME_INTERVAL;
+        const qint64 time1 = time + FRAME_INTERVAL / 2;
+        if (i < 60) {
+            feedDetection(tracker, {0, time, time, X, Y, 0.5f});
+        }
+        if (i >= 30) {
+            feedDetection(tracker, {1, time1, time1, X + OFFSET, Y, 0.5f});
+        }
+        Status status = tracker.worldState(time1, true);
+        tracker.finishProcessing();
+        // a single filter follows the robot across both cameras
+        ASSERT_EQ(status->world_state().blue_size(), 1);
+        const world::Robot &robot = status->world_state().blue(0);
+
+        if (i > 0) {
+            // switching to the other camera may only jump by the calibration offset
+            EXPECT_LT(std::hypot(robot.p_x() - last.p_x(), robot.p_y() - last.p_y()), OFFSET / 1000 + 0.01f);
+        }
+        if (i >= 40 && i < 60) {
+            // the primary camera is trusted more
+            EXPECT_LT(distanceTo(robot, X, Y), 0.01f);
+        }
+        last = robot;
+    }
+    // the second camera took over once the first one lost the robot
+    EXPECT_LT(distanceTo(last, X + OFFSET, Y), 0.01f);
+}
+
+TEST(Tracker, ConflictingDetectionsKeepSeparateFilters) {
+    // the second camera sees a robot with the same id one meter away
+    const float X = 1000, Y = 500, CONFLICT_X = 2000;
+    Tracker tracker(false, false);
+    world::Robot last;
+    for (int i = 0; i < 160; i++) {
+        const qint64 time = START_TIME + i * FRAME_INTERVAL;
+        const qint64 time1 = time + FRAME_INTERVAL / 2;
+        if (i < 100) {
+            feedDetection(tracker, {0, time, time, X, Y, 0.5f});
+        }
+        feedDetection(tracker, {1, time1, time1, CONFLICT_X, Y, 0.5f});
+
+        Status status = tracker.worldState(time1, true);
+        tracker.finishProcessing();
+        ASSERT_EQ(status->world_state().blue_size(), 1);
+        last = status->world_state().blue(0);
+        if (i < 100) {
+            // the conflicting detections neither move nor replace the first robot
+            EXPECT_LT(distanceTo(last, X, Y), 0.01f);
+        }
+    }
+    // the other filter is used once the first robot is lost
+    EXPECT_LT(distanceTo(last, CONFLICT_X, Y), 0.01f);
+}
+
+TEST(Tracker, SystemDelayExcludesVisionLatency) {
+    const qint64 MS = 1000 * 1000;
+    const qint64 SYSTEM_DELAY = 40 * MS;
+    const int DURATION = 10000; // ms
+    const int SPEED_INTERVAL = 150; // ms
+
+    // the commanded speed changes randomly, the robot follows it after the system delay
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> speedDistribution(-2.f, 2.f);
+    std::vector<float> speeds;
+    for (int i = 0; i <= DURATION / SPEED_INTERVAL; i++) {
+        speeds.push_back(speedDistribution(gen));
+    }
+    auto commandedSpeed = [&speeds](int ms) {
+        return ms < 0 ? 0.f : speeds[ms / SPEED_INTERVAL];
+    };
+
+    Tracker tracker(false, false);
+    std::deque<Detection> pending;
+    float x = 0; // mm
+    int frame = 0;
+    for (int ms = 0; ms < DURATION; ms++) {
+        const qint64 time = START_TIME + ms * MS;
+        // m/s times 1ms is mm
+        x += commandedSpeed(ms - SYSTEM_DELAY / MS);
+
+        if (ms % 10 == 0) {
+            robot::RadioCommand command;
+            command.set_generation(0);
+            command.set_id(0);
+            command.set_is_blue(true);
+            command.mutable_command()->set_v_f(commandedSpeed(ms));
+            command.mutable_command()->set_v_s(0);
+            command.mutable_command()->set_omega(0);
+            tracker.queueRadioCommands({command}, time);
+        }
+        if (ms % 10 == 3) {
+            // the vision latency varies between 20 and 35ms, slowly enough to keep the frames in order
+            const int step = frame % 6;
+            const qint64 latency = (20 + 5 * (step <= 3 ? step : 6 - step)) * MS;
+            pending.push_back({0, time, time + latency, x, 0, 0});
+            frame++;
+        }
+        while (!pending.empty() && pending.front().arrival <= time) {
+            feedDetection(tracker, pending.front());
+            pending.pop_front();
+        }
+    }
+
+    qint64 delay;
+    float confidence;
+    ASSERT_TRUE(tracker.systemDelayEstimate(delay, confidence));
+    EXPECT_NEAR(delay, SYSTEM_DELAY, 5 * MS);
+    EXPECT_GT(confidence, 0.5f);
+}
+
+// in world coordinates
+struct Position {
+    float x;
+    float y;
+};
+
+static void addCamera(Tracker &tracker, qint64 time)
+{
+    SSL_WrapperPacket wrapper;
+    SSL_GeometryFieldSize *field = wrapper.mutable_geometry()->mutable_field();
+    field->set_field_length(12000);
+    field->set_field_width(9000);
+    field->set_goal_width(1800);
+    field->set_goal_depth(180);
+    field->set_boundary_width(300);
+    SSL_GeometryCameraCalibration *calib = wrapper.mutable_geometry()->add_calib();
+    calib->set_camera_id(0);
+    calib->set_focal_length(500);
+    calib->set_principal_point_x(0);
+    calib->set_principal_point_y(0);
+    calib->set_distortion(0);
+    calib->set_q0(0);
+    calib->set_q1(0);
+    calib->set_q2(0);
+    calib->set_q3(1);
+    calib->set_tx(0);
+    calib->set_ty(0);
+    calib->set_tz(0);
+    // above the field center
+    calib->set_derived_camera_world_tx(0);
+    calib->set_derived_camera_world_ty(0);
+    calib->set_derived_camera_world_tz(4000);
+
+    QByteArray data(wrapper.ByteSizeLong(), 0);
+    wrapper.SerializeToArray(data.data(), data.size());
+    tracker.queuePacket(data, time, "test");
+    tracker.process(time);
+}
+
+// the robot looks along the positive x axis
+static void feedBalls(Tracker &tracker, qint64 time, const std::vector<Position> &balls, const std::vector<Position> &robots = {})
+{
+    SSL_WrapperPacket wrapper;
+    SSL_DetectionFrame *frame = wrapper.mutable_detection();
+    frame->set_frame_number(0);
+    frame->set_camera_id(0);
+    frame->set_t_capture(time * 1E-9);
+    frame->set_t_sent(time * 1E-9);
+    for (std::size_t i = 0; i < robots.size(); i++) {
+        SSL_DetectionRobot *robot = frame->add_robots_blue();
+        robot->set_confidence(1);
+        robot->set_robot_id(i);
+        robot->set_x(robots[i].y * 1000);
+        robot->set_y(-robots[i].x * 1000);
+        robot->set_orientation(-M_PI_2);
+        robot->set_pixel_x(0);
+        robot->set_pixel_y(0);
+    }
+    for (const Position &p : balls) {
+        SSL_DetectionBall *ball = frame->add_balls();
+        ball->set_confidence(1);
+        ball->set_x(p.y * 1000);
+        ball->set_y(-p.x * 1000);
+        ball->set_pixel_x(0);
+        ball->set_pixel_y(0);
+    }
+
+    QByteArray data(wrapper.ByteSizeLong(), 0);
+    wrapper.SerializeToArray(data.data(), data.size());
+    tracker.queuePacket(data, time, "test");
+    tracker.process(time);
+}
+
+static float trackingDebugValue(const Status &status, const std::string &key)
+{
+    for (const amun::DebugValues &debug : status->debug()) {
+        for (const amun::DebugValue &value : debug.value()) {
+            if (value.key() == key) {
+                return value.float_value();
+            }
+        }
+    }
+    return -1;
+}
+
+// stationary detections which are too far apart to be confused with each other
+static std::vector<Position> ghostBalls()
+{
+    std::vector<Position> ghosts;
+    for (float x : {-3.f, -1.5f, 0.f, 1.5f, 3.f}) {
+        for (float y : {-2.25f, -0.75f, 0.75f, 2.25f}) {
+            ghosts.push_back({x, y});
+        }
+    }
+    return ghosts;
+}
+
+static const int MAX_BALL_FILTERS = 16;
+static const int MAX_BALL_CANDIDATES = 32;
+
+TEST(Tracker, BallHypothesisPoolIsBounded) {
+    Tracker tracker(false, false);
+    addCamera(tracker, START_TIME - FRAME_INTERVAL);
+    const std::vector<Position> ghosts = ghostBalls();
+    Status status;
+    for (int i = 0; i < 30; i++) {
+        const qint64 time = START_TIME + i * FRAME_INTERVAL;
+        feedBalls(tracker, time, ghosts);
+        status = tracker.worldState(time, true);
+        tracker.finishProcessing();
+        EXPECT_LE(trackingDebugValue(status, "ball hypotheses"), MAX_BALL_FILTERS);
+        EXPECT_LE(trackingDebugValue(status, "ball candidates"), MAX_BALL_CANDIDATES);
+    }
+    // once the pool is filled with established filters, the remaining detections stay candidates
+    EXPECT_EQ(trackingDebugValue(status, "ball hypotheses"), MAX_BALL_FILTERS);
+    EXPECT_EQ(trackingDebugValue(status, "ball candidates"), int(ghosts.size()) - MAX_BALL_FILTERS);
+    EXPECT_TRUE(status->world_state().has_ball());
+}
+
+TEST(Tracker, BallPoolEvictsOnlyYoungHypotheses) {
+    Tracker tracker(false, false);
+    addCamera(tracker, START_TIME - FRAME_INTERVAL);
+    const Position ball{0, 4.5f};
+    std::vector<Position> detections{ball};
+    for (int i = 0; i < 40; i++) {
+        const qint64 time = START_TIME + i * FRAME_INTERVAL;
+        if (i == 10) {
+            // the flood of new hypotheses starts after the ball is established
+            const std::vector<Position> ghosts = ghostBalls();
+            detections.insert(detections.end(), ghosts.begin(), ghosts.end());
+        }
+        feedBalls(tracker, time, detections);
+        Status status = tracker.worldState(time, true);
+        tracker.finishProcessing();
+        if (i < 5) {
+            continue;
+        }
+        // the ball filter is never evicted, thus the ball is reported in every frame
+        ASSERT_TRUE(status->world_state().has_ball());
+        const world::Ball &tracked = status->world_state().ball();
+        EXPECT_LT(std::hypot(tracked.p_x() - ball.x, tracked.p_y() - ball.y), 0.02f);
+        EXPECT_LE(trackingDebugValue(status, "ball hypotheses"), MAX_BALL_FILTERS);
+        if (i == 39) {
+            // young ghost filters were evicted in favor of newer ones until the pool was established
+            EXPECT_EQ(trackingDebugValue(status, "ball hypotheses"), MAX_BALL_FILTERS);
+            EXPECT_EQ(trackingDebugValue(status, "ball candidates"), int(detections.size()) - MAX_BALL_FILTERS);
+        }
+    }
+}
+
+TEST(Tracker, BallCandidatesAreBounded) {
+    Tracker tracker(false, false);
+    addCamera(tracker, START_TIME - FRAME_INTERVAL);
+    // single detections which never confirm each other, as they move too far between frames
+    const Position offsets[] = {{0, 0}, {0.65f, 0}, {1.3f, 0}, {0, 0.65f}, {0.65f, 0.65f}, {1.3f, 0.65f}};
+    Status status;
+    for (int i = 0; i < 30; i++) {
+        const qint64 time = START_TIME + i * FRAME_INTERVAL;
+        const Position offset = offsets[i % 6];
+        std::vector<Position> noise;
+        for (float x : {-4.f, -2.f, 0.f, 2.f}) {
+            for (float y : {-5.f, -3.f, -1.f, 1.f, 3.f}) {
+                noise.push_back({x + offset.x, y + offset.y});
+            }
+        }
+        feedBalls(tracker, time, noise);
+        status = tracker.worldState(time, true);
+        tracker.finishProcessing();
+        EXPECT_EQ(trackingDebugValue(status, "ball hypotheses"), 0);
+        EXPECT_LE(trackingDebugValue(status, "ball candidates"), MAX_BALL_CANDIDATES);
+    }
+    EXPECT_EQ(trackingDebugValue(status, "ball candidates"), MAX_BALL_CANDIDATES);
+    EXPECT_FALSE(status->world_state().has_ball());
+}
+
+TEST(Tracker, BallFlyFilterIsCreatedNearRobots) {
+    Tracker tracker(false, false);
+    addCamera(tracker, START_TIME - FRAME_INTERVAL);
+    const Position robot{1, 1};
+    // one ball lies in front of the dribbler, the other one far away from any robot
+    const std::vector<Position> balls{{1.12f, 1}, {-2, -1}};
+    Status status;
+    for (int i = 0; i < 20; i++) {
+        const qint64 time = START_TIME + i * FRAME_INTERVAL;
+        feedBalls(tracker, time, balls, {robot});
+        status = tracker.worldState(time, true);
+        tracker.finishProcessing();
+    }
+    EXPECT_EQ(trackingDebugValue(status, "ball hypotheses"), 2);
+    // only a ball close to a dribbler can be chipped
+    EXPECT_EQ(trackingDebugValue(status, "ball fly filters"), 1);
+}
@@ -0,0 +1,87 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "seshat/backlogwriter.h"
+#include "seshat/logfilereader.h"
+
+#include <QCoreApplication>
+#include <QFile>
+
+const static QString filename("temp_unittest_backlogwriter.log");
+
+TEST(BacklogWriter, FullRateWindowKeepsConfiguredLength) {
+    const int PACKETS = 1000;
+    // one second, see BacklogWriter::BACKLOG_SIZE_PER_SECOND
+    const int FULL_RATE_PACKETS = 570;
+    const qint64 FRAME_TIME = 10 * 1000 * 1000;
+
+    class DeleteFile {
+    public:
+        ~DeleteFile() {
+            QFile::remove(filename);
+        }
+    };
+    DeleteFile del;
+
+    std::string appName = "unittest";
+    char* args[2] = {const_cast<char*>(appName.c_str()), nullptr};
+    int argCount = 1;
+    QCoreApplication app(argCount, args);
+
+    BacklogWriter writer(1);
+    for (int i = 0;i<PACKETS;i++) {
+        Status status(new amun::Status);
+        status->set_time((i + 1) * FRAME_TIME);
+        status->mutable_world_state()->set_time((i + 1) * FRAME_TIME);
+        amun::DebugValues *debug = status->add_debug();
+        debug->set_source(amun::StrategyBlue);
+        amun::DebugValue *value = debug->add_value();
+        value->set_key("frame");
+        value->set_float_value(i);
+        writer.handleStatus(status);
+    }
+    // decimates the packets that left the full rate window
+    writer.saveBacklog(filename, false);
+
+    LogFileReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    const int decimatedPackets = reader.packetCount() - FULL_RATE_PACKETS;
+    // tracking is kept every 100ms beyond the full rate window
+    ASSERT_GE(decimatedPackets, (PACKETS - FULL_RATE_PACKETS) / 10);
+    ASSERT_LE(decimatedPackets, (PACKETS - FULL_RATE_PACKETS) / 10 + 1);
+
+    qint64 lastTrackingTime = 0;
+    for (int i = 0;i<decimatedPackets;i++) {
+        Status status = reader.readStatus(i);
+        ASSERT_FALSE(status.isNull());
+        ASSERT_EQ(status->debug_size(), 0);
+        ASSERT_TRUE(status->has_world_state());
+        ASSERT_GE(status->world_state().time() - lastTrackingTime, 100 * 1000 * 1000);
+        lastTrackingTime = status->world_state().time();
+    }
+    for (int i = 0;i<FULL_RATE_PACKETS;i++) {
+        Status status = reader.readStatus(decimatedPackets + i);
+        ASSERT_FALSE(status.isNull());
+        const int frame = PACKETS - FULL_RATE_PACKETS + i;
+        ASSERT_EQ(status->time(), (frame + 1) * FRAME_TIME);
+        ASSERT_EQ(status->debug_size(), 1);
+        ASSERT_EQ(status->debug(0).value(0).float_value(), frame);
+    }
+}
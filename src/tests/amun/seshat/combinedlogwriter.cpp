@@ -21,8 +21,14 @@
 #include "gtest/gtest.h"
 #include "seshat/logfilereader.h"
 #include "seshat/combinedlogwriter.h"
+#include "seshat/logfilefinder.h"
+#include "seshat/logfilehasher.h"
+#include "seshat/seqlogfilereader.h"
 
 #include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QSettings>
 #include <QTimer>
 #include <QDebug>
 
@@ -95,3 +101,96 @@ TEST(CombinedLogWriter, WriteAndReadAgainEquality) {
         }
     }
 }
+
+TEST(CombinedLogWriter, ArchivedLogIsHashedAndFound) {
+    const int PACKETS = 150;
+    const QString directory("temp_unittest_combinedlogwriter_archive");
+    const QString manifest = directory + "/archived.log";
+
+    class DeleteDirectory {
+    public:
+        DeleteDirectory(const QString &directory) : m_directory(directory) {}
+        ~DeleteDirectory() {
+            QDir(m_directory).removeRecursively();
+        }
+    private:
+        QString m_directory;
+    };
+    DeleteDirectory del(directory);
+    ASSERT_TRUE(QDir().mkpath(directory));
+
+    qRegisterMetaType<Command>("Command");
+    qRegisterMetaType<Status>("Status");
+
+    std::string appName = "unittest";
+    char* args[2] = {const_cast<char*>(appName.c_str()), nullptr};
+    int argCount = 1;
+
+    {
+        QCoreApplication app(argCount, args);
+
+        QTimer::singleShot(0, [&](){
+            CombinedLogWriter writer(false, 1);
+
+            Command command(new amun::Command);
+            command->mutable_record()->set_use_archive(true);
+            command->mutable_record()->set_run_logging(true);
+            command->mutable_record()->set_for_replay(false);
+            command->mutable_record()->set_overwrite_record_filename(manifest.toStdString());
+
+            writer.handleCommand(command);
+
+            for (int i = 0;i<PACKETS;i++) {
+                Status status(new amun::Status);
+                status->set_time(i + 1);
+                status->mutable_world_state()->set_time(i);
+                writer.handleStatus(status);
+            }
+
+            app.connect(&writer, &CombinedLogWriter::destroyed, &app, &QCoreApplication::quit, Qt::QueuedConnection);
+        });
+
+        app.exec();
+    }
+
+    QCoreApplication app(argCount, args);
+
+    SeqLogFileReader reader;
+    ASSERT_TRUE(reader.open(manifest));
+    ASSERT_TRUE(reader.isArchive());
+    ASSERT_TRUE(QDir(directory + "/archive").exists());
+    const Status first = reader.readStatus();
+    ASSERT_FALSE(first.isNull());
+    ASSERT_TRUE(first->has_log_id());
+
+    // hashing a manifest reads the archived groups and restores the reader position
+    reader.reset();
+    const std::string hash = LogFileHasher::hash(reader);
+    ASSERT_FALSE(hash.empty());
+    LogFileHasher expected;
+    for (int i = 0;i<LogFileHasher::HASHED_PACKAGES;i++) {
+        expected.add(reader.readStatus());
+    }
+    ASSERT_EQ(hash, expected.takeResult());
+    reader.reset();
+    ASSERT_EQ(reader.readStatus()->time(), first->time());
+
+    // the finder lists manifests like normal logs
+    QSettings::setPath(QSettings::NativeFormat, QSettings::UserScope, QDir(directory).absoluteFilePath("settings"));
+    {
+        QSettings s("ER-Force", "Ra");
+        s.beginGroup("LogLocation");
+        s.beginWriteArray("locations", 1);
+        s.setArrayIndex(0);
+        s.setValue("path", QDir(directory).absolutePath());
+        s.endArray();
+        s.endGroup();
+    }
+    LogFileFinder finder;
+    Status offers = finder.find(first->log_id());
+    ASSERT_TRUE(offers->has_pure_ui_response());
+    const logfile::LogOffer &offer = offers->pure_ui_response().log_offers();
+    ASSERT_EQ(offer.entries_size(), 1);
+    ASSERT_EQ(offer.entries(0).uri().path(), QFileInfo(manifest).absoluteFilePath().toStdString());
+    ASSERT_EQ(offer.entries(0).quality(), logfile::LogOfferEntry::PERFECT);
+}
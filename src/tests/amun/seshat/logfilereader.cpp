@@ -21,12 +21,70 @@
 #include "gtest/gtest.h"
 #include "seshat/logfilereader.h"
 #include "seshat/logfilewriter.h"
+#include "seshat/logarchive.h"
+#include "protobuf/imagevisualization.h"
 
 #include <QCoreApplication>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
 #include <QTimer>
 #include <QDebug>
 
 const static QString filename("temp_unittest_logfilereader.log");
+const static QString completeFilename("temp_unittest_logfilereader_complete.log");
+const static QString archiveStore("temp_unittest_logfilereader_archive");
+
+class DeleteTestFiles {
+public:
+    ~DeleteTestFiles() {
+        QFile::remove(filename);
+        QFile::remove(completeFilename);
+        QDir(archiveStore).removeRecursively();
+    }
+};
+
+// packet i has the time firstTime + i
+static void writeTestLog(const QString &name, int packets, const QString &store = QString(), int firstTime = 1)
+{
+    LogFileWriter writer;
+    writer.setArchiveStore(store);
+    ASSERT_TRUE(writer.open(name));
+    for (int i = 0;i<packets;i++) {
+        Status status(new amun::Status);
+        status->set_time(firstTime + i);
+        status->mutable_world_state()->set_time(firstTime + i - 1);
+        writer.writeStatus(status);
+    }
+    writer.close();
+}
+
+static int countArchiveObjects()
+{
+    int count = 0;
+    QDirIterator it(archiveStore, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        count++;
+    }
+    return count;
+}
+
+static QByteArray readTestFile(const QString &name)
+{
+    QFile file(name);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+static void writeTestFile(const QString &name, const QByteArray &data, bool append)
+{
+    QFile file(name);
+    ASSERT_TRUE(file.open(append ? QIODevice::Append : QIODevice::WriteOnly | QIODevice::Truncate));
+    ASSERT_EQ(file.write(data), data.size());
+}
 
 TEST(LogfileReader, TimestampZeroIsInvalid) {
     class DeleteFile {
@@ -60,3 +118,352 @@ TEST(LogfileReader, TimestampZeroIsInvalid) {
     writer.close();
     ASSERT_FALSE(reader.open(filename));
 }
+
+TEST(LogfileReader, CompactTrackingRoundTrip) {
+    const int PACKETS = 250;
+
+    class DeleteFile {
+    public:
+        ~DeleteFile() {
+            QFile::remove(filename);
+        }
+    };
+    DeleteFile del;
+
+    auto robotX = [](int i) { return -3.0f + i * 0.0123f; };
+
+    LogFileWriter writer;
+    writer.setEncodingProfile(LogFileWriter::EncodingProfile::CompactTracking);
+    ASSERT_TRUE(writer.open(filename));
+    for (int i = 0;i<PACKETS;i++) {
+        Status status(new amun::Status);
+        status->set_time(i + 1);
+        world::State *state = status->mutable_world_state();
+        state->set_time(1000000000LL * (i + 1));
+        world::Robot *robot = state->add_yellow();
+        robot->set_id(3);
+        robot->set_p_x(robotX(i));
+        robot->set_p_y(1.5f);
+        robot->set_phi(0.01f * i);
+        robot->set_v_x(0.5f);
+        robot->set_v_y(0);
+        robot->set_omega(0);
+        writer.writeStatus(status);
+    }
+    writer.close();
+
+    LogFileReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    ASSERT_EQ(reader.packetCount(), PACKETS);
+    // read out of order to start decoding in the middle of groups
+    for (int i : {230, 5, 6, 120, 0, 199, 200, 249}) {
+        Status status = reader.readStatus(i);
+        ASSERT_FALSE(status.isNull());
+        ASSERT_TRUE(status->has_world_state());
+        ASSERT_FALSE(status->has_compact_world_state());
+        const world::State &state = status->world_state();
+        ASSERT_EQ(state.time(), 1000000000LL * (i + 1));
+        ASSERT_EQ(state.yellow_size(), 1);
+        ASSERT_EQ(state.yellow(0).id(), 3u);
+        ASSERT_NEAR(state.yellow(0).p_x(), robotX(i), 1e-4);
+        ASSERT_NEAR(state.yellow(0).phi(), 0.01f * i, 1e-4);
+    }
+}
+
+TEST(LogfileReader, CompactTrackingKeyframePerGroup) {
+    const int PACKETS = 350;
+
+    class DeleteFile {
+    public:
+        ~DeleteFile() {
+            QFile::remove(filename);
+        }
+    };
+    DeleteFile del;
+
+    // most statuses only contain strategy output, groups start with such a status
+    auto hasWorldState = [](int i) { return i % 3 == 1; };
+    auto robotX = [](int i) { return -3.0f + i * 0.0123f; };
+
+    LogFileWriter writer;
+    writer.setEncodingProfile(LogFileWriter::EncodingProfile::CompactTracking);
+    ASSERT_TRUE(writer.open(filename));
+    for (int i = 0;i<PACKETS;i++) {
+        Status status(new amun::Status);
+        status->set_time(i + 1);
+        if (hasWorldState(i)) {
+            world::State *state = status->mutable_world_state();
+            state->set_time(1000000000LL * (i + 1));
+            world::Robot *robot = state->add_yellow();
+            robot->set_id(3);
+            robot->set_p_x(robotX(i));
+            robot->set_p_y(1.5f);
+            robot->set_phi(0.01f * i);
+        } else {
+            status->add_debug()->set_source(amun::StrategyBlue);
+        }
+        writer.writeStatus(status);
+    }
+    writer.close();
+
+    LogFileReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    ASSERT_EQ(reader.packetCount(), PACKETS);
+    // seek into later groups, starting with a fresh decoder every time
+    for (int i : {301, 202, 340, 103, 205, 1}) {
+        ASSERT_TRUE(hasWorldState(i));
+        Status status = reader.readStatus(i);
+        ASSERT_FALSE(status.isNull());
+        ASSERT_TRUE(status->has_world_state());
+        ASSERT_FALSE(status->has_compact_world_state());
+        const world::State &state = status->world_state();
+        ASSERT_EQ(state.time(), 1000000000LL * (i + 1));
+        ASSERT_EQ(state.yellow_size(), 1);
+        ASSERT_NEAR(state.yellow(0).p_x(), robotX(i), 1e-4);
+        ASSERT_NEAR(state.yellow(0).phi(), 0.01f * i, 1e-4);
+    }
+}
+
+TEST(LogfileReader, SeekResolvesImageDeltas) {
+    const int PACKETS = 250;
+    const int WIDTH = 16;
+    const int HEIGHT = 8;
+
+    class DeleteFile {
+    public:
+        ~DeleteFile() {
+            QFile::remove(filename);
+        }
+    };
+    DeleteFile del;
+
+    // a single moving pixel, thus nearly every image is delta coded
+    auto pixelsFor = [&](int i) {
+        std::string pixels(WIDTH * HEIGHT * 4, char(0x20));
+        pixels.replace((i % (WIDTH * HEIGHT)) * 4, 4, 4, char(0xff));
+        return pixels;
+    };
+
+    ImageVisualizationEncoder encoder;
+    LogFileWriter writer;
+    ASSERT_TRUE(writer.open(filename));
+    for (int i = 0;i<PACKETS;i++) {
+        Status status(new amun::Status);
+        status->set_time(i + 1);
+        amun::DebugValues *debug = status->add_debug();
+        debug->set_source(amun::StrategyBlue);
+        amun::Visualization *vis = debug->add_visualization();
+        vis->set_name("image");
+        vis->mutable_image()->set_width(WIDTH);
+        vis->mutable_image()->set_height(HEIGHT);
+        vis->mutable_image()->set_data(pixelsFor(i));
+        encoder.encode(debug);
+        writer.writeStatus(status);
+    }
+    writer.close();
+
+    LogFileReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    ASSERT_EQ(reader.packetCount(), PACKETS);
+    // every seek returns a full image, the following packet is delta coded based on it
+    for (int i : {150, 57, 230, 100, 1}) {
+        Status status = reader.readStatus(i);
+        ASSERT_FALSE(status.isNull());
+        ASSERT_EQ(status->debug_size(), 1);
+        ASSERT_EQ(status->debug(0).visualization_size(), 1);
+        const amun::ImageVisualization &image = status->debug(0).visualization(0).image();
+        ASSERT_FALSE(image.has_base_id());
+        std::string pixels;
+        QRect updated;
+        ASSERT_TRUE(decodeImageVisualization(image, 0, pixels, updated));
+        ASSERT_EQ(pixels, pixelsFor(i));
+
+        Status next = reader.readStatus(i + 1);
+        ASSERT_FALSE(next.isNull());
+        const amun::ImageVisualization &nextImage = next->debug(0).visualization(0).image();
+        ASSERT_TRUE(decodeImageVisualization(nextImage, image.id(), pixels, updated));
+        ASSERT_EQ(pixels, pixelsFor(i + 1));
+    }
+
+    // groups start with full images
+    for (int i : {100, 200}) {
+        LogFileReader fresh;
+        ASSERT_TRUE(fresh.open(filename));
+        Status status = fresh.readStatus(0);
+        for (int p = 1; p <= i; p++) {
+            status = fresh.readStatus(p);
+        }
+        ASSERT_FALSE(status->debug(0).visualization(0).image().has_base_id());
+    }
+}
+
+TEST(LogfileReader, FollowAppendedGroups) {
+    DeleteTestFiles del;
+
+    // the first two groups of a log are written exactly like those of a shorter log
+    writeTestLog(filename, 200);
+    const int prefixSize = QFileInfo(filename).size();
+    writeTestLog(completeFilename, 300);
+    const QByteArray complete = readTestFile(completeFilename);
+    ASSERT_EQ(complete.left(prefixSize), readTestFile(filename));
+
+    LogFileReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    ASSERT_EQ(reader.packetCount(), 200);
+    int announced = -1;
+    QObject::connect(&reader, &StatusSource::packetsAppended, [&](int packetCount) { announced = packetCount; });
+    ASSERT_FALSE(reader.updateIndex());
+
+    // the timestamps of a group are written before its data
+    const int timestampsSize = 100 * sizeof(qint64);
+    writeTestFile(filename, complete.mid(prefixSize, timestampsSize), true);
+    ASSERT_FALSE(reader.updateIndex());
+    ASSERT_EQ(reader.packetCount(), 200);
+
+    const int dataSize = complete.size() - prefixSize - timestampsSize;
+    writeTestFile(filename, complete.mid(prefixSize + timestampsSize, dataSize / 2), true);
+    ASSERT_FALSE(reader.updateIndex());
+    ASSERT_EQ(reader.packetCount(), 200);
+    ASSERT_EQ(announced, -1);
+
+    // reading the end of the log must not be disturbed by the truncated group
+    Status status = reader.readStatus(199);
+    ASSERT_FALSE(status.isNull());
+    ASSERT_EQ(status->time(), 200);
+
+    writeTestFile(filename, complete.mid(prefixSize + timestampsSize + dataSize / 2), true);
+    ASSERT_TRUE(reader.updateIndex());
+    ASSERT_EQ(reader.packetCount(), 300);
+    ASSERT_EQ(announced, 300);
+    ASSERT_EQ(reader.timings().last(), 300);
+    for (int i : {250, 200, 299, 150}) {
+        status = reader.readStatus(i);
+        ASSERT_FALSE(status.isNull());
+        ASSERT_EQ(status->time(), i + 1);
+        ASSERT_EQ(status->world_state().time(), i);
+    }
+}
+
+TEST(LogfileReader, FollowArchiveManifest) {
+    DeleteTestFiles del;
+
+    writeTestLog(completeFilename, 300, archiveStore);
+    LogFileReader completeReader;
+    ASSERT_TRUE(completeReader.open(completeFilename));
+    const int total = completeReader.packetCount();
+    ASSERT_EQ(total, 300);
+
+    // the last manifest entry is truncated, its objects are already in the store
+    const QByteArray manifest = readTestFile(completeFilename);
+    writeTestFile(filename, manifest.left(manifest.size() - 5), false);
+    LogFileReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    const int partial = reader.packetCount();
+    ASSERT_GT(partial, 0);
+    ASSERT_LT(partial, total);
+    int announced = -1;
+    QObject::connect(&reader, &StatusSource::packetsAppended, [&](int packetCount) { announced = packetCount; });
+    ASSERT_FALSE(reader.updateIndex());
+
+    writeTestFile(filename, manifest.right(5), true);
+    ASSERT_TRUE(reader.updateIndex());
+    ASSERT_EQ(reader.packetCount(), total);
+    ASSERT_EQ(announced, total);
+    ASSERT_EQ(reader.timings(), completeReader.timings());
+    for (int i : {total - 1, partial, 0}) {
+        Status status = reader.readStatus(i);
+        ASSERT_FALSE(status.isNull());
+        ASSERT_EQ(status->time(), i + 1);
+    }
+}
+
+TEST(LogfileReader, ArchiveRoundTrip) {
+    const int PACKETS = 350;
+    DeleteTestFiles del;
+
+    LogFileWriter writer;
+    writer.setArchiveStore(archiveStore);
+    ASSERT_TRUE(writer.open(filename));
+    for (int i = 0;i<PACKETS;i++) {
+        Status status(new amun::Status);
+        status->set_time(i + 1);
+        status->mutable_world_state()->set_time(i);
+        if (i == 3) {
+            // the string tables are stored as prelude of the later groups
+            amun::StringTable *table = status->add_string_table();
+            table->set_source(amun::StrategyBlue);
+            table->set_reset(true);
+            amun::StringTableEntry *entry = table->add_entry();
+            entry->set_id(0);
+            entry->set_value("archived");
+        }
+        writer.writeStatus(status);
+    }
+    writer.close();
+
+    LogFileReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    ASSERT_EQ(reader.packetCount(), PACKETS);
+    for (int i = 0;i<PACKETS;i++) {
+        ASSERT_EQ(reader.timings().at(i), i + 1);
+    }
+    // packets are read out of order, sequential reads rely on the reader remembering the tables
+    for (int i : {0, 3, 121, 349, 120, 200, 202}) {
+        Status status = reader.readStatus(i);
+        ASSERT_FALSE(status.isNull());
+        ASSERT_EQ(status->time(), i + 1);
+        ASSERT_EQ(status->world_state().time(), i);
+        if (i >= 3) {
+            ASSERT_EQ(status->string_table_size(), 1);
+            ASSERT_EQ(status->string_table(0).entry(0).value(), "archived");
+        }
+    }
+}
+
+TEST(LogfileReader, ArchivedLogsShareGroups) {
+    DeleteTestFiles del;
+
+    writeTestLog(filename, 400, archiveStore);
+    const int objects = countArchiveObjects();
+    ASSERT_GT(objects, 1);
+
+    // the second log contains the last 300 packets of the first one, the group boundaries
+    // are chosen by the timestamps, thus only the first groups differ
+    writeTestLog(completeFilename, 300, archiveStore, 101);
+    const int combinedObjects = countArchiveObjects();
+    ASSERT_GT(combinedObjects, objects);
+    ASSERT_LE(combinedObjects, objects + 2);
+
+    LogFileReader reader;
+    ASSERT_TRUE(reader.open(completeFilename));
+    ASSERT_EQ(reader.packetCount(), 300);
+    for (int i : {299, 0, 150}) {
+        Status status = reader.readStatus(i);
+        ASSERT_FALSE(status.isNull());
+        ASSERT_EQ(status->time(), 101 + i);
+    }
+}
+
+TEST(LogfileReader, ArchiveRejectsCorruptObjects) {
+    DeleteTestFiles del;
+
+    const QByteArray data("group content");
+    const QByteArray hash = LogArchive::store(archiveStore, data);
+    ASSERT_FALSE(hash.isEmpty());
+    ASSERT_EQ(LogArchive::store(archiveStore, data), hash);
+    ASSERT_EQ(LogArchive::load(archiveStore, hash), data);
+
+    writeTestFile(LogArchive::objectPath(archiveStore, hash), qCompress(QByteArray("other content")), false);
+    ASSERT_TRUE(LogArchive::load(archiveStore, hash).isEmpty());
+
+    // a corrupt group only loses its own packets
+    writeTestLog(filename, 300, archiveStore);
+    QDirIterator it(archiveStore, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        writeTestFile(it.next(), qCompress(QByteArray("other content")), false);
+    }
+    LogFileReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    ASSERT_EQ(reader.packetCount(), 300);
+    ASSERT_TRUE(reader.readStatus(150).isNull());
+}
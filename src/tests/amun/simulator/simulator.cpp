@@ -43,7 +43,7 @@ class SimTester : public QObject {
 public slots:
     void count() { m_counter++; }
     void handlePacket(const QByteArray &data, qint64 time, QString sender);
-    void handleSimulatorTruthRaw(const QByteArray &data);
+    void receiveSimulatorTruth(const SimulatorTruth &truth);
 
 signals:
     void sendCommand(const Command& c);
@@ -70,12 +70,9 @@ void SimTester::handlePacket(const QByteArray &data, qint64 time, QString sender
     handleDetectionWrapper(wrapper, time);
 }
 
-void SimTester::handleSimulatorTruthRaw(const QByteArray &data) {
-    world::SimulatorState simState;
-    bool result = simState.ParseFromArray(data.data(), data.size());
-    ASSERT_TRUE(result && "simState.ParseFromArray");
-
-    handleSimulatorTruth(simState);
+void SimTester::receiveSimulatorTruth(const SimulatorTruth &truth) {
+    ASSERT_FALSE(truth.isNull());
+    handleSimulatorTruth(*truth);
 }
 
 void SimTester::openLog(const QString &filename) {
@@ -104,7 +101,7 @@ public:
         t.setScaling(0);
         t.setTime(1234, 0);
         s->seedPRGN(14986);
-        QObject::connect(s, &Simulator::sendRealData, &test, &SimTester::handleSimulatorTruthRaw);
+        QObject::connect(s, &Simulator::sendRealData, &test, &SimTester::receiveSimulatorTruth);
         QObject::connect(s, &Simulator::gotPacket, &test, &SimTester::handlePacket);
 
         Command c{new amun::Command};
@@ -240,7 +237,7 @@ protected:
 
 
 TEST_F(FastSimulatorTest, VisionRate) {
-    QObject::disconnect(s, &Simulator::sendRealData, &test, &SimTester::handleSimulatorTruthRaw);
+    QObject::disconnect(s, &Simulator::sendRealData, &test, &SimTester::receiveSimulatorTruth);
     QObject::connect(s, &Simulator::gotPacket, &test, &SimTester::count);
     FastSimulator::goDelta(s, &t, 1e9); // one second
     const int exp_packets = 60 * 2; // 60 Hz * 2 cameras
@@ -248,13 +245,38 @@ TEST_F(FastSimulatorTest, VisionRate) {
     ASSERT_GE(test.m_counter, exp_packets * 0.8);
 }
 
+TEST_F(FastSimulatorTest, VisionOutputSelection) {
+    Command c{new amun::Command};
+    auto* output = c->mutable_simulator()->mutable_vision_output();
+    output->set_detections(false);
+    output->set_min_frame_interval(0.1);
+    emit test.sendCommand(c);
+
+    QObject::connect(s, &Simulator::gotPacket, &test, &SimTester::count);
+    int truthCounter = 0;
+    test.handleSimulatorTruth = [&truthCounter](const world::SimulatorState&) { truthCounter++; };
+    FastSimulator::goDelta(s, &t, 1e9); // one second
+    ASSERT_EQ(test.m_counter, 0);
+    ASSERT_GE(truthCounter, 9);
+    ASSERT_LE(truthCounter, 11);
+
+    // detections of a single camera only
+    Command c2{new amun::Command};
+    c2->mutable_simulator()->mutable_vision_output()->set_detections(true);
+    c2->mutable_simulator()->mutable_vision_output()->add_camera_id(1);
+    emit test.sendCommand(c2);
+    FastSimulator::goDelta(s, &t, 1e9);
+    ASSERT_GE(test.m_counter, 9);
+    ASSERT_LE(test.m_counter, 11);
+}
+
 TEST_F(FastSimulatorTest, OriginString) {
-    QObject::disconnect(s, &Simulator::sendRealData, &test, &SimTester::handleSimulatorTruthRaw);
+    QObject::disconnect(s, &Simulator::sendRealData, &test, &SimTester::receiveSimulatorTruth);
     FastSimulator::goDelta(s, &t, 5e8); // 500 millisecond
 }
 
 TEST_F(FastSimulatorTest, NoRobots) {
-    QObject::disconnect(s, &Simulator::sendRealData, &test, &SimTester::handleSimulatorTruthRaw);
+    QObject::disconnect(s, &Simulator::sendRealData, &test, &SimTester::receiveSimulatorTruth);
     // Initially, the whole world should be empy without robots and just a ball
     test.handleDetectionWrapper = [] (auto packet, auto) {
         if (!packet.has_detection()) {
@@ -295,7 +317,7 @@ TEST_F(FastSimulatorTest, LoadRobots) {
 }
 
 TEST_F(FastSimulatorTest, CBFrequency) {
-    QObject::disconnect(s, &Simulator::sendRealData, &test, &SimTester::handleSimulatorTruthRaw);
+    QObject::disconnect(s, &Simulator::sendRealData, &test, &SimTester::receiveSimulatorTruth);
     int counter = 0;
     auto lambda = [&counter]() {counter++;};
     FastSimulator::goDeltaCallback(s, &t, 10e9, lambda); // 10 seconds, should be run every 10 ms = 100 times + 1 time initially
@@ -783,7 +805,7 @@ TEST_F(FastSimulatorTest, GeometryReflection) {
     geometrySetDefault(setup.mutable_geometry(), true);
     createSimulator(setup);
 
-    QObject::disconnect(s, &Simulator::sendRealData, &test, &SimTester::handleSimulatorTruthRaw);
+    QObject::disconnect(s, &Simulator::sendRealData, &test, &SimTester::receiveSimulatorTruth);
     int runCount = 0;
     test.handleDetectionWrapper = [&setup, &runCount] (auto wrapper, auto) {
         if (!wrapper.has_geometry()) {
@@ -849,7 +871,7 @@ TEST_F(FastSimulatorTest, InvisibleBall) {
 
     FastSimulator::goDelta(s, &t, 1e8);
 
-    QObject::disconnect(s, &Simulator::sendRealData, &test, &SimTester::handleSimulatorTruthRaw);
+    QObject::disconnect(s, &Simulator::sendRealData, &test, &SimTester::receiveSimulatorTruth);
     test.handleDetectionWrapper = [] (auto wrapper, auto) {
         if (!wrapper.has_detection()) {
             return;
@@ -892,7 +914,7 @@ TEST_F(FastSimulatorTest, CameraOverlap) {
 
     emit this->test.sendCommand(command);
 
-    QObject::disconnect(s, &Simulator::sendRealData, &test, &SimTester::handleSimulatorTruthRaw);
+    QObject::disconnect(s, &Simulator::sendRealData, &test, &SimTester::receiveSimulatorTruth);
 
     auto checkCameras = [this](Vector ballPos, std::set<int> expectedIds) {
         Command command(new amun::Command);
@@ -955,3 +977,119 @@ TEST_F(ShootTest, ShootSpeedCapped) {
     const float max_speed = measureMaxShootSpeed(SHOOT_LINEAR_MAX + 5.0f);
     EXPECT_LT(max_speed, SHOOT_LINEAR_MAX + 0.1f);
 }
+
+class KinematicSimulatorTest : public FastSimulatorTest {
+protected:
+    KinematicSimulatorTest() : FastSimulatorTest() {
+        amun::SimulatorSetup setup;
+        loadConfiguration("cpptests/simulator-2020", &setup, false);
+        setup.set_backend(amun::SimulatorSetup::Kinematic);
+        createSimulator(setup);
+        loadRobots(1, 0);
+    }
+
+    void teleportRobot(const Vector &pos) {
+        Command command(new amun::Command);
+        auto teleport = command->mutable_simulator()->mutable_ssl_control()->add_teleport_robot();
+        teleport->mutable_id()->set_id(0);
+        teleport->mutable_id()->set_team(gameController::Team::BLUE);
+        coordinates::toVision(pos, *teleport);
+        teleport->set_v_x(0);
+        teleport->set_v_y(0);
+        teleport->set_v_angular(0);
+        teleport->set_orientation(0);
+        emit test.sendCommand(command);
+    }
+};
+
+TEST_F(KinematicSimulatorTest, RobotMotionLimits) {
+    // stay clear of the ball and the field boundary
+    teleportRobot(Vector(-2, -2));
+    FastSimulator::goDelta(s, &t, 5e7);
+
+    SSLSimRobotControl control{new sslsim::RobotControl};
+    auto* cmd = control->add_robot_commands();
+    cmd->set_id(0);
+    auto* localVel = cmd->mutable_move_command()->mutable_local_velocity();
+    localVel->set_forward(2);
+    localVel->set_left(0);
+    localVel->set_angular(10);
+
+    auto callback = [&control, this]() {
+        emit this->test.sendSSLRadioCommand(control, true, 0);
+    };
+
+    // the kinematic robots accelerate twice as fast as the strategy limits, just like SimRobot
+    const float maxAcceleration = 2 * 7;
+    const float maxAngularAcceleration = 2 * 60;
+    qint64 lastTime = -1;
+    float lastSpeed = 0, lastOmega = 0;
+    float maxMeasuredAcceleration = 0;
+    float speed = 0, omega = 0;
+    test.handleSimulatorTruth = [&](const world::SimulatorState &truth) {
+        ASSERT_EQ(truth.blue_robots_size(), 1);
+        const auto& robot = truth.blue_robots(0);
+        speed = Vector(robot.v_x(), robot.v_y()).length();
+        omega = robot.r_z();
+        if (lastTime >= 0 && truth.time() > lastTime) {
+            const float dt = (truth.time() - lastTime) * 1E-9f;
+            const float acceleration = std::abs(speed - lastSpeed) / dt;
+            ASSERT_LE(acceleration, maxAcceleration * 1.01f);
+            ASSERT_LE(std::abs(omega - lastOmega) / dt, maxAngularAcceleration * 1.01f);
+            maxMeasuredAcceleration = std::max(maxMeasuredAcceleration, acceleration);
+        }
+        lastTime = truth.time();
+        lastSpeed = speed;
+        lastOmega = omega;
+    };
+    FastSimulator::goDeltaCallback(s, &t, 1e9, callback);
+
+    // the robot accelerates at the limit until it reaches the commanded speed
+    ASSERT_GE(maxMeasuredAcceleration, maxAcceleration * 0.9f);
+    ASSERT_NEAR(speed, 2, 1e-2);
+    ASSERT_NEAR(omega, 10, 1e-2);
+
+    // without new commands the robot brakes to a stop
+    lastTime = -1;
+    FastSimulator::goDelta(s, &t, 5e8);
+    ASSERT_LE(speed, 1e-2);
+    ASSERT_LE(std::abs(omega), 1e-2);
+}
+
+TEST_F(KinematicSimulatorTest, BallBouncesOffRobot) {
+    const Vector robotPos(1, 1);
+    teleportRobot(robotPos);
+    FastSimulator::goDelta(s, &t, 5e7);
+
+    Command command(new amun::Command);
+    auto* teleportBall = command->mutable_simulator()->mutable_ssl_control()->mutable_teleport_ball();
+    coordinates::toVision(robotPos + Vector(0, 0.5), *teleportBall);
+    teleportBall->set_z(0);
+    coordinates::toVisionVelocity(Vector(0, -2), *teleportBall);
+    teleportBall->set_vz(0);
+    emit test.sendCommand(command);
+
+    // the ball may touch the flat front, which is closer to the center than the radius
+    robot::Specs specs;
+    const float minDistance = specs.radius() * std::cos(0.98291f / 2) + 0.0215f;
+    float minMeasuredDistance = 1;
+    Vector ballVelocity;
+    test.handleSimulatorTruth = [&](const world::SimulatorState &truth) {
+        ASSERT_EQ(truth.blue_robots_size(), 1);
+        ASSERT_TRUE(truth.has_ball());
+        const auto& robot = truth.blue_robots(0);
+        // the ball does not push the robot
+        ASSERT_LE(robotPos.distance(Vector(robot.p_x(), robot.p_y())), 1e-3f);
+        const Vector ballPos(truth.ball().p_x(), truth.ball().p_y());
+        minMeasuredDistance = std::min(minMeasuredDistance, ballPos.distance(robotPos));
+        ballVelocity = Vector(truth.ball().v_x(), truth.ball().v_y());
+    };
+    FastSimulator::goDelta(s, &t, 5e8);
+
+    // the contact is resolved without letting the ball pass into the robot
+    ASSERT_GE(minMeasuredDistance, minDistance - 5e-3f);
+    ASSERT_LE(minMeasuredDistance, specs.radius() + 0.0215f + 0.03f);
+    // the ball bounces back, but loses energy
+    ASSERT_GT(ballVelocity.y, 0.1f);
+    ASSERT_LT(ballVelocity.length(), 2.0f);
+}
@@ -246,6 +246,38 @@ TEST(AlphaTimeTrajectory, findTrajectory) {
     ASSERT_LT((float)fails / RUNS, 0.01f);
 }
 
+TEST(AlphaTimeTrajectory, reachTimes) {
+    RNG rng(42);
+    const float maxSpeed = 3.5f;
+    const float acc = 3;
+
+    std::vector<RobotState> starts, targets;
+    for (int i = 0; i < 6; i++) {
+        starts.emplace_back(makePos(rng, 4), makeSpeed(rng, maxSpeed));
+    }
+    for (int i = 0; i < 9; i++) {
+        targets.emplace_back(makePos(rng, 4), rng.uniform() > 0.5 ? Vector(0, 0) : makeSpeed(rng, maxSpeed));
+    }
+
+    std::vector<float> times;
+    AlphaTimeTrajectory::reachTimes(starts, targets, acc, maxSpeed, times);
+    ASSERT_EQ(times.size(), starts.size() * targets.size());
+
+    for (std::size_t s = 0; s < starts.size(); s++) {
+        for (std::size_t t = 0; t < targets.size(); t++) {
+            const float time = times[s * targets.size() + t];
+            const auto trajectory = AlphaTimeTrajectory::findTrajectory(starts[s], targets[t], acc, maxSpeed, 0, EndSpeed::FAST);
+            if (trajectory) {
+                ASSERT_EQ(time, trajectory->endTime());
+                // can not be faster than driving at maximum speed (which may be exceeded by sqrt(2))
+                ASSERT_GE(time * maxSpeed * std::sqrt(2.0f) + 0.01f, starts[s].pos.distance(targets[t].pos));
+            } else {
+                ASSERT_TRUE(std::isinf(time));
+            }
+        }
+    }
+}
+
 // there is a invariant, that must always be kept: that calculatePosition
 // always returns the end position of calculateTrajectory, because its
 // just a performance optimization used in the search (findTrajectory)
@@ -648,3 +648,36 @@ TEST(Obstacles, FriendlyRobot_BoundingBox) {
     ASSERT_FLOAT_EQ(b.top, 1);
     ASSERT_FLOAT_EQ(b.bottom, -0.5);
 }
+
+TEST(Obstacles, CircleBatch_Clearance) {
+    CircleBatch batch;
+    int closest;
+    ASSERT_EQ(batch.clearance(Vector(0, 0), Vector(1, 0), closest), std::numeric_limits<float>::infinity());
+    ASSERT_EQ(closest, -1);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> pos(-3, 3);
+    std::uniform_real_distribution<float> radius(0.05f, 0.5f);
+    std::vector<Circle> circles;
+    for (int i = 0; i < 20; i++) {
+        const Vector center(pos(gen), pos(gen));
+        const float r = radius(gen);
+        circles.emplace_back(nullptr, 0, r, center);
+        batch.add(center, r);
+    }
+    ASSERT_EQ(batch.size(), circles.size());
+
+    for (int i = 0; i < 100; i++) {
+        const Vector start(pos(gen), pos(gen));
+        const Vector end(pos(gen), pos(gen));
+        const LineSegment segment(start, end);
+        float expected = std::numeric_limits<float>::infinity();
+        for (const Circle &c : circles) {
+            expected = std::min(expected, c.distance(segment));
+        }
+        ASSERT_NEAR(batch.clearance(start, end, closest), expected, 1e-4f);
+        ASSERT_NEAR(circles[closest].distance(segment), expected, 1e-4f);
+    }
+    // degenerate segments are points
+    ASSERT_NEAR(batch.clearance(Vector(1, 1), Vector(1, 1), closest), circles[closest].distance(Vector(1, 1)), 1e-4f);
+}
@@ -0,0 +1,114 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "strategy/script/filewatcher.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QList>
+#include <QTemporaryDir>
+#include <QTimer>
+
+static void writeFile(const QString &path)
+{
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Append));
+    file.write("x");
+}
+
+static void runEventLoop(int msec)
+{
+    QEventLoop loop;
+    QTimer::singleShot(msec, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+class FileWatcherTest : public ::testing::Test {
+protected:
+    FileWatcherTest() :
+        m_appName("unittest"),
+        m_args{const_cast<char*>(m_appName.c_str()), nullptr},
+        m_argCount(1),
+        m_app(m_argCount, m_args)
+    { }
+
+    void SetUp() override {
+        ASSERT_TRUE(m_dir.isValid());
+        ASSERT_TRUE(QDir(m_dir.path()).mkdir("sub"));
+        m_fileA = path("a.ts");
+        m_fileB = path("sub/b.ts");
+        writeFile(m_fileA);
+        writeFile(m_fileB);
+
+        m_watcher.addDirectory(m_dir.path());
+        QObject::connect(&m_watcher, &FileWatcher::filesChanged, [this](const QStringList &files) {
+            m_signals.append(files);
+        });
+    }
+
+    QString path(const QString &name) const { return QDir::cleanPath(m_dir.path() + "/" + name); }
+
+    std::string m_appName;
+    char *m_args[2];
+    int m_argCount;
+    QCoreApplication m_app;
+    QTemporaryDir m_dir;
+    FileWatcher m_watcher;
+    QString m_fileA;
+    QString m_fileB;
+    QList<QStringList> m_signals;
+};
+
+TEST_F(FileWatcherTest, BurstIsReportedOnce) {
+    // writes spaced less than the settle time apart form a single burst
+    const QString fileC = path("sub/c.ts");
+    writeFile(m_fileA);
+    runEventLoop(50);
+    writeFile(m_fileB);
+    runEventLoop(50);
+    writeFile(fileC);
+    runEventLoop(50);
+    writeFile(m_fileA);
+    ASSERT_TRUE(m_signals.isEmpty());
+
+    runEventLoop(1000);
+    ASSERT_EQ(m_signals.size(), 1);
+    QStringList expected{m_fileA, m_fileB, fileC};
+    expected.sort();
+    ASSERT_EQ(m_signals[0], expected);
+
+    // the next change is a new burst
+    writeFile(m_fileB);
+    runEventLoop(1000);
+    ASSERT_EQ(m_signals.size(), 2);
+    ASSERT_EQ(m_signals[1], QStringList{m_fileB});
+}
+
+TEST_F(FileWatcherTest, ContinuousChangesAreReportedAfterMaximumDelay) {
+    // changes every 100ms never leave the settle time of 200ms, but are still reported
+    for (int i = 0; i < 30; i++) {
+        writeFile(m_fileA);
+        runEventLoop(100);
+    }
+    ASSERT_GE(m_signals.size(), 1);
+    ASSERT_EQ(m_signals[0], QStringList{m_fileA});
+}
@@ -0,0 +1,128 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "gtest/gtest.h"
+#include "strategy/script/visualizationbatch.h"
+#include <limits>
+
+static const std::vector<float> STYLES = {
+    // red, filled
+    255, 0, 0, 128, 0.02f, 1, 0,
+    // green, background, dashed
+    0, 255, 0, 255, 0.01f, 2, amun::Pen::DashLine
+};
+
+TEST(VisualizationBatch, ConvertsShapes) {
+    VisualizationBatch batch;
+    const char *error = batch.parse(STYLES, {
+        0, 0, 1, 2, 0.5f,
+        1, 1, 2, 0, 0, 1, 1,
+        2, 0, 3, 0, 0, 1, 0, 0, 1
+    });
+    ASSERT_EQ(error, nullptr);
+    ASSERT_EQ(batch.size(), 3u);
+
+    amun::Visualization circle;
+    batch.write(0, "batch", &circle);
+    ASSERT_EQ(circle.name(), "batch");
+    ASSERT_FLOAT_EQ(circle.width(), 0.02f);
+    ASSERT_FLOAT_EQ(circle.circle().p_x(), 1);
+    ASSERT_FLOAT_EQ(circle.circle().p_y(), 2);
+    ASSERT_FLOAT_EQ(circle.circle().radius(), 0.5f);
+    ASSERT_EQ(circle.pen().color().red(), 255u);
+    ASSERT_EQ(circle.pen().color().alpha(), 128u);
+    ASSERT_FALSE(circle.pen().has_style());
+    ASSERT_TRUE(circle.has_brush());
+    ASSERT_FALSE(circle.background());
+
+    amun::Visualization path;
+    batch.write(1, "batch", &path);
+    ASSERT_EQ(path.path().point_size(), 2);
+    ASSERT_FLOAT_EQ(path.path().point(1).x(), 1);
+    ASSERT_FLOAT_EQ(path.path().point(1).y(), 1);
+    ASSERT_EQ(path.pen().style(), amun::Pen::DashLine);
+    ASSERT_TRUE(path.background());
+    ASSERT_FALSE(path.has_brush());
+
+    amun::Visualization polygon;
+    batch.write(2, "batch", &polygon);
+    ASSERT_EQ(polygon.polygon().point_size(), 3);
+    ASSERT_FLOAT_EQ(polygon.polygon().point(2).y(), 1);
+    // paths are never filled, polygons use the brush of their style
+    ASSERT_TRUE(polygon.has_brush());
+
+    // an empty batch is valid
+    ASSERT_EQ(batch.parse({}, {}), nullptr);
+    ASSERT_EQ(batch.size(), 0u);
+}
+
+TEST(VisualizationBatch, RejectsInvalidArrays) {
+    VisualizationBatch batch;
+    // the style length is not divisible by the stride
+    std::vector<float> styles = STYLES;
+    styles.pop_back();
+    ASSERT_STREQ(batch.parse(styles, {}), "Invalid array length");
+
+    // colors must fit into the unsigned color fields
+    styles = STYLES;
+    styles[0] = -1;
+    ASSERT_STREQ(batch.parse(styles, {}), "Invalid style");
+    styles[0] = 256;
+    ASSERT_STREQ(batch.parse(styles, {}), "Invalid style");
+    styles[0] = std::numeric_limits<float>::quiet_NaN();
+    ASSERT_STREQ(batch.parse(styles, {}), "Invalid style");
+
+    // flags and pen style must be small integers
+    styles = STYLES;
+    styles[5] = 4;
+    ASSERT_STREQ(batch.parse(styles, {}), "Invalid style");
+    styles[5] = 0.5f;
+    ASSERT_STREQ(batch.parse(styles, {}), "Invalid style");
+    styles = STYLES;
+    styles[6] = -1;
+    ASSERT_STREQ(batch.parse(styles, {}), "Invalid style");
+    styles[6] = std::numeric_limits<float>::quiet_NaN();
+    ASSERT_STREQ(batch.parse(styles, {}), "Invalid style");
+}
+
+TEST(VisualizationBatch, RejectsInvalidShapes) {
+    VisualizationBatch batch;
+    // style index out of range
+    ASSERT_STREQ(batch.parse(STYLES, {0, 2, 0, 0, 1}), "Invalid shape");
+    ASSERT_STREQ(batch.parse(STYLES, {0, -1, 0, 0, 1}), "Invalid shape");
+    ASSERT_STREQ(batch.parse(STYLES, {0, 0.5f, 0, 0, 1}), "Invalid shape");
+    ASSERT_STREQ(batch.parse({}, {0, 0, 0, 0, 1}), "Invalid shape");
+    // unknown shape type
+    ASSERT_STREQ(batch.parse(STYLES, {3, 0, 0, 0, 1}), "Invalid shape");
+    // truncated circle
+    ASSERT_STREQ(batch.parse(STYLES, {0, 0, 0, 0}), "Invalid shape");
+    // the point count exceeds the remaining entries
+    ASSERT_STREQ(batch.parse(STYLES, {1, 0, 2, 0, 0, 1}), "Invalid shape");
+    ASSERT_STREQ(batch.parse(STYLES, {2, 0, 1e30f, 0, 0}), "Invalid shape");
+    ASSERT_STREQ(batch.parse(STYLES, {2, 0, std::numeric_limits<float>::infinity(), 0, 0}), "Invalid shape");
+    // a shape header without data
+    ASSERT_STREQ(batch.parse(STYLES, {1, 0}), "Invalid shape");
+
+    // a valid shape before an invalid one is not kept
+    ASSERT_EQ(batch.parse(STYLES, {0, 0, 0, 0, 1}), nullptr);
+    ASSERT_EQ(batch.size(), 1u);
+    ASSERT_STREQ(batch.parse(STYLES, {0, 0, 0, 0, 1, 0, 5, 0, 0, 1}), "Invalid shape");
+    ASSERT_EQ(batch.size(), 0u);
+}
@@ -0,0 +1,127 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "gtest/gtest.h"
+#include "amun/threadmonitor.h"
+#include <google/protobuf/text_format.h>
+
+#ifdef Q_OS_LINUX
+#include <sched.h>
+#endif
+
+static const qint64 MS = 1000 * 1000;
+
+static amun::ThreadPlacement parsePlacement(const char *text)
+{
+    amun::ThreadPlacement placement;
+    EXPECT_TRUE(google::protobuf::TextFormat::ParseFromString(text, &placement));
+    return placement;
+}
+
+TEST(ThreadMonitor, FindPolicy) {
+    const amun::ThreadPlacement placement = parsePlacement(
+        "policy { thread: \"processor\" thread: \"network\" cpu: 2 cpu: 3 realtime_priority: 50 }"
+        "policy { thread: \"strategy\" nice: 5 }"
+        "policy { thread: \"network\" cpu: 1 }");
+    ASSERT_EQ(placement.policy_size(), 3);
+
+    amun::ThreadPolicy policy;
+    ASSERT_TRUE(ThreadMonitor::findPolicy("processor", placement, policy));
+    ASSERT_EQ(policy.cpu_size(), 2);
+    ASSERT_EQ(policy.cpu(1), 3u);
+    ASSERT_EQ(policy.realtime_priority(), 50u);
+    ASSERT_FALSE(policy.has_nice());
+
+    ASSERT_TRUE(ThreadMonitor::findPolicy("strategy", placement, policy));
+    ASSERT_EQ(policy.nice(), 5);
+    ASSERT_EQ(policy.cpu_size(), 0);
+
+    // a later policy for the same thread replaces the earlier one
+    ASSERT_TRUE(ThreadMonitor::findPolicy("network", placement, policy));
+    ASSERT_EQ(policy.cpu_size(), 1);
+    ASSERT_EQ(policy.cpu(0), 1u);
+    ASSERT_FALSE(policy.has_realtime_priority());
+
+    amun::ThreadPolicy unknown;
+    ASSERT_FALSE(ThreadMonitor::findPolicy("simulator", placement, unknown));
+    ASSERT_FALSE(ThreadMonitor::findPolicy("Processor", placement, unknown));
+    ASSERT_FALSE(ThreadMonitor::findPolicy("processor", amun::ThreadPlacement(), unknown));
+}
+
+TEST(ThreadMonitor, ValidatePolicy) {
+    amun::ThreadPolicy policy;
+    ASSERT_TRUE(ThreadMonitor::validatePolicy(policy).isEmpty());
+
+    policy.add_cpu(0);
+    policy.set_realtime_priority(99);
+    ASSERT_TRUE(ThreadMonitor::validatePolicy(policy).isEmpty());
+
+    policy.set_realtime_priority(0);
+    ASSERT_TRUE(ThreadMonitor::validatePolicy(policy).contains("realtime priority 0"));
+    policy.set_realtime_priority(100);
+    ASSERT_TRUE(ThreadMonitor::validatePolicy(policy).contains("realtime priority 100"));
+
+    policy.clear_realtime_priority();
+    policy.set_nice(-21);
+    ASSERT_TRUE(ThreadMonitor::validatePolicy(policy).contains("nice level -21"));
+    policy.set_nice(19);
+    ASSERT_TRUE(ThreadMonitor::validatePolicy(policy).isEmpty());
+
+    policy.set_realtime_priority(10);
+    ASSERT_FALSE(ThreadMonitor::validatePolicy(policy).isEmpty());
+
+#ifdef Q_OS_LINUX
+    amun::ThreadPolicy cpus;
+    cpus.add_cpu(CPU_SETSIZE - 1);
+    ASSERT_TRUE(ThreadMonitor::validatePolicy(cpus).isEmpty());
+    cpus.add_cpu(CPU_SETSIZE);
+    ASSERT_TRUE(ThreadMonitor::validatePolicy(cpus).contains(QString("cpu %1").arg(CPU_SETSIZE)));
+#endif
+}
+
+TEST(ThreadMonitor, JitterStatistics) {
+    TimerJitter jitter(10 * MS);
+    jitter.start(0);
+    // late by 0, 2, 0 (early) and 6 ms
+    jitter.tick(10 * MS);
+    jitter.tick(22 * MS);
+    jitter.tick(30 * MS);
+    jitter.tick(46 * MS);
+    ASSERT_EQ(jitter.ticks(), 4);
+
+    amun::ThreadJitter report;
+    jitter.report(report);
+    ASSERT_NEAR(report.mean(), 0.002f, 1e-6f);
+    ASSERT_NEAR(report.max(), 0.006f, 1e-6f);
+
+    // reporting starts a new interval, the delay is measured from the last tick
+    ASSERT_EQ(jitter.ticks(), 0);
+    jitter.tick(57 * MS);
+    amun::ThreadJitter next;
+    jitter.report(next);
+    ASSERT_NEAR(next.mean(), 0.001f, 1e-6f);
+    ASSERT_NEAR(next.max(), 0.001f, 1e-6f);
+
+    // without ticks nothing is reported
+    amun::ThreadJitter empty;
+    jitter.report(empty);
+    ASSERT_FALSE(empty.has_mean());
+    ASSERT_FALSE(empty.has_max());
+}
@@ -0,0 +1,111 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   Robotics Erlangen e.V.                                                *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "core/ballprediction.h"
+
+static world::BallModel testModel()
+{
+    world::BallModel model;
+    model.set_fast_deceleration(4.5f);
+    model.set_slow_deceleration(0.35f);
+    model.set_switch_ratio(0.69f);
+    model.set_z_damping(0.55f);
+    model.set_xy_damping(1);
+    return model;
+}
+
+TEST(BallPrediction, Rolling)
+{
+    BallPrediction::State ball;
+    ball.speed = Vector(2, 0);
+    BallPrediction prediction(testModel(), ball, 0, {});
+
+    // only the slow deceleration is used without a shot speed
+    ASSERT_NEAR(prediction.stopTime(), 2 / 0.35f, 1e-4f);
+    const BallPrediction::State end = prediction.stateAt(100);
+    ASSERT_NEAR(end.pos.x, 2 * 2 / (2 * 0.35f), 1e-3f);
+    ASSERT_FLOAT_EQ(end.speed.length(), 0);
+
+    const float time = prediction.timeToPoint(Vector(1, 0), 0.01f);
+    ASSERT_NEAR(prediction.stateAt(time).pos.x, 0.99f, 1e-3f);
+    ASSERT_LT(prediction.timeToPoint(Vector(1, 0.5f), 0.1f), 0);
+}
+
+TEST(BallPrediction, SlidingSwitch)
+{
+    BallPrediction::State ball;
+    ball.speed = Vector(0, 6);
+    BallPrediction prediction(testModel(), ball, 6, {});
+
+    const float switchTime = (6 - 6 * 0.69f) / 4.5f;
+    ASSERT_NEAR(prediction.stateAt(switchTime).speed.y, 6 * 0.69f, 1e-3f);
+    ASSERT_NEAR(prediction.stopTime(), switchTime + 6 * 0.69f / 0.35f, 1e-3f);
+}
+
+TEST(BallPrediction, ChipBounces)
+{
+    BallPrediction::State ball;
+    ball.speed = Vector(1, 0);
+    ball.vz = 3;
+    BallPrediction prediction(testModel(), ball, 0, {});
+
+    const float firstTouchdown = 2 * 3 / 9.81f;
+    ASSERT_NEAR(prediction.stateAt(firstTouchdown / 2).z, 3 * 3 / (2 * 9.81f), 1e-3f);
+    ASSERT_NEAR(prediction.stateAt(firstTouchdown).pos.x, firstTouchdown, 1e-3f);
+    ASSERT_GT(prediction.stateAt(firstTouchdown + 0.01f).vz, 0);
+    ASSERT_GT(prediction.stopTime(), firstTouchdown + 1 / 0.35f);
+}
+
+TEST(BallPrediction, RobotReflection)
+{
+    BallPrediction::State ball;
+    ball.speed = Vector(2, 0);
+    BallPrediction prediction(testModel(), ball, 0, {{Vector(1, 0), 0.09f}});
+
+    ASSERT_EQ(prediction.reflections(), 1);
+    const BallPrediction::State end = prediction.stateAt(100);
+    ASSERT_LT(end.pos.x, 1 - 0.09f);
+    ASSERT_LT(prediction.timeToPoint(Vector(1.5f, 0), 0.05f), 0);
+}
+
+TEST(BallPrediction, SlidingEndsDespiteRounding)
+{
+    // the speed after sliding is slightly above the switch speed due to rounding,
+    // which used to start further empty sliding segments forever
+    world::BallModel model = testModel();
+    model.set_switch_ratio(0.6f);
+    const struct {
+        Vector speed;
+        float shotSpeed;
+    } shots[] = {
+        {Vector(-5.40055847f, 0.487206459f), 5.9983263f},
+        {Vector(-5.85904503f, 5.49931908f), 4.91338634f}
+    };
+    for (const auto &shot : shots) {
+        BallPrediction::State ball;
+        ball.speed = shot.speed;
+        BallPrediction prediction(model, ball, shot.shotSpeed, {});
+
+        const float switchSpeed = shot.shotSpeed * 0.6f;
+        ASSERT_NEAR(prediction.stopTime(), (shot.speed.length() - switchSpeed) / 4.5f + switchSpeed / 0.35f, 1e-3f);
+        ASSERT_FLOAT_EQ(prediction.stateAt(100).speed.length(), 0);
+    }
+}
@@ -0,0 +1,144 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "gtest/gtest.h"
+#include "protobuf/statusarenapool.h"
+#include <thread>
+#include <vector>
+
+// fills a status with roughly the given number of bytes
+static void fillStatus(Status &status, int robots)
+{
+    world::State *state = status->mutable_world_state();
+    state->set_time(1);
+    for (int i = 0; i < robots; i++) {
+        world::Robot *robot = state->add_blue();
+        robot->set_id(i);
+        robot->set_p_x(i);
+        robot->set_p_y(i);
+        robot->set_phi(0);
+        robot->set_v_x(0);
+        robot->set_v_y(0);
+        robot->set_omega(0);
+    }
+}
+
+// releases the last copy of the status in another thread, like a consumer of the processor status
+static void releaseInThread(Status &status)
+{
+    Status released = status;
+    status.clear();
+    std::thread consumer([&released] { released.clear(); });
+    consumer.join();
+}
+
+TEST(StatusArenaPool, ArenaIsReusedAfterReleaseInOtherThread) {
+    StatusArenaPool pool(4096);
+    StatusArenaPool::takeBlockAllocations();
+
+    Status status = pool.createStatus();
+    ASSERT_EQ(StatusArenaPool::takeBlockAllocations(), 1u);
+    const google::protobuf::Arena *arena = status->GetArena();
+    ASSERT_NE(arena, nullptr);
+    fillStatus(status, 10);
+
+    releaseInThread(status);
+
+    Status reused = pool.createStatus();
+    ASSERT_EQ(reused->GetArena(), arena);
+    // the arena was reset, the new status is empty
+    ASSERT_FALSE(reused->has_world_state());
+    ASSERT_EQ(StatusArenaPool::takeBlockAllocations(), 0u);
+
+    // a status that is still in use is never handed out twice
+    Status second = pool.createStatus();
+    ASSERT_NE(second->GetArena(), arena);
+    ASSERT_EQ(StatusArenaPool::takeBlockAllocations(), 1u);
+}
+
+TEST(StatusArenaPool, NoAllocationsInSteadyState) {
+    StatusArenaPool pool(16 * 1024);
+    StatusArenaPool::takeBlockAllocations();
+
+    // the consumer still holds the previous status while the next one is assembled
+    Status previous;
+    std::vector<quint32> allocations;
+    for (int tick = 0; tick < 20; tick++) {
+        Status status = pool.createStatus();
+        fillStatus(status, 20);
+        allocations.push_back(StatusArenaPool::takeBlockAllocations());
+        if (!previous.isNull()) {
+            releaseInThread(previous);
+        }
+        previous = status;
+    }
+    // one arena per status that is alive at the same time
+    ASSERT_EQ(allocations[0], 1u);
+    ASSERT_EQ(allocations[1], 1u);
+    for (std::size_t i = 2; i < allocations.size(); i++) {
+        ASSERT_EQ(allocations[i], 0u) << "tick " << i;
+    }
+}
+
+TEST(StatusArenaPool, OversizedStatusOnlyAllocatesOnce) {
+    StatusArenaPool pool(1024);
+    StatusArenaPool::takeBlockAllocations();
+
+    Status status = pool.createStatus();
+    fillStatus(status, 200);
+    // the initial block and at least one overflow block
+    ASSERT_GT(StatusArenaPool::takeBlockAllocations(), 1u);
+    releaseInThread(status);
+
+    // the overflow blocks were freed, a small status fits into the initial block again
+    Status small = pool.createStatus();
+    fillStatus(small, 1);
+    ASSERT_EQ(StatusArenaPool::takeBlockAllocations(), 0u);
+}
+
+TEST(StatusArenaPool, UnusedArenasAreLimited) {
+    StatusArenaPool pool(1024);
+    const std::size_t count = StatusArenaPool::MAX_UNUSED + 2;
+
+    std::vector<Status> statuses;
+    for (std::size_t i = 0; i < count; i++) {
+        statuses.push_back(pool.createStatus());
+    }
+    StatusArenaPool::takeBlockAllocations();
+    std::thread consumer([&statuses] { statuses.clear(); });
+    consumer.join();
+
+    // only MAX_UNUSED arenas were kept
+    for (std::size_t i = 0; i < count; i++) {
+        statuses.push_back(pool.createStatus());
+    }
+    ASSERT_EQ(StatusArenaPool::takeBlockAllocations(), 2u);
+}
+
+TEST(StatusArenaPool, StatusOutlivesPool) {
+    Status status;
+    {
+        StatusArenaPool pool(1024);
+        status = pool.createStatus();
+    }
+    fillStatus(status, 5);
+    ASSERT_EQ(status->world_state().blue_size(), 5);
+    releaseInThread(status);
+}
@@ -37,6 +37,8 @@ public:
     explicit VisionLogWriter(const QString& filename);
 
     void addVisionPacket(const SSL_WrapperPacket& frame, qint64 time);
+    // writes an already serialized SSL_WrapperPacket
+    void addVisionPacket(const QByteArray &data, qint64 time);
     void addRefereePacket(const SSL_Referee& state, qint64 time);
 
     void open(const QString &filename);
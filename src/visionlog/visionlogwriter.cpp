@@ -71,6 +71,14 @@ void VisionLogWriter::addVisionPacket(const SSL_WrapperPacket& frame, qint64 tim
     writePacket(data, time, VisionLog::MessageType::MESSAGE_SSL_VISION_2014);
 }
 
+void VisionLogWriter::addVisionPacket(const QByteArray &data, qint64 time)
+{
+    if (!isOpen()) {
+        return;
+    }
+    writePacket(data, time, VisionLog::MessageType::MESSAGE_SSL_VISION_2014);
+}
+
 void VisionLogWriter::addRefereePacket(const SSL_Referee& state, qint64 time)
 {
     if (!isOpen()) {
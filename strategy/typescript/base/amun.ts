@@ -108,6 +108,13 @@ interface Amun extends AmunPublic {
 	/** Adds a polygon visualization, pointCoordinates takes consecutive x and y coordinates of the points */
 	addPolygonSimple(name: string, r: number, g: number, b: number, alpha: number, filled: boolean,
 		background: boolean, pointCoordinates: number[]): void;
+	/**
+	 * Adds many circles, paths and polygons of one visualization group in one call, only available in newer amun versions.
+	 * styles contains consecutive [r, g, b, alpha, lineWidth, flags, penStyle], flags: 1 = filled, 2 = background.
+	 * shapes contains [0, styleIndex, x, y, radius] for circles, [1, styleIndex, n, x1, y1, ..., xn, yn] for paths
+	 * and [2, styleIndex, n, x1, y1, ..., xn, yn] for polygons
+	 */
+	addVisualizationBatch?(name: string, styles: Float32Array, shapes: Float32Array): void;
 	/** Set commands for a robot */
 	setCommand(generation: number, id: number, cmd: pb.robot.Command): void;
 	/** Takes an array of tuples of generation, id, and command. */
@@ -124,6 +131,15 @@ interface Amun extends AmunPublic {
 	addDebug(key: string, value?: number | boolean | string): void;
 	/** Add a value to the plotter */
 	addPlot(name: string, value: number): void;
+	/**
+	 * Check if a visualization is shown by any consumer, only available in newer amun versions.
+	 * Visualizations of disabled names are dropped by amun anyway, this allows skipping their computation
+	 */
+	isVisualizationEnabled?(name: string): boolean;
+	/** Check if plots are shown by any consumer, only available in newer amun versions */
+	isPlotEnabled?(): boolean;
+	/** Check if debug values are shown by any consumer, only available in newer amun versions */
+	isDebugValueEnabled?(): boolean;
 	/** Send internal referee command. Only works in debug mode. Must be fully populated */
 	sendRefereeCommand(command: pb.SSL_Referee): void;
 	/** Send mixed team info packet */
@@ -155,6 +171,27 @@ interface Amun extends AmunPublic {
 	 */
 	resolveJsToTs(filename: string, line: number, column: number): string;
 
+	/**
+	 * Predicts the ball movement, only available in newer amun versions.
+	 * ballModel contains [fastDeceleration, slowDeceleration, switchRatio, zDamping, xyDamping] with positive decelerations,
+	 * the one from the geometry is used if it is undefined. ball contains [x, y, z, vx, vy, vz, shotSpeed],
+	 * robots consecutive [x, y, radius] of circles which reflect the ball.
+	 * @returns [x, y, z, vx, vy, vz] for count time steps
+	 */
+	predictBall?(ballModel: Float32Array | undefined, ball: Float32Array, robots: Float32Array, timeStep: number, count: number): Float32Array;
+	/**
+	 * Calculates the time until the ball predicted like in predictBall gets within tolerance of each [x, y] point.
+	 * The result is Infinity for points the ball never reaches
+	 */
+	getBallReachTimes?(ballModel: Float32Array | undefined, ball: Float32Array, robots: Float32Array,
+		points: Float32Array, tolerance: number): Float32Array;
+	/**
+	 * Checks line segments against circles, only available in newer amun versions.
+	 * circles contains consecutive [x, y, radius], segments consecutive [x1, y1, x2, y2]
+	 * @returns [clearance, index of the closest circle or -1] per segment, the clearance is negative for intersections
+	 */
+	getSegmentClearances?(circles: Float32Array, segments: Float32Array): Float32Array;
+
 	// undocumented
 	luaRandomSetSeed(seed: number): void;
 	luaRandom(): number;
@@ -217,6 +254,7 @@ export function _hideFunctions() {
 		addCircleSimple: makeDisabledFunction("addCircleSimple"),
 		addPathSimple: makeDisabledFunction("addPathSimple"),
 		addPolygonSimple: makeDisabledFunction("addPolygonSimple"),
+		addVisualizationBatch: makeDisabledFunction("addVisualizationBatch"),
 		setCommand: makeDisabledFunction("setCommand"),
 		setCommands: makeDisabledFunction("setCommands"),
 		getGameState: makeDisabledFunction("getGameState"),
@@ -225,6 +263,9 @@ export function _hideFunctions() {
 		getSelectedOptions: makeDisabledFunction("getSelectedOptions"),
 		addDebug: makeDisabledFunction("addDebug"),
 		addPlot: makeDisabledFunction("addPlot"),
+		isVisualizationEnabled: makeDisabledFunction("isVisualizationEnabled"),
+		isPlotEnabled: makeDisabledFunction("isPlotEnabled"),
+		isDebugValueEnabled: makeDisabledFunction("isDebugValueEnabled"),
 		sendRefereeCommand: makeDisabledFunction("sendRefereeCommand"),
 		sendMixedTeamInfo: makeDisabledFunction("sendMixedTeamInfo"),
 		getPerformanceMode: makeDisabledFunction("getPerformanceMode"),
@@ -232,6 +273,9 @@ export function _hideFunctions() {
 		debuggerSend: makeDisabledFunction("debuggerSend"),
 		terminateExecution: makeDisabledFunction("terminateExecution"),
 		resolveJsToTs: makeDisabledFunction("resolveJsToTs"),
+		predictBall: makeDisabledFunction("predictBall"),
+		getBallReachTimes: makeDisabledFunction("getBallReachTimes"),
+		getSegmentClearances: makeDisabledFunction("getSegmentClearances"),
 
 		luaRandomSetSeed: makeDisabledFunction("luaRandomSetSeed"),
 		luaRandom: makeDisabledFunction("luaRandom"),
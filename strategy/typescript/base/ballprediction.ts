@@ -0,0 +1,97 @@
+/**
+ * @module ballprediction
+ * Native prediction of the ball movement using the ball model of the tracking
+ */
+
+/**************************************************************************
+*   Copyright 2026 Robotics Erlangen e.V.                                 *
+*   Robotics Erlangen e.V.                                                *
+*   http://www.robotics-erlangen.de/                                      *
+*   info@robotics-erlangen.de                                             *
+*                                                                         *
+*   This program is free software: you can redistribute it and/or modify  *
+*   it under the terms of the GNU General Public License as published by  *
+*   the Free Software Foundation, either version 3 of the License, or     *
+*   any later version.                                                    *
+*                                                                         *
+*   This program is distributed in the hope that it will be useful,       *
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+*   GNU General Public License for more details.                          *
+*                                                                         *
+*   You should have received a copy of the GNU General Public License     *
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+**************************************************************************/
+
+import type { Ball } from "base/ball";
+import type { Robot } from "base/robot";
+import { Position, Speed, Vector } from "base/vector";
+import * as World from "base/world";
+
+let amunLocal = amun;
+
+export interface BallState {
+	pos: Position;
+	speed: Speed;
+	posZ: number;
+	speedZ: number;
+}
+
+/** Checks whether this amun instance can predict the ball */
+export function isAvailable(): boolean {
+	return amunLocal.predictBall != undefined && amunLocal.getBallReachTimes != undefined;
+}
+
+function modelArray(): Float32Array {
+	// amun expects positive decelerations
+	return new Float32Array([-World.BallModel.FastBallDeceleration, -World.BallModel.BallDeceleration,
+		World.BallModel.BallSwitchRatio, World.BallModel.FloorDampingZ, World.BallModel.FloorDampingXY]);
+}
+
+function ballArray(ball: Ball, shotSpeed: number): Float32Array {
+	return new Float32Array([ball.pos.x, ball.pos.y, ball.posZ, ball.speed.x, ball.speed.y, ball.speedZ, shotSpeed]);
+}
+
+function robotArray(robots: readonly Robot[]): Float32Array {
+	let result = new Float32Array(robots.length * 3);
+	for (let i = 0; i < robots.length; i++) {
+		result[i * 3] = robots[i].pos.x;
+		result[i * 3 + 1] = robots[i].pos.y;
+		result[i * 3 + 2] = robots[i].radius;
+	}
+	return result;
+}
+
+/**
+ * Predicts the ball states for count time steps, the first one is the current state.
+ * Chip shots bounce until they roll, rolling balls are reflected by the given robots.
+ * @param shotSpeed - initial speed of the last shot, the ball is assumed to be rolling if it is zero
+ */
+export function predict(timeStep: number, count: number, robots: readonly Robot[] = [],
+		ball: Ball = World.Ball, shotSpeed: number = ball.maxSpeed): BallState[] {
+	const values = amunLocal.predictBall!(modelArray(), ballArray(ball, shotSpeed), robotArray(robots), timeStep, count);
+	let result: BallState[] = [];
+	for (let i = 0; i < values.length; i += 6) {
+		result.push({
+			pos: new Vector(values[i], values[i + 1]),
+			speed: new Vector(values[i + 3], values[i + 4]),
+			posZ: values[i + 2],
+			speedZ: values[i + 5]
+		});
+	}
+	return result;
+}
+
+/**
+ * Calculates the time until the ball gets within tolerance of each point, the height of the ball is ignored.
+ * The result is Infinity for points the ball never reaches.
+ */
+export function reachTimes(points: readonly Position[], tolerance: number, robots: readonly Robot[] = [],
+		ball: Ball = World.Ball, shotSpeed: number = ball.maxSpeed): Float32Array {
+	let pointArray = new Float32Array(points.length * 2);
+	for (let i = 0; i < points.length; i++) {
+		pointArray[i * 2] = points[i].x;
+		pointArray[i * 2 + 1] = points[i].y;
+	}
+	return amunLocal.getBallReachTimes!(modelArray(), ballArray(ball, shotSpeed), robotArray(robots), pointArray, tolerance);
+}
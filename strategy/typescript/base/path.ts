@@ -221,6 +221,13 @@ interface PathObjectTrajectory extends PathObjectCommon {
 	maxIntersectingObstaclePrio(): number;
 	setRobotId?(id: number): void;
 	addOpponentRobotObstacle?(startX: number, startY: number, speedX: number, speedY: number, prio: number): void;
+	/**
+	 * Calculates the minimum travel times from every start to every target, obstacles are ignored.
+	 * @param starts - [px, py, vx, vy] for every start
+	 * @param targets - [px, py, vx, vy] for every target
+	 * @returns one row per start with the time to every target, Infinity if a target could not be reached
+	 */
+	calculateReachTimes?(starts: Float32Array, targets: Float32Array, maxSpeed: number, acceleration: number): Float32Array;
 }
 
 interface AmunPath {
@@ -519,6 +526,33 @@ export class Path {
 		}
 	}
 
+	hasReachTimes(): boolean {
+		return this._trajectoryInst.calculateReachTimes !== undefined;
+	}
+
+	/**
+	 * Minimum travel times ignoring obstacles.
+	 * The time from starts[i] to targets[j] is at index i * targets.length + j
+	 */
+	getReachTimes(starts: { pos: Position; speed: Speed }[], targets: { pos: Position; speed: Speed }[],
+			maxSpeed: number, acceleration: number): Float32Array {
+		if (!this._trajectoryInst.calculateReachTimes) {
+			throw new Error("Can not calculate reach times, update Ra to fix!");
+		}
+		// the travel times do not depend on the coordinate system
+		const pack = (states: { pos: Position; speed: Speed }[]) => {
+			const result = new Float32Array(states.length * 4);
+			states.forEach((state, i) => {
+				result[4 * i] = state.pos.x;
+				result[4 * i + 1] = state.pos.y;
+				result[4 * i + 2] = state.speed.x;
+				result[4 * i + 3] = state.speed.y;
+			});
+			return result;
+		};
+		return this._trajectoryInst.calculateReachTimes(pack(starts), pack(targets), maxSpeed, acceleration);
+	}
+
 	hasOpponentRobotObstacle(): boolean {
 		return this._trajectoryInst.addOpponentRobotObstacle !== undefined;
 	}
@@ -35,6 +35,11 @@ export function addPlot(name: string, value: number) {
 	amunLocal.addPlot(name, value);
 }
 
+/** Checks whether plots are shown by any consumer */
+export function isEnabled(): boolean {
+	return amunLocal.isPlotEnabled == undefined || amunLocal.isPlotEnabled();
+}
+
 
 let aggregated: { [name: string]: number } = {};
 let lastAggregated: { [name: string]: number } = {};
@@ -171,6 +171,15 @@ export const colors = {
 let gcolor: Color = colors.black;
 let gisFilled: boolean = true;
 
+/**
+ * Checks whether the visualization is shown by any consumer.
+ * Use this to skip expensive computations that are only needed for the visualization
+ * @param name - Visualization group
+ */
+export function isEnabled(name: string): boolean {
+	return amunLocal.isVisualizationEnabled == undefined || amunLocal.isVisualizationEnabled(name);
+}
+
 /**
  * Sets line and fill color.
  * If filled is true polygons and circles are filled using color.
@@ -375,6 +384,118 @@ export function addPathRaw(name: string, points: Position[], color: Color = gcol
 	}
 }
 
+/**
+ * Collects the circles, paths and polygons of one visualization group and passes them to amun in a single call.
+ * This is much cheaper than adding thousands of visualizations separately. Nothing is drawn before flush is called.
+ * The parameters of the add functions behave like the ones of the corresponding global functions.
+ */
+export class Batch {
+	private readonly enabled: boolean;
+	private styles: number[] = [];
+	private styleIds = new Map<string, number>();
+	private shapes: number[] = [];
+
+	/** @param name - Visualization group */
+	constructor(private readonly name: string) {
+		this.enabled = isEnabled(name);
+	}
+
+	private styleId(color: Color, lineWidth: number, isFilled: boolean, background: boolean, style?: Style): number {
+		const flags = (isFilled ? 1 : 0) + (background ? 2 : 0);
+		const values = [color.red, color.green, color.blue, color.alpha, lineWidth, flags, style ?? 0];
+		const key = values.join(",");
+		let id = this.styleIds.get(key);
+		if (id == undefined) {
+			id = this.styles.length / values.length;
+			this.styles.push(...values);
+			this.styleIds.set(key, id);
+		}
+		return id;
+	}
+
+	private addPoints(points: Position[]) {
+		this.shapes.push(points.length);
+		for (let pos of points) {
+			const global = Coordinates.toGlobal(pos);
+			this.shapes.push(global.x, global.y);
+		}
+	}
+
+	addCircle(center: Position, radius: number, color?: Color,
+			isFilled: boolean = false, background: boolean = false, style?: Style, lineWidth: number = 0.01) {
+		if (!this.enabled) {
+			return;
+		}
+		if (color == undefined) {
+			isFilled = gisFilled;
+			color = gcolor;
+		}
+		const global = Coordinates.toGlobal(center);
+		this.shapes.push(0, this.styleId(color, lineWidth, isFilled, background, style), global.x, global.y, radius);
+	}
+
+	addPath(points: Position[], color: Color = gcolor, background: boolean = false, style?: Style, lineWidth: number = 0.01) {
+		if (!this.enabled) {
+			return;
+		}
+		this.shapes.push(1, this.styleId(color, lineWidth, false, background, style));
+		this.addPoints(points);
+	}
+
+	addPolygon(points: Position[], color?: Color, isFilled: boolean = false, background: boolean = false, style?: Style) {
+		if (!this.enabled) {
+			return;
+		}
+		if (color == undefined) {
+			isFilled = gisFilled;
+			color = gcolor;
+		}
+		this.shapes.push(2, this.styleId(color, 0.01, isFilled, background, style));
+		this.addPoints(points);
+	}
+
+	/** Passes all collected shapes to amun and clears the batch */
+	flush() {
+		if (this.shapes.length > 0) {
+			if (amunLocal.addVisualizationBatch != undefined) {
+				amunLocal.addVisualizationBatch(this.name, new Float32Array(this.styles), new Float32Array(this.shapes));
+			} else {
+				this.flushSeparately();
+			}
+		}
+		this.styles = [];
+		this.styleIds.clear();
+		this.shapes = [];
+	}
+
+	private flushSeparately() {
+		let i = 0;
+		while (i < this.shapes.length) {
+			const kind = this.shapes[i];
+			const s = this.styles.slice(this.shapes[i + 1] * 7, this.shapes[i + 1] * 7 + 7);
+			const color = new Color(s[0], s[1], s[2], s[3]);
+			const style: Style | undefined = s[6] !== 0 ? s[6] : undefined;
+			if (kind === 0) {
+				addCircleRaw(this.name, new Vector(this.shapes[i + 2], this.shapes[i + 3]), this.shapes[i + 4],
+					color, (s[5] & 1) !== 0, (s[5] & 2) !== 0, style, s[4]);
+				i += 5;
+			} else {
+				const count = this.shapes[i + 2];
+				let points: Position[] = [];
+				for (let p = 0; p < count; p++) {
+					points.push(new Vector(this.shapes[i + 3 + 2 * p], this.shapes[i + 4 + 2 * p]));
+				}
+				if (kind === 1) {
+					addPathRaw(this.name, points, color, (s[5] & 2) !== 0, style, s[4]);
+				} else {
+					addPolygonRaw(this.name, points, color, (s[5] & 1) !== 0, (s[5] & 2) !== 0, style);
+				}
+				i += 3 + 2 * count;
+			}
+		}
+	}
+}
+
 export function addFieldVisualization(name: string, f: (pos: Vector) => Color, pixelWidth: number, pixelHeight: number,
 		drawCornerTL?: Vector, drawCornerBR?: Vector) {
 
@@ -0,0 +1,85 @@
+/**
+ * @module visibility
+ * Batched checks whether line segments are blocked by robots
+ */
+
+/**************************************************************************
+*   Copyright 2026 Robotics Erlangen e.V.                                 *
+*   Robotics Erlangen e.V.                                                *
+*   http://www.robotics-erlangen.de/                                      *
+*   info@robotics-erlangen.de                                             *
+*                                                                         *
+*   This program is free software: you can redistribute it and/or modify  *
+*   it under the terms of the GNU General Public License as published by  *
+*   the Free Software Foundation, either version 3 of the License, or     *
+*   any later version.                                                    *
+*                                                                         *
+*   This program is distributed in the hope that it will be useful,       *
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+*   GNU General Public License for more details.                          *
+*                                                                         *
+*   You should have received a copy of the GNU General Public License     *
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+**************************************************************************/
+
+import type { Robot } from "base/robot";
+import type { Position } from "base/vector";
+
+let amunLocal = amun;
+
+export interface SegmentVisibility {
+	/** true if the clearance is larger than the margin */
+	free: boolean;
+	/** distance between the segment and the closest robot, negative if it intersects a robot */
+	clearance: number;
+	/** the robot closest to the segment */
+	closest: Robot | undefined;
+}
+
+/**
+ * Checks all segments against all robots in one native call if supported by amun.
+ * This is considerably faster than testing each segment separately, e.g. for pass and shot rating
+ * @param segments - start and end of each segment
+ * @param margin - additional distance to the robots that is required for a segment to be free
+ */
+export function checkSegments(segments: readonly [Position, Position][], robots: readonly Robot[],
+		margin: number = 0): SegmentVisibility[] {
+	let result: SegmentVisibility[] = [];
+	if (amunLocal.getSegmentClearances == undefined) {
+		for (let [start, end] of segments) {
+			let clearance = Infinity;
+			let closest: Robot | undefined = undefined;
+			for (let robot of robots) {
+				let distance = start.equals(end) ? robot.pos.distanceTo(start) : robot.pos.distanceToLineSegment(start, end);
+				if (distance - robot.radius < clearance) {
+					clearance = distance - robot.radius;
+					closest = robot;
+				}
+			}
+			result.push({ free: clearance > margin, clearance: clearance, closest: closest });
+		}
+		return result;
+	}
+
+	let circles = new Float32Array(robots.length * 3);
+	for (let i = 0; i < robots.length; i++) {
+		circles[i * 3] = robots[i].pos.x;
+		circles[i * 3 + 1] = robots[i].pos.y;
+		circles[i * 3 + 2] = robots[i].radius;
+	}
+	let points = new Float32Array(segments.length * 4);
+	for (let i = 0; i < segments.length; i++) {
+		points[i * 4] = segments[i][0].x;
+		points[i * 4 + 1] = segments[i][0].y;
+		points[i * 4 + 2] = segments[i][1].x;
+		points[i * 4 + 3] = segments[i][1].y;
+	}
+	const values = amunLocal.getSegmentClearances(circles, points);
+	for (let i = 0; i < segments.length; i++) {
+		const clearance = values[i * 2];
+		const closest = values[i * 2 + 1];
+		result.push({ free: clearance > margin, clearance: clearance, closest: closest >= 0 ? robots[closest] : undefined });
+	}
+	return result;
+}